@@ -32,11 +32,17 @@
 #include "IO/WorldReader.h"
 #include "Model/BrushNode.h"
 #include "Model/BrushFace.h"
+#include "Model/CollectNodesVisitor.h"
 #include "Model/EntityNode.h"
 #include "Model/NodeVisitor.h"
 #include "Model/WorldNode.h"
 
 #include <vecmath/bbox.h>
+#include <vecmath/ray.h>
+#include <vecmath/vec.h>
+
+#include <cstdio>
+#include <vector>
 
 namespace TrenchBroom {
     using AABB = AABBTree<double, 3, Model::Node*>;
@@ -81,5 +87,53 @@ namespace TrenchBroom {
                 world->acceptAndRecurse(builder);
             }
         }, "Add objects to AABB tree");
+
+        Model::CollectNodesVisitor collect;
+        world->acceptAndRecurse(collect);
+
+        std::vector<Model::Node*> nodes;
+        for (auto* node : collect.nodes()) {
+            if (dynamic_cast<Model::EntityNode*>(node) != nullptr || dynamic_cast<Model::BrushNode*>(node) != nullptr) {
+                nodes.push_back(node);
+            }
+        }
+
+        std::vector<AABB> builtTrees(100);
+        timeLambda([&nodes, &builtTrees]() {
+            for (auto& tree : builtTrees) {
+                tree.clearAndBuild(nodes, [](const Model::Node* node) { return node->physicalBounds(); });
+            }
+        }, "Bulk build AABB tree");
+
+        printf("Tree height: %zu (inserted) vs. %zu (built)\n", trees.front().height(), builtTrees.front().height());
+
+        // cast rays from a grid of points above the map straight down and diagonally
+        const auto& mapBounds = world->logicalBounds();
+        std::vector<vm::ray3> rays;
+        for (size_t i = 0u; i < 100u; ++i) {
+            for (size_t j = 0u; j < 100u; ++j) {
+                const auto x = mapBounds.min.x() + mapBounds.size().x() * static_cast<double>(i) / 100.0;
+                const auto y = mapBounds.min.y() + mapBounds.size().y() * static_cast<double>(j) / 100.0;
+                const auto origin = vm::vec3(x, y, mapBounds.max.z() + 16.0);
+                rays.emplace_back(origin, vm::vec3::neg_z());
+                rays.emplace_back(origin, vm::normalize(vm::vec3(1.0, 1.0, -1.0)));
+            }
+        }
+
+        const auto pick = [&rays](const AABB& tree) {
+            size_t hits = 0u;
+            for (size_t k = 0u; k < 10u; ++k) {
+                for (const auto& ray : rays) {
+                    hits += tree.findIntersectors(ray).size();
+                }
+            }
+            return hits;
+        };
+
+        size_t insertedHits = 0u;
+        size_t builtHits = 0u;
+        timeLambda([&]() { insertedHits = pick(trees.front()); }, "Find intersectors in inserted AABB tree");
+        timeLambda([&]() { builtHits = pick(builtTrees.front()); }, "Find intersectors in built AABB tree");
+        ASSERT_EQ(insertedHits, builtHits);
     }
 }
@@ -0,0 +1,105 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include "../../test/src/GTestCompat.h"
+
+#include "BenchmarkUtils.h"
+
+#include "IO/StandardMapParser.h"
+
+#include <kdl/string_utils.h>
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+
+namespace TrenchBroom {
+    namespace IO {
+        static constexpr size_t NumBrushes = 20'000;
+
+        static std::string makeMap(const bool valve) {
+            std::stringstream str;
+            str << "// Game: Quake\n";
+            str << "// Format: " << (valve ? "Valve" : "Standard") << "\n";
+            str << "{\n\"classname\" \"worldspawn\"\n";
+            for (size_t i = 0; i < NumBrushes; ++i) {
+                const auto x = static_cast<double>(i % 100) * 64.0 - 3200.0;
+                const auto y = static_cast<double>(i / 100) * 64.0 - 6400.0;
+                str << "{\n";
+                for (size_t j = 0; j < 6; ++j) {
+                    const auto offset = static_cast<double>(j) * 0.125;
+                    str << "( " << x + offset << " " << y << " -16 ) ( " << x << " " << y + 63.5 << " -16 ) ( " << x << " " << y << " " << -15.75 - offset << " ) ";
+                    if (valve) {
+                        str << "__TB_empty [ 0.70710678118654757 -0.70710678118654757 0 " << offset * 3.0 << " ] [ 0 0 -1 -16.5 ] 22.5 0.25 0.25\n";
+                    } else {
+                        str << "__TB_empty " << i % 64 << " -" << j * 8 << " 22.5 0.25 0.25\n";
+                    }
+                }
+                str << "}\n";
+            }
+            str << "}\n";
+            return str.str();
+        }
+
+        template <typename Parse>
+        static double tokenize(const std::string& map, Parse parse) {
+            QuakeMapTokenizer tokenizer(map);
+            auto sum = 0.0;
+            auto token = tokenizer.nextToken();
+            while (token.type() != QuakeMapToken::Eof) {
+                if (token.hasType(QuakeMapToken::Number)) {
+                    sum += parse(token);
+                }
+                token = tokenizer.nextToken();
+            }
+            return sum;
+        }
+
+        static void benchTokenizeMap(const std::string& map, const std::string& name) {
+            auto sumAllocating = 0.0;
+            auto sumInPlace = 0.0;
+            timeLambda([&]() {
+                sumAllocating = tokenize(map, [](const QuakeMapTokenizer::Token& token) {
+                    return kdl::str_to_double(token.data()).value_or(0.0);
+                });
+            }, "Tokenize " + name + " map, parsing numbers from strings");
+            timeLambda([&]() {
+                sumInPlace = tokenize(map, [](const QuakeMapTokenizer::Token& token) {
+                    return token.toFloat<double>();
+                });
+            }, "Tokenize " + name + " map, parsing numbers in place");
+
+            ASSERT_EQ(sumAllocating, sumInPlace);
+        }
+
+        TEST_CASE("TokenizerBenchmark.benchTokenizeStandardMap", "[TokenizerBenchmark]") {
+            const auto map = makeMap(false);
+            printf("Standard map size: %zu bytes\n", map.size());
+            benchTokenizeMap(map, "Standard");
+        }
+
+        TEST_CASE("TokenizerBenchmark.benchTokenizeValveMap", "[TokenizerBenchmark]") {
+            const auto map = makeMap(true);
+            printf("Valve map size: %zu bytes\n", map.size());
+            benchTokenizeMap(map, "Valve");
+        }
+    }
+}
@@ -0,0 +1,138 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include "../../test/src/GTestCompat.h"
+
+#include "BenchmarkUtils.h"
+
+#include "Model/AttributableNodeIndex.h"
+#include "Model/EntityAttributes.h"
+#include "Model/EntityNode.h"
+#include "Model/LayerNode.h"
+#include "Model/MapFormat.h"
+#include "Model/WorldNode.h"
+
+#include <kdl/vector_utils.h>
+
+#include <string>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        static constexpr size_t NumEntities = 20'000;
+
+        /**
+         * Creates entities that form long target chains, as found in maps with lots of scripted sequences. Every
+         * entity targets its successor, every fourth entity also kills the entity after its successor, and all
+         * entities share some common attribute values.
+         */
+        static std::vector<EntityNode*> makeLinkedEntities() {
+            std::vector<EntityNode*> result;
+            result.reserve(NumEntities);
+
+            for (size_t i = 0u; i < NumEntities; ++i) {
+                auto* entity = new EntityNode();
+                entity->addOrUpdateAttribute(AttributeNames::Classname, "trigger_relay");
+                entity->addOrUpdateAttribute(AttributeNames::Targetname, "t" + std::to_string(i));
+                entity->addOrUpdateAttribute(AttributeNames::Target, "t" + std::to_string(i + 1u));
+                if (i % 4u == 0u) {
+                    entity->addOrUpdateAttribute(AttributeNames::Killtarget, "t" + std::to_string(i + 2u));
+                }
+                entity->addOrUpdateAttribute("delay", "0.5");
+                entity->addOrUpdateAttribute(AttributeNames::Spawnflags, std::to_string(i % 8u));
+                result.push_back(entity);
+            }
+
+            return result;
+        }
+
+        TEST_CASE("AttributableNodeIndexBenchmark.buildAndQuery", "[AttributableNodeIndexBenchmark]") {
+            auto entities = makeLinkedEntities();
+            const auto attributables = std::vector<AttributableNode*>(std::begin(entities), std::end(entities));
+
+            AttributableNodeIndex insertedIndex;
+            timeLambda([&]() {
+                for (auto* attributable : attributables) {
+                    insertedIndex.addAttributableNode(attributable);
+                }
+            }, "Add entities to index one by one");
+
+            AttributableNodeIndex builtIndex;
+            timeLambda([&]() { builtIndex.addAttributableNodes(attributables); }, "Bulk build index");
+
+            size_t targetCount = 0u;
+            timeLambda([&]() {
+                for (size_t i = 0u; i < NumEntities; ++i) {
+                    targetCount += builtIndex.findAttributableNodes(AttributableNodeIndexQuery::exact(AttributeNames::Targetname), "t" + std::to_string(i)).size();
+                }
+            }, "Find link targets");
+            ASSERT_EQ(NumEntities, targetCount);
+
+            size_t sourceCount = 0u;
+            timeLambda([&]() {
+                for (size_t i = 0u; i < NumEntities; ++i) {
+                    sourceCount += builtIndex.findAttributableNodes(AttributableNodeIndexQuery::numbered(AttributeNames::Target), "t" + std::to_string(i)).size();
+                }
+            }, "Find link sources");
+            ASSERT_EQ(NumEntities - 1u, sourceCount);
+
+            size_t valueCount = 0u;
+            timeLambda([&]() {
+                for (size_t i = 0u; i < 10u; ++i) {
+                    valueCount += builtIndex.allValuesForNames(AttributableNodeIndexQuery::numbered(AttributeNames::Target)).size();
+                }
+            }, "Find values for autocompletion");
+            ASSERT_EQ(10u * NumEntities, valueCount);
+
+            kdl::vec_clear_and_delete(entities);
+        }
+
+        static size_t countLinks(const std::vector<EntityNode*>& entities) {
+            size_t result = 0u;
+            for (const auto* entity : entities) {
+                result += entity->linkTargets().size() + entity->killTargets().size();
+            }
+            return result;
+        }
+
+        TEST_CASE("AttributableNodeIndexBenchmark.linkEntities", "[AttributableNodeIndexBenchmark]") {
+            const auto insertedEntities = makeLinkedEntities();
+            WorldNode insertedWorld(MapFormat::Standard);
+            timeLambda([&]() {
+                for (auto* entity : insertedEntities) {
+                    insertedWorld.defaultLayer()->addChild(entity);
+                }
+            }, "Add linked entities to world one by one");
+
+            const auto builtEntities = makeLinkedEntities();
+            WorldNode builtWorld(MapFormat::Standard);
+            timeLambda([&]() {
+                builtWorld.disableAttributableIndexUpdates();
+                for (auto* entity : builtEntities) {
+                    builtWorld.defaultLayer()->addChild(entity);
+                }
+                builtWorld.enableAttributableIndexUpdates();
+            }, "Add linked entities to world and link them in bulk");
+
+            ASSERT_EQ(countLinks(insertedEntities), countLinks(builtEntities));
+        }
+    }
+}
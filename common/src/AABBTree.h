@@ -28,8 +28,14 @@
 #include <vecmath/ray.h>
 #include <vecmath/intersection.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <future>
 #include <iosfwd>
+#include <limits>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -53,6 +59,34 @@ namespace TrenchBroom {
         class InnerNode;
         class LeafNode;
 
+        /**
+         * A compact copy of the tree that is used to speed up queries.
+         *
+         * The nodes are stored in depth first order, so the left child of an inner node immediately follows its
+         * parent. For every node, we store the index of the first node following its subtree, which allows
+         * traversing the tree without recursion. A node is a leaf if and only if the node following its subtree is the
+         * next node. The bounds are stored separately from the other node information so that a traversal touches as
+         * little memory as possible.
+         */
+        struct FlatTree {
+            struct FlatNode {
+                // the index of the first node following the subtree rooted at this node
+                size_t next;
+                // the number of leafs preceding this node, used as the index into the data vector for leafs
+                size_t leafIndex;
+            };
+
+            std::vector<Box> bounds;
+            std::vector<FlatNode> nodes;
+            std::vector<U> data;
+
+            void clear() {
+                bounds.clear();
+                nodes.clear();
+                data.clear();
+            }
+        };
+
         class Visitor {
         public:
             virtual ~Visitor() = default;
@@ -129,6 +163,13 @@ namespace TrenchBroom {
              * @param visitor the visitor to accept
              */
             virtual void accept(Visitor& visitor) const = 0;
+
+            /**
+             * Appends the subtree rooted at this node to the given flat tree.
+             *
+             * @param flatTree the flat tree to append to
+             */
+            virtual void appendToFlatTree(FlatTree& flatTree) const = 0;
         public:
             /**
              * Appends a textual representation of this node to the given output stream.
@@ -366,6 +407,17 @@ namespace TrenchBroom {
                     m_right->accept(visitor);
                 }
             }
+
+            void appendToFlatTree(FlatTree& flatTree) const override {
+                const auto index = flatTree.nodes.size();
+                flatTree.bounds.push_back(this->bounds());
+                flatTree.nodes.push_back({ 0u, flatTree.data.size() });
+
+                m_left->appendToFlatTree(flatTree);
+                m_right->appendToFlatTree(flatTree);
+
+                flatTree.nodes[index].next = flatTree.nodes.size();
+            }
         public:
             void appendTo(std::ostream& str, const std::string& indent, const size_t level) const override {
                 for (size_t i = 0; i < level; ++i)
@@ -382,7 +434,7 @@ namespace TrenchBroom {
             void checkParentPointers([[maybe_unused]] const Node* expectedParent) const override {
                 assert(this->m_parent == expectedParent);
                 m_left->checkParentPointers(this);
-                m_left->checkParentPointers(this);
+                m_right->checkParentPointers(this);
             }
         };
 
@@ -449,6 +501,12 @@ namespace TrenchBroom {
                 visitor.visit(this);
             }
 
+            void appendToFlatTree(FlatTree& flatTree) const override {
+                flatTree.bounds.push_back(this->bounds());
+                flatTree.nodes.push_back({ flatTree.nodes.size() + 1u, flatTree.data.size() });
+                flatTree.data.push_back(m_data);
+            }
+
             void appendTo(std::ostream& str, const std::string& indent, const size_t level) const override {
                 for (size_t i = 0; i < level; ++i)
                     str << indent;
@@ -462,11 +520,59 @@ namespace TrenchBroom {
                 assert(this->m_parent == expectedParent);
             }
         };
+        /**
+         * An object to be added to the tree by the bulk build in clearAndBuild.
+         */
+        struct BuildItem {
+            Box bounds;
+            vm::vec<T,S> center;
+            U data;
+            size_t index;
+        };
+
+        using BuildItemIterator = typename std::vector<BuildItem>::iterator;
+
+        /**
+         * The number of bins used to approximate the surface area heuristic when splitting a set of objects.
+         */
+        static constexpr size_t BuildBinCount = 16;
+
+        /**
+         * Beyond this depth, the objects are split at their median to guarantee a logarithmic tree height and to bound
+         * the recursion depth of the build.
+         */
+        static constexpr size_t MaxSurfaceAreaBuildDepth = 48;
+
+        /**
+         * Subtrees with at least this many objects are built on separate threads, up to the given depth.
+         */
+        static constexpr size_t MinParallelBuildCount = 4096;
+        static constexpr size_t MaxParallelBuildDepth = 3;
+
+        /**
+         * The number of queries after which the flat tree is rebuilt if the tree was modified. This avoids rebuilding
+         * the flat tree for every query during interactive edits where every modification is followed by only a few
+         * queries.
+         */
+        static constexpr size_t FlattenQueryCount = 4;
     private:
         Node* m_root;
         std::unordered_map<U, LeafNode*> m_leafForData;
+
+        /*
+         * The flat tree is a cache for queries. It is rebuilt lazily on a query if the tree was modified, see
+         * useFlatTree. Queries may run concurrently, so the rebuild is guarded by a mutex; modifications still
+         * require exclusive access to the tree.
+         */
+        mutable std::mutex m_flatTreeMutex;
+        mutable FlatTree m_flatTree;
+        mutable std::atomic<bool> m_flatTreeValid;
+        mutable std::atomic<size_t> m_queriesSinceModification;
     public:
-        AABBTree() : m_root(nullptr) {}
+        AABBTree() :
+        m_root(nullptr),
+        m_flatTreeValid(false),
+        m_queriesSinceModification(0u) {}
 
         ~AABBTree() {
             clear();
@@ -484,16 +590,52 @@ namespace TrenchBroom {
         }
 
         /**
-         * Clears this tree and rebuilds it by inserting given objects.
+         * Clears this tree and rebuilds it from the given objects.
+         *
+         * Instead of inserting the objects one by one, the tree is built top-down by recursively splitting the objects
+         * using a binned surface area heuristic. This is much faster than inserting the objects individually and
+         * yields a better balanced tree, which in turn speeds up queries. Large subtrees are built in parallel.
+         *
+         * The resulting tree supports incremental insertion, removal and updates.
          *
          * @param objects the objects to insert, a list of DataType
          * @param getBounds a function from DataType -> Box to compute the bounds of each object
+         *
+         * @throws NodeTreeException if the given objects contain duplicates, or if any of the bounds contains NaN; in
+         * this case, the tree is left empty
          */
         template <typename DataList, typename GetBounds>
         void clearAndBuild(const DataList& objects, GetBounds&& getBounds) {
             clear();
+            // a rebuild is usually followed by many queries, so flatten the tree on the next query
+            m_queriesSinceModification = FlattenQueryCount;
+
+            std::vector<BuildItem> items;
+            items.reserve(objects.size());
+            m_leafForData.reserve(objects.size());
+
             for (const U& object : objects) {
-                insert(getBounds(object), object);
+                const Box bounds = getBounds(object);
+                try {
+                    check(bounds);
+                } catch (const NodeTreeException&) {
+                    clear();
+                    throw;
+                }
+                if (!m_leafForData.emplace(object, nullptr).second) {
+                    clear();
+                    throw NodeTreeException("Data already in tree");
+                }
+                items.push_back(BuildItem{bounds, bounds.center(), object, items.size()});
+            }
+
+            if (!items.empty()) {
+                std::vector<LeafNode*> leaves(items.size(), nullptr);
+                m_root = build(std::begin(items), std::end(items), leaves, 0u);
+
+                for (const auto& item : items) {
+                    m_leafForData[item.data] = leaves[item.index];
+                }
             }
         }
 
@@ -513,6 +655,8 @@ namespace TrenchBroom {
                 throw NodeTreeException("Data already in tree");
             }
 
+            invalidateFlatTree();
+
             if (empty()) {
                 auto* insertedLeafNode = new LeafNode(bounds, data);
 
@@ -541,6 +685,7 @@ namespace TrenchBroom {
             LeafNode* leaf = it->second;
             assert(leaf->data() == data);
             m_leafForData.erase(it);
+            invalidateFlatTree();
 
             m_root = leaf->deleteThis();
 
@@ -564,6 +709,237 @@ namespace TrenchBroom {
             insert(newBounds, data);
         }
     private:
+        /**
+         * Builds a subtree containing the given objects.
+         *
+         * @param begin the beginning of the range of objects, must not be empty
+         * @param end the end of the range of objects
+         * @param leaves the created leafs are stored in this vector at the index of their build items
+         * @param depth the depth of the subtree to build
+         * @return the root of the subtree
+         */
+        static Node* build(BuildItemIterator begin, BuildItemIterator end, std::vector<LeafNode*>& leaves, const size_t depth) {
+            assert(begin != end);
+
+            if (std::next(begin) == end) {
+                auto* leaf = new LeafNode(begin->bounds, begin->data);
+                leaves[begin->index] = leaf;
+                return leaf;
+            }
+
+            const auto mid = split(begin, end, depth);
+
+            Node* left;
+            Node* right;
+            if (static_cast<size_t>(std::distance(begin, end)) >= MinParallelBuildCount && depth < MaxParallelBuildDepth) {
+                // every task writes to a disjoint range of leaves, so this is safe
+                auto leftFuture = std::async(std::launch::async, [&]() { return build(begin, mid, leaves, depth + 1u); });
+                right = build(mid, end, leaves, depth + 1u);
+                left = leftFuture.get();
+            } else {
+                left = build(begin, mid, leaves, depth + 1u);
+                right = build(mid, end, leaves, depth + 1u);
+            }
+
+            return new InnerNode(left, right);
+        }
+
+        /**
+         * Partitions the given range of objects into two non-empty ranges and returns the beginning of the second
+         * range.
+         *
+         * The objects are assigned to bins along the axis where their centers are spread the most, and the range is
+         * split between the two bins where the sum of the surface areas of both halves weighted with their object
+         * counts is minimal. If no such split exists, or if the given depth is too large, the range is split at the
+         * median of the object centers.
+         */
+        static BuildItemIterator split(BuildItemIterator begin, BuildItemIterator end, const size_t depth) {
+            const auto count = static_cast<size_t>(std::distance(begin, end));
+            assert(count > 1u);
+
+            typename Box::builder centerBoundsBuilder;
+            for (auto it = begin; it != end; ++it) {
+                centerBoundsBuilder.add(it->center);
+            }
+
+            const auto centerBounds = centerBoundsBuilder.bounds();
+            const auto centerSize = centerBounds.size();
+
+            size_t axis = 0u;
+            for (size_t i = 1u; i < S; ++i) {
+                if (centerSize[i] > centerSize[axis]) {
+                    axis = i;
+                }
+            }
+
+            const auto splitAtMedian = [&]() {
+                const auto mid = std::next(begin, static_cast<std::ptrdiff_t>(count / 2u));
+                std::nth_element(begin, mid, end, [&](const BuildItem& lhs, const BuildItem& rhs) {
+                    return lhs.center[axis] < rhs.center[axis];
+                });
+                return mid;
+            };
+
+            const auto min = centerBounds.min[axis];
+            const auto extent = centerSize[axis];
+            if (extent <= static_cast<T>(0) || depth >= MaxSurfaceAreaBuildDepth) {
+                return splitAtMedian();
+            }
+
+            const auto binIndex = [&](const BuildItem& item) {
+                const auto index = static_cast<size_t>((item.center[axis] - min) / extent * static_cast<T>(BuildBinCount));
+                return std::min(index, BuildBinCount - 1u);
+            };
+
+            std::array<size_t, BuildBinCount> binCounts{};
+            std::array<Box, BuildBinCount> binBounds;
+            for (auto it = begin; it != end; ++it) {
+                const auto i = binIndex(*it);
+                binBounds[i] = binCounts[i] == 0u ? it->bounds : merge(binBounds[i], it->bounds);
+                ++binCounts[i];
+            }
+
+            // sweep from the right to compute the cost of the right half for every split position
+            std::array<T, BuildBinCount> rightCosts{};
+            size_t rightCount = 0u;
+            Box rightBounds;
+            for (size_t i = BuildBinCount - 1u; i > 0u; --i) {
+                if (binCounts[i] > 0u) {
+                    rightBounds = rightCount == 0u ? binBounds[i] : merge(rightBounds, binBounds[i]);
+                    rightCount += binCounts[i];
+                }
+                rightCosts[i] = rightCount == 0u ? static_cast<T>(0) : surfaceArea(rightBounds) * static_cast<T>(rightCount);
+            }
+
+            // sweep from the left and find the cheapest split position, bins [0, bestSplit) go to the left half
+            size_t bestSplit = 0u;
+            auto bestCost = std::numeric_limits<T>::max();
+            size_t leftCount = 0u;
+            Box leftBounds;
+            for (size_t i = 0u; i < BuildBinCount - 1u; ++i) {
+                if (binCounts[i] > 0u) {
+                    leftBounds = leftCount == 0u ? binBounds[i] : merge(leftBounds, binBounds[i]);
+                    leftCount += binCounts[i];
+                }
+                if (leftCount > 0u && leftCount < count) {
+                    const auto cost = surfaceArea(leftBounds) * static_cast<T>(leftCount) + rightCosts[i + 1u];
+                    if (cost < bestCost) {
+                        bestCost = cost;
+                        bestSplit = i + 1u;
+                    }
+                }
+            }
+
+            if (bestSplit == 0u) {
+                return splitAtMedian();
+            }
+
+            const auto mid = std::partition(begin, end, [&](const BuildItem& item) { return binIndex(item) < bestSplit; });
+            if (mid == begin || mid == end) {
+                return splitAtMedian();
+            }
+            return mid;
+        }
+
+        /**
+         * Returns a value that is proportional to the surface area of the given box.
+         */
+        static T surfaceArea(const Box& bounds) {
+            const auto size = bounds.size();
+            auto result = static_cast<T>(0);
+            for (size_t i = 0u; i < S; ++i) {
+                auto product = static_cast<T>(1);
+                for (size_t j = 0u; j < S; ++j) {
+                    if (j != i) {
+                        product *= size[j];
+                    }
+                }
+                result += product;
+            }
+            return result;
+        }
+
+        void invalidateFlatTree() {
+            m_flatTree.clear();
+            m_flatTreeValid = false;
+            m_queriesSinceModification = 0u;
+        }
+
+        /**
+         * Indicates whether a query should use the flat tree, and rebuilds it if necessary.
+         */
+        bool useFlatTree() const {
+            if (m_flatTreeValid.load(std::memory_order_acquire)) {
+                return true;
+            }
+            if (++m_queriesSinceModification < FlattenQueryCount) {
+                return false;
+            }
+
+            std::lock_guard<std::mutex> lock(m_flatTreeMutex);
+            if (!m_flatTreeValid.load(std::memory_order_relaxed)) {
+                m_flatTree.bounds.reserve(2u * m_leafForData.size());
+                m_flatTree.nodes.reserve(2u * m_leafForData.size());
+                m_flatTree.data.reserve(m_leafForData.size());
+                m_root->appendToFlatTree(m_flatTree);
+                m_flatTreeValid.store(true, std::memory_order_release);
+            }
+            return true;
+        }
+
+        /**
+         * Visits every node of the flat tree whose bounds satisfy the given predicate and whose ancestors' bounds all
+         * satisfy it, too. The given output iterator receives the data of every such leaf.
+         */
+        template <typename P, typename O>
+        void findInFlatTree(const P& predicate, O& out) const {
+            const auto& bounds = m_flatTree.bounds;
+            const auto& nodes = m_flatTree.nodes;
+
+            size_t i = 0u;
+            while (i < nodes.size()) {
+                if (predicate(bounds[i])) {
+                    if (nodes[i].next == i + 1u) {
+                        out = m_flatTree.data[nodes[i].leafIndex];
+                        ++out;
+                    }
+                    ++i;
+                } else {
+                    i = nodes[i].next;
+                }
+            }
+        }
+
+        /**
+         * Tests whether the given ray intersects the given box or originates inside of it using the slab method.
+         *
+         * @param box the box to test
+         * @param origin the ray origin
+         * @param invDirection the componentwise inverse of the ray direction, components where the ray direction is
+         * 0 are ignored
+         * @param zero flags the components where the ray direction is 0
+         */
+        static bool intersectsRay(const Box& box, const vm::vec<T,S>& origin, const vm::vec<T,S>& invDirection, const std::array<bool, S>& zero) {
+            auto tMin = static_cast<T>(0);
+            auto tMax = std::numeric_limits<T>::max();
+            for (size_t i = 0u; i < S; ++i) {
+                if (zero[i]) {
+                    if (origin[i] < box.min[i] || origin[i] > box.max[i]) {
+                        return false;
+                    }
+                } else {
+                    const auto t1 = (box.min[i] - origin[i]) * invDirection[i];
+                    const auto t2 = (box.max[i] - origin[i]) * invDirection[i];
+                    tMin = std::max(tMin, std::min(t1, t2));
+                    tMax = std::min(tMax, std::max(t1, t2));
+                    if (tMin > tMax) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
         void check(const Box& bounds) const {
             if (vm::is_nan(bounds.min) || vm::is_nan(bounds.max)) {
                 throw NodeTreeException("Cannot add node to AABB tree with invalid bounds");
@@ -578,6 +954,8 @@ namespace TrenchBroom {
                 delete m_root;
                 m_root = nullptr;
             }
+            m_leafForData.clear();
+            invalidateFlatTree();
         }
 
         /**
@@ -636,7 +1014,22 @@ namespace TrenchBroom {
          */
         template <typename O>
         void findIntersectors(const vm::ray<T,S>& ray, O out) const {
-            if (!empty()) {
+            if (empty()) {
+                return;
+            }
+
+            if (useFlatTree()) {
+                vm::vec<T,S> invDirection;
+                std::array<bool, S> zero;
+                for (size_t i = 0u; i < S; ++i) {
+                    zero[i] = ray.direction[i] == static_cast<T>(0);
+                    invDirection[i] = zero[i] ? static_cast<T>(0) : static_cast<T>(1) / ray.direction[i];
+                }
+
+                findInFlatTree([&](const Box& bounds) {
+                    return intersectsRay(bounds, ray.origin, invDirection, zero);
+                }, out);
+            } else {
                 LambdaVisitor visitor(
                     [&](const InnerNode* innerNode) {
                         return innerNode->bounds().contains(ray.origin) || !vm::is_nan(
@@ -653,6 +1046,43 @@ namespace TrenchBroom {
             }
         }
 
+        /**
+         * Finds every data item in this tree whose bounding box satisfies the given predicate and appends it to the
+         * given output iterator.
+         *
+         * The predicate is also applied to the bounds of the inner nodes, and a subtree is skipped if the bounds of its
+         * root do not satisfy the predicate. Therefore, any box that contains a box which satisfies the predicate must
+         * also satisfy it.
+         *
+         * @tparam P the predicate type, must be of type `bool(const Box&)`
+         * @tparam O the output iterator type
+         * @param predicate the predicate to test
+         * @param out the output iterator to append to
+         */
+        template <typename P, typename O>
+        void findMatching(const P& predicate, O out) const {
+            if (empty()) {
+                return;
+            }
+
+            if (useFlatTree()) {
+                findInFlatTree(predicate, out);
+            } else {
+                LambdaVisitor visitor(
+                    [&](const InnerNode* innerNode) {
+                        return predicate(innerNode->bounds());
+                    },
+                    [&](const LeafNode* leaf) {
+                        if (predicate(leaf->bounds())) {
+                            out = leaf->data();
+                            ++out;
+                        }
+                    }
+                );
+                m_root->accept(visitor);
+            }
+        }
+
         /**
          * Finds every data item in this tree whose bounding box contains the given point and returns a list of those items.
          *
@@ -675,7 +1105,15 @@ namespace TrenchBroom {
          */
         template <typename O>
         void findContainers(const vm::vec<T,S>& point, O out) const {
-            if (!empty()) {
+            if (empty()) {
+                return;
+            }
+
+            if (useFlatTree()) {
+                findInFlatTree([&](const Box& bounds) {
+                    return bounds.contains(point);
+                }, out);
+            } else {
                 LambdaVisitor visitor(
                     [&](const InnerNode* innerNode) {
                         return innerNode->bounds().contains(point);
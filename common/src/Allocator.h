@@ -21,179 +21,181 @@
 #define TrenchBroom_Allocator_h
 
 #include <cassert>
-#include <stack>
-#include <vector>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <type_traits>
 
 // Undefine this to prevent false positives when looking for memory leaks.
 #define TB_ENABLE_ALLOCATOR 1
 
 namespace TrenchBroom {
-    template <class T, size_t PoolSize = 64, size_t BlocksPerChunk = 256>
+    /**
+     * Pooled allocation for small objects of type T that are allocated and freed in large numbers, such as the
+     * vertices, edges and faces of a polyhedron. Derive T from Allocator<T> to use it.
+     *
+     * Every thread keeps a free list of blocks so that most allocations and deallocations don't need any
+     * synchronization. The blocks are carved out of chunks of BlocksPerChunk blocks which are shared by all threads.
+     * A thread hands blocks back to the shared pool in batches of BlocksPerChunk once its free list gets too long, and
+     * it hands back all of its blocks when it exits. Therefore an object may be freed on a different thread than the
+     * one that allocated it.
+     *
+     * Objects may also be allocated or freed while a thread exits, e.g. by the destructors of other thread local or
+     * static objects that own polyhedra. The free list of a thread is therefore trivially destructible and stays usable
+     * until the thread is gone. Once its blocks have been handed back, the thread allocates and frees its objects
+     * directly from the shared pool.
+     *
+     * Chunks are never returned to the system, so the memory used is bounded by the peak number of live objects.
+     */
+    template <class T, size_t BlocksPerChunk = 256>
     class Allocator {
     private:
-        class Chunk {
-        private:
-            unsigned char m_blocks[BlocksPerChunk * sizeof(T)];
-            unsigned char m_firstFreeBlock;
-            unsigned char m_numFreeBlocks;
-        public:
-            Chunk() :
-                m_firstFreeBlock(0),
-                m_numFreeBlocks(BlocksPerChunk - 1) {
-                for (size_t i = 0; i < BlocksPerChunk - 1; i++)
-                    m_blocks[i * sizeof(T)] = static_cast<unsigned char>(i + 1);
-            }
+        union Block {
+            Block* next;
+            alignas(T) unsigned char storage[sizeof(T)];
+        };
 
-            bool contains(const T* t) const {
-                const unsigned char* block = reinterpret_cast<const unsigned char*>(t);
-                if (block < m_blocks)
-                    return false;
-                size_t offset = static_cast<size_t>(block - m_blocks);
-                return offset < (BlocksPerChunk - 1) * sizeof(T);
-            }
+        struct FreeList {
+            Block* first = nullptr;
+            size_t size = 0;
 
-            T* allocate() {
-                if (m_numFreeBlocks == 0)
-                    return nullptr;
+            void push(Block* block) {
+                block->next = first;
+                first = block;
+                ++size;
+            }
 
-                unsigned char* block = m_blocks + m_firstFreeBlock * sizeof(T);
-                m_firstFreeBlock = *block;
-                m_numFreeBlocks--;
-                return reinterpret_cast<T*>(block);
+            Block* pop() {
+                assert(first != nullptr);
+                Block* block = first;
+                first = block->next;
+                --size;
+                return block;
             }
 
-            void deallocate(T* t) {
-                assert(m_numFreeBlocks < BlocksPerChunk - 1);
-                assert(contains(t));
+            /**
+             * Removes up to count blocks from the front of this list and returns them as a new list.
+             */
+            FreeList split(const size_t count) {
+                FreeList result;
+                while (first != nullptr && result.size < count) {
+                    result.push(pop());
+                }
+                return result;
+            }
 
-                unsigned char* block = reinterpret_cast<unsigned char*>(t);
-                assert(block >= m_blocks);
-                size_t offset = static_cast<size_t>(block - m_blocks);
-                assert(offset % sizeof(T) == 0);
+            void append(FreeList& other) {
+                while (other.first != nullptr) {
+                    push(other.pop());
+                }
+            }
+        };
 
-                size_t index = offset / sizeof(T);
-                assert(index < BlocksPerChunk);
+        struct SharedPool {
+            std::mutex mutex;
+            FreeList freeBlocks;
+
+            /**
+             * Returns a batch of free blocks, allocating a new chunk if there are none left.
+             */
+            FreeList acquire() {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (freeBlocks.size == 0u) {
+                    addChunk();
+                }
+                return freeBlocks.split(BlocksPerChunk);
+            }
 
-                *block = m_firstFreeBlock;
-                m_firstFreeBlock = static_cast<unsigned char>(index);
-                m_numFreeBlocks++;
+            Block* acquireOne() {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (freeBlocks.size == 0u) {
+                    addChunk();
+                }
+                return freeBlocks.pop();
             }
 
-            bool empty() const {
-                return m_numFreeBlocks == BlocksPerChunk - 1;
+            void release(FreeList& blocks) {
+                std::lock_guard<std::mutex> lock(mutex);
+                freeBlocks.append(blocks);
             }
 
-            bool full() const {
-                return m_numFreeBlocks == 0;
+            void releaseOne(Block* block) {
+                std::lock_guard<std::mutex> lock(mutex);
+                freeBlocks.push(block);
+            }
+        private:
+            void addChunk() {
+                Block* chunk = new Block[BlocksPerChunk];
+                for (size_t i = 0u; i < BlocksPerChunk; ++i) {
+                    freeBlocks.push(&chunk[i]);
+                }
             }
         };
 
-        using ChunkList = std::vector<Chunk*>;
-        using Pool = std::stack<T*>;
+        /**
+         * Must be trivially destructible, see localPool.
+         */
+        struct LocalPool {
+            FreeList freeBlocks;
+            bool detached = false;
+        };
 
-        static Pool& pool() {
-            static Pool p;
-            return p;
-        }
+        static_assert(std::is_trivially_destructible_v<LocalPool>, "LocalPool must be trivially destructible");
 
-        static ChunkList& fullChunks() {
-            static ChunkList chunks;
-            return chunks;
-        }
+        /**
+         * Hands the blocks of a thread's pool back to the shared pool when the thread exits.
+         */
+        struct LocalPoolGuard {
+            LocalPool* pool;
 
-        static ChunkList& mixedChunks() {
-            static ChunkList chunks;
-            return chunks;
+            ~LocalPoolGuard() {
+                pool->detached = true;
+                sharedPool().release(pool->freeBlocks);
+            }
+        };
+
+        static SharedPool& sharedPool() {
+            // intentionally leaked so that objects which are freed during static destruction still find their pool
+            static auto* pool = new SharedPool();
+            return *pool;
         }
 
-        static ChunkList emptyChunks() {
-            static ChunkList chunks;
-            return chunks;
+        static LocalPool& localPool() {
+            // the pool has no destructor, so it remains valid while the other thread local objects are destroyed
+            thread_local LocalPool pool;
+            thread_local LocalPoolGuard guard{&pool};
+            return pool;
         }
     public:
 #ifdef TB_ENABLE_ALLOCATOR
-        void* operator new([[maybe_unused]] size_t size) {
+        static void* operator new([[maybe_unused]] const size_t size) {
             assert(size == sizeof(T));
 
-            if (!pool().empty()) {
-                T* t = pool().top();
-                pool().pop();
-                return t;
+            LocalPool& pool = localPool();
+            if (pool.detached) {
+                return sharedPool().acquireOne()->storage;
             }
-
-            Chunk* chunk = nullptr;
-            if (mixedChunks().empty()) {
-                if (!emptyChunks().empty()) {
-                    chunk = emptyChunks().back();
-                    emptyChunks().pop_back();
-                } else {
-                    chunk = new Chunk();
-                }
-            } else {
-                chunk = mixedChunks().back();
-                mixedChunks().pop_back();
-            }
-
-            assert(!chunk->full());
-            T* block = chunk->allocate();
-
-            if (chunk->full()) {
-                fullChunks().push_back(chunk);
-            } else {
-                mixedChunks().push_back(chunk);
+            if (pool.freeBlocks.size == 0u) {
+                pool.freeBlocks = sharedPool().acquire();
             }
-            return block;
+            return pool.freeBlocks.pop()->storage;
         }
 
-        void operator delete(void* block) {
-            T* t = reinterpret_cast<T*>(block);
-
-            if (PoolSize > 0 && pool().size() < PoolSize) {
-                pool().push(t);
+        static void operator delete(void* ptr) {
+            if (ptr == nullptr) {
                 return;
             }
 
-            typename ChunkList::reverse_iterator fullIt, fullEnd, mixedIt, mixedEnd;
-            fullIt = fullChunks().rbegin();
-            fullEnd = fullChunks().rend();
-            mixedIt = mixedChunks().rbegin();
-            mixedEnd = mixedChunks().rend();
-
-            Chunk* chunk = nullptr;
-            while (fullIt < fullEnd || mixedIt < mixedEnd) {
-                if (fullIt < fullEnd) {
-                    Chunk* fullChunk = *fullIt;
-                    if (fullChunk->contains(t)) {
-                        chunk = fullChunk;
-                        break;
-                    }
-                    ++fullIt;
-                }
-                if (mixedIt < mixedEnd) {
-                    Chunk* mixedChunk = *mixedIt;
-                    if (mixedChunk->contains(t)) {
-                        chunk = mixedChunk;
-                        break;
-                    }
-                    ++mixedIt;
-                }
-            }
-
-            assert(chunk != nullptr);
-
-            if (chunk->full()) {
-                fullChunks().erase((fullIt + 1).base());
-                mixedChunks().push_back(chunk);
+            LocalPool& pool = localPool();
+            if (pool.detached) {
+                sharedPool().releaseOne(reinterpret_cast<Block*>(ptr));
+                return;
             }
 
-            chunk->deallocate(t);
-
-            if (chunk->empty()) {
-                mixedChunks().erase((mixedIt + 1).base());
-                if (emptyChunks().size() < 2)
-                    emptyChunks().push_back(chunk);
-                else
-                    delete chunk;
+            pool.freeBlocks.push(reinterpret_cast<Block*>(ptr));
+            if (pool.freeBlocks.size >= 2u * BlocksPerChunk) {
+                FreeList surplus = pool.freeBlocks.split(BlocksPerChunk);
+                sharedPool().release(surplus);
             }
         }
 #endif
@@ -20,6 +20,7 @@
 #include "EntityDefinitionManager.h"
 
 #include "Ensure.h"
+#include "InternedString.h"
 #include "Assets/EntityDefinition.h"
 #include "Assets/EntityDefinitionGroup.h"
 #include "IO/EntityDefinitionLoader.h"
@@ -60,7 +61,8 @@ namespace TrenchBroom {
 
         EntityDefinition* EntityDefinitionManager::definition(const Model::AttributableNode* attributable) const {
             ensure(attributable != nullptr, "attributable is null");
-            return definition(attributable->attribute(Model::AttributeNames::Classname));
+            const auto id = attributable->internedClassname().id();
+            return id < m_cacheById.size() ? m_cacheById[id] : nullptr;
         }
 
         EntityDefinition* EntityDefinitionManager::definition(const std::string& classname) const {
@@ -109,6 +111,12 @@ namespace TrenchBroom {
             clearCache();
             for (EntityDefinition* definition : m_definitions) {
                 m_cache[definition->name()] = definition;
+
+                const auto id = InternedString(definition->name()).id();
+                if (id >= m_cacheById.size()) {
+                    m_cacheById.resize(id + 1u, nullptr);
+                }
+                m_cacheById[id] = definition;
             }
         }
 
@@ -120,6 +128,7 @@ namespace TrenchBroom {
 
         void EntityDefinitionManager::clearCache() {
             m_cache.clear();
+            m_cacheById.clear();
         }
 
         void EntityDefinitionManager::clearGroups() {
@@ -49,6 +49,8 @@ namespace TrenchBroom {
             std::vector<EntityDefinition*> m_definitions;
             std::vector<EntityDefinitionGroup> m_groups;
             Cache m_cache;
+            // indexed by the IDs of the interned definition names
+            std::vector<EntityDefinition*> m_cacheById;
         public:
             Notifier<> usageCountDidChangeNotifier;
         public:
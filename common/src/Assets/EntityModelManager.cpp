@@ -19,6 +19,7 @@
 
 #include "EntityModelManager.h"
 
+#include "BufferedLogger.h"
 #include "Exceptions.h"
 #include "Logger.h"
 #include "Macros.h"
@@ -28,6 +29,13 @@
 #include "Model/EntityNode.h"
 #include "Renderer/TexturedIndexRangeRenderer.h"
 
+#include <kdl/parallel.h>
+#include <kdl/vector_utils.h>
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+
 namespace TrenchBroom {
     namespace Assets {
         EntityModelManager::EntityModelManager(const int magFilter, const int minFilter, Logger& logger) :
@@ -35,13 +43,18 @@ namespace TrenchBroom {
         m_loader(nullptr),
         m_minFilter(minFilter),
         m_magFilter(magFilter),
-        m_resetTextureMode(false) {}
+        m_resetTextureMode(false),
+        m_loadLogger(std::make_unique<BufferedLogger>(logger)),
+        m_activeLoadWorkerCount(0u),
+        m_cancelLoads(false) {}
 
         EntityModelManager::~EntityModelManager() {
             clear();
         }
 
         void EntityModelManager::clear() {
+            cancelLoads();
+
             m_renderers.clear();
             m_models.clear();
             m_rendererMismatches.clear();
@@ -65,7 +78,7 @@ namespace TrenchBroom {
         }
 
         Renderer::TexturedRenderer* EntityModelManager::renderer(const Assets::ModelSpecification& spec) const {
-            auto* entityModel = safeGetModel(spec.path);
+            auto* entityModel = model(spec.path, spec.frameIndex);
 
             if (entityModel == nullptr) {
                 return nullptr;
@@ -97,20 +110,69 @@ namespace TrenchBroom {
         }
 
         const EntityModelFrame* EntityModelManager::frame(const Assets::ModelSpecification& spec) const {
-            auto* model = this->safeGetModel(spec.path);
+            auto* model = this->model(spec.path, spec.frameIndex);
             if (model == nullptr) {
                 return nullptr;
             } else if (spec.frameIndex >= model->frameCount()) {
                 return nullptr;
             } else {
                 if (!model->frame(spec.frameIndex)->loaded()) {
-                    loadFrame(spec, *model);
+                    loadFrame(spec, *model, m_logger);
                 }
                 return model->frame(spec.frameIndex);
             }
         }
 
-        EntityModel* EntityModelManager::model(const IO::Path& path) const {
+        bool EntityModelManager::hasPendingLoads() const {
+            return !m_loadingModels.empty();
+        }
+
+        void EntityModelManager::commitLoadedModels() {
+            auto results = std::vector<LoadResult>();
+            {
+                std::lock_guard<std::mutex> lock(m_loadMutex);
+                std::swap(results, m_finishedLoads);
+            }
+
+            m_loadLogger->flush();
+
+            // forget the workers that have run out of requests
+            using namespace std::chrono_literals;
+            for (auto it = std::begin(m_loadWorkers); it != std::end(m_loadWorkers);) {
+                if (it->wait_for(0s) == std::future_status::ready) {
+                    it->get();
+                    it = m_loadWorkers.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+
+            if (results.empty()) {
+                return;
+            }
+
+            auto paths = std::vector<IO::Path>();
+            paths.reserve(results.size());
+
+            for (auto& result : results) {
+                m_loadingModels.erase(result.path);
+                if (result.model != nullptr) {
+                    auto* model = result.model.get();
+                    const auto success = m_models.insert({ result.path, std::move(result.model) }).second;
+                    assert(success); unused(success);
+
+                    m_unpreparedModels.push_back(model);
+                    m_logger.debug() << "Loaded entity model " << result.path;
+                } else {
+                    m_modelMismatches.insert(result.path);
+                }
+                paths.push_back(std::move(result.path));
+            }
+
+            modelsWereLoadedNotifier(paths);
+        }
+
+        EntityModel* EntityModelManager::model(const IO::Path& path, const size_t frameIndex) const {
             if (path.isEmpty()) {
                 return nullptr;
             }
@@ -120,48 +182,104 @@ namespace TrenchBroom {
                 return it->second.get();
             }
 
-            if (m_modelMismatches.count(path) > 0) {
-                return nullptr;
+            if (m_modelMismatches.count(path) == 0) {
+                requestModel(path, frameIndex);
             }
+            return nullptr;
+        }
 
-            try {
-                const auto [pos, success] = m_models.insert({ path, loadModel(path) });
-                assert(success); unused(success);
+        void EntityModelManager::requestModel(const IO::Path& path, const size_t frameIndex) const {
+            ensure(m_loader != nullptr, "loader is null");
 
-                auto* model = pos->second.get();
-                m_unpreparedModels.push_back(model);
+            std::lock_guard<std::mutex> lock(m_loadMutex);
+            if (!m_loadingModels.insert(path).second) {
+                // the model is already being loaded, but we can still ask for another frame if no worker has
+                // picked up the request yet
+                auto it = std::find_if(std::begin(m_pendingLoads), std::end(m_pendingLoads), [&](const auto& request) { return request.path == path; });
+                if (it != std::end(m_pendingLoads) && !kdl::vec_contains(it->frameIndices, frameIndex)) {
+                    it->frameIndices.push_back(frameIndex);
+                }
+                return;
+            }
 
-                m_logger.debug() << "Loaded entity model " << path;
+            m_pendingLoads.push_back(LoadRequest{ path, { frameIndex } });
+            if (m_activeLoadWorkerCount < kdl::parallel_thread_count()) {
+                ++m_activeLoadWorkerCount;
+                m_loadWorkers.push_back(std::async(std::launch::async, [this]() { runLoadWorker(); }));
+            }
+        }
 
-                return model;
-            } catch (const GameException& e) {
-                m_logger.error() << e.what();
-                m_modelMismatches.insert(path);
-                throw;
+        void EntityModelManager::runLoadWorker() const {
+            while (true) {
+                auto request = LoadRequest();
+                {
+                    std::lock_guard<std::mutex> lock(m_loadMutex);
+                    if (m_cancelLoads || m_pendingLoads.empty()) {
+                        --m_activeLoadWorkerCount;
+                        return;
+                    }
+                    request = std::move(m_pendingLoads.front());
+                    m_pendingLoads.pop_front();
+                }
+
+                auto model = loadModel(request, *m_loadLogger);
+
+                std::lock_guard<std::mutex> lock(m_loadMutex);
+                m_finishedLoads.push_back(LoadResult{ std::move(request.path), std::move(model) });
             }
         }
 
-        EntityModel* EntityModelManager::safeGetModel(const IO::Path& path) const {
+        std::unique_ptr<EntityModel> EntityModelManager::loadModel(const LoadRequest& request, Logger& logger) const {
             try {
-                return model(path);
-            } catch (const GameException&) {
+                auto model = m_loader->initializeModel(request.path, logger);
+                if (model != nullptr) {
+                    for (const auto frameIndex : request.frameIndices) {
+                        if (frameIndex < model->frameCount() && !model->frame(frameIndex)->loaded()) {
+                            loadFrame(ModelSpecification(request.path, 0, frameIndex), *model, logger);
+                        }
+                    }
+                }
+                return model;
+            } catch (const std::exception& e) {
+                // any exception must be caught here, otherwise the request would never be committed
+                logger.error() << e.what();
                 return nullptr;
             }
         }
 
-        std::unique_ptr<EntityModel> EntityModelManager::loadModel(const IO::Path& path) const {
-            ensure(m_loader != nullptr, "loader is null");
-            return m_loader->initializeModel(path, m_logger);
-        }
-
-        void EntityModelManager::loadFrame(const Assets::ModelSpecification& spec, Assets::EntityModel& model) const {
+        void EntityModelManager::loadFrame(const Assets::ModelSpecification& spec, Assets::EntityModel& model, Logger& logger) const {
             try {
                 ensure(m_loader != nullptr, "loader is null");
-                m_loader->loadFrame(spec.path, spec.frameIndex, model, m_logger);
-            } catch (const Exception& e) {
+                m_loader->loadFrame(spec.path, spec.frameIndex, model, logger);
+            } catch (const std::exception& e) {
                 // FIXME: be specific about which exceptions to catch here
-                m_logger.error() << "Could not load entity model frame " << spec << ": " << e.what();
+                logger.error() << "Could not load entity model frame " << spec << ": " << e.what();
+            }
+        }
+
+        void EntityModelManager::cancelLoads() {
+            {
+                std::lock_guard<std::mutex> lock(m_loadMutex);
+                m_cancelLoads = true;
+                m_pendingLoads.clear();
             }
+
+            // wait for the workers to finish the models they are currently loading
+            for (auto& worker : m_loadWorkers) {
+                worker.get();
+            }
+            m_loadWorkers.clear();
+
+            {
+                std::lock_guard<std::mutex> lock(m_loadMutex);
+                m_finishedLoads.clear();
+                m_cancelLoads = false;
+            }
+
+            m_loadingModels.clear();
+
+            // the messages of the cancelled loads are dropped, see clear()
+            m_loadLogger->discard();
         }
 
         void EntityModelManager::prepare(Renderer::VboManager& vboManager) {
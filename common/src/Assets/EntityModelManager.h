@@ -20,15 +20,20 @@
 #ifndef TrenchBroom_EntityModelManager
 #define TrenchBroom_EntityModelManager
 
+#include "Notifier.h"
 #include "IO/Path.h"
 
 #include <kdl/vector_set.h>
 
+#include <deque>
+#include <future>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 namespace TrenchBroom {
+    class BufferedLogger;
     class Logger;
 
     namespace IO {
@@ -49,8 +54,33 @@ namespace TrenchBroom {
         class EntityModelFrame;
         struct ModelSpecification;
 
+        /**
+         * Loads entity models and builds their renderers.
+         *
+         * Models are parsed on worker threads. Requesting a frame or a renderer of a model that has not been loaded
+         * yet schedules the model to be loaded and returns nullptr, and clients should use placeholder bounds until
+         * the model is available. Every model is requested at most once, even if it is requested again while it is
+         * being loaded. Loaded models are handed over to the calling thread by commitLoadedModels, and uploading
+         * them to the GPU happens in prepare.
+         */
         class EntityModelManager {
+        public:
+            /**
+             * Notified by commitLoadedModels with the paths of the models that have finished loading, including
+             * those that could not be loaded.
+             */
+            Notifier<const std::vector<IO::Path>&> modelsWereLoadedNotifier;
         private:
+            struct LoadRequest {
+                IO::Path path;
+                std::vector<size_t> frameIndices;
+            };
+
+            struct LoadResult {
+                IO::Path path;
+                std::unique_ptr<EntityModel> model;
+            };
+
             using ModelCache = std::map<IO::Path, std::unique_ptr<EntityModel>>;
             using ModelMismatches = kdl::vector_set<IO::Path>;
             using ModelList = std::vector<EntityModel*>;
@@ -73,6 +103,24 @@ namespace TrenchBroom {
 
             mutable ModelList m_unpreparedModels;
             mutable RendererList m_unpreparedRenderers;
+
+            /**
+             * The models that have been requested but not committed yet. Only accessed by the calling thread.
+             */
+            mutable kdl::vector_set<IO::Path> m_loadingModels;
+            mutable std::vector<std::future<void>> m_loadWorkers;
+
+            /**
+             * Collects the messages logged while loading models on worker threads.
+             */
+            std::unique_ptr<BufferedLogger> m_loadLogger;
+
+            // guarded by m_loadMutex
+            mutable std::mutex m_loadMutex;
+            mutable std::deque<LoadRequest> m_pendingLoads;
+            mutable std::vector<LoadResult> m_finishedLoads;
+            mutable size_t m_activeLoadWorkerCount;
+            mutable bool m_cancelLoads;
         public:
             EntityModelManager(int magFilter, int minFilter, Logger& logger);
             ~EntityModelManager();
@@ -84,11 +132,25 @@ namespace TrenchBroom {
             Renderer::TexturedRenderer* renderer(const ModelSpecification& spec) const;
 
             const EntityModelFrame* frame(const ModelSpecification& spec) const;
+
+            /**
+             * Indicates whether any models are being loaded or have been loaded but not committed yet, i.e., whether
+             * commitLoadedModels should be called again.
+             */
+            bool hasPendingLoads() const;
+
+            /**
+             * Adds the models that have finished loading since the last call, passes on the messages that were
+             * logged while loading them and notifies modelsWereLoadedNotifier.
+             */
+            void commitLoadedModels();
         private:
-            EntityModel* model(const IO::Path& path) const;
-            EntityModel* safeGetModel(const IO::Path& path) const;
-            std::unique_ptr<EntityModel> loadModel(const IO::Path& path) const;
-            void loadFrame(const ModelSpecification& spec, EntityModel& model) const;
+            EntityModel* model(const IO::Path& path, size_t frameIndex) const;
+            void requestModel(const IO::Path& path, size_t frameIndex) const;
+            void runLoadWorker() const;
+            std::unique_ptr<EntityModel> loadModel(const LoadRequest& request, Logger& logger) const;
+            void loadFrame(const ModelSpecification& spec, EntityModel& model, Logger& logger) const;
+            void cancelLoads();
         public:
             void prepare(Renderer::VboManager& vboManager);
         private:
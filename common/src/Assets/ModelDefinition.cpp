@@ -83,22 +83,31 @@ namespace TrenchBroom {
         }
 
         ModelDefinition::ModelDefinition() :
-        m_expression(EL::LiteralExpression(EL::Value::Undefined), 0, 0) {}
+        m_expression(EL::LiteralExpression(EL::Value::Undefined), 0, 0),
+        m_variableNames(m_expression.variableNames()) {}
 
         ModelDefinition::ModelDefinition(const size_t line, const size_t column) :
-        m_expression(EL::LiteralExpression(EL::Value::Undefined), line, column) {}
+        m_expression(EL::LiteralExpression(EL::Value::Undefined), line, column),
+        m_variableNames(m_expression.variableNames()) {}
 
         ModelDefinition::ModelDefinition(const EL::Expression& expression) :
-        m_expression(expression) {}
+        m_expression(expression),
+        m_variableNames(m_expression.variableNames()) {}
 
         void ModelDefinition::append(const ModelDefinition& other) {
             std::vector<EL::Expression> cases;
             cases.push_back(m_expression);
             cases.push_back(other.m_expression);
-        
+
             const size_t line = m_expression.line();
             const size_t column = m_expression.column();
             m_expression = EL::Expression(EL::SwitchExpression(std::move(cases)), line, column);
+            m_expression.optimize();
+            m_variableNames = m_expression.variableNames();
+        }
+
+        const std::vector<std::string>& ModelDefinition::variableNames() const {
+            return m_variableNames;
         }
 
         ModelSpecification ModelDefinition::modelSpecification(const Model::EntityAttributes& attributes) const {
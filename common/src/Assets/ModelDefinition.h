@@ -24,6 +24,8 @@
 #include "IO/Path.h"
 
 #include <iosfwd>
+#include <string>
+#include <vector>
 
 namespace TrenchBroom {
     namespace Model {
@@ -53,6 +55,7 @@ namespace TrenchBroom {
         class ModelDefinition {
         private:
             EL::Expression m_expression;
+            std::vector<std::string> m_variableNames;
         public:
             ModelDefinition();
             ModelDefinition(size_t line, size_t column);
@@ -60,6 +63,12 @@ namespace TrenchBroom {
 
             void append(const ModelDefinition& other);
 
+            /**
+             * Returns the sorted names of all variables referenced by the model expression. The model specification
+             * of an entity can only change if the value of one of the attributes with these names changes.
+             */
+            const std::vector<std::string>& variableNames() const;
+
             /**
              * Evaluates the model expresion, using the given entity attributes to interpolate variables.
              *
@@ -39,7 +39,9 @@ namespace TrenchBroom {
         m_type(type),
         m_culling(TextureCulling::CullDefault),
         m_blendFunc{TextureBlendFunc::Enable::UseDefault, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA},
-        m_textureId(0) {
+        m_textureId(0),
+        m_tagMatchCacheId(0u),
+        m_tagMatches(0u) {
             assert(m_width > 0);
             assert(m_height > 0);
             assert(buffer.size() >= m_width * m_height * bytesPerPixelForFormat(format));
@@ -59,7 +61,9 @@ namespace TrenchBroom {
         m_culling(TextureCulling::CullDefault),
         m_blendFunc{TextureBlendFunc::Enable::UseDefault, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA},
         m_textureId(0),
-        m_buffers(std::move(buffers)) {
+        m_buffers(std::move(buffers)),
+        m_tagMatchCacheId(0u),
+        m_tagMatches(0u) {
             assert(m_width > 0);
             assert(m_height > 0);
 
@@ -84,7 +88,9 @@ namespace TrenchBroom {
         m_type(type),
         m_culling(TextureCulling::CullDefault),
         m_blendFunc{TextureBlendFunc::Enable::UseDefault, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA},
-        m_textureId(0) {}
+        m_textureId(0),
+        m_tagMatchCacheId(0u),
+        m_tagMatches(0u) {}
 
         Texture::~Texture() {
             if (m_collection == nullptr && m_textureId != 0) {
@@ -135,6 +141,7 @@ namespace TrenchBroom {
 
         void Texture::setSurfaceParms(const std::set<std::string>& surfaceParms) {
             m_surfaceParms = surfaceParms;
+            m_tagMatchCacheId = 0u;
         }
 
         TextureCulling Texture::culling() const {
@@ -167,8 +174,8 @@ namespace TrenchBroom {
         }
 
         void Texture::decUsageCount() {
-            assert(m_usageCount > 0);
-            --m_usageCount;
+            [[maybe_unused]] const auto previousUsageCount = m_usageCount--;
+            assert(previousUsageCount > 0);
             if (m_collection != nullptr) {
                 m_collection->decUsageCount();
             }
@@ -182,6 +189,18 @@ namespace TrenchBroom {
             m_overridden = overridden;
         }
 
+        std::optional<uint64_t> Texture::cachedTagMatches(const size_t cacheId) const {
+            if (cacheId == 0u || cacheId != m_tagMatchCacheId) {
+                return std::nullopt;
+            }
+            return m_tagMatches;
+        }
+
+        void Texture::setCachedTagMatches(const size_t cacheId, const uint64_t tagMatches) const {
+            m_tagMatchCacheId = cacheId;
+            m_tagMatches = tagMatches;
+        }
+
         bool Texture::isPrepared() const {
             return m_textureId != 0;
         }
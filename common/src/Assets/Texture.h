@@ -25,6 +25,9 @@
 
 #include <vecmath/forward.h>
 
+#include <atomic>
+#include <cstdint>
+#include <optional>
 #include <set>
 #include <string>
 #include <vector>
@@ -82,7 +85,8 @@ namespace TrenchBroom {
             size_t m_height;
             Color m_averageColor;
 
-            size_t m_usageCount;
+            // brush faces referencing this texture may be copied on worker threads
+            std::atomic<size_t> m_usageCount;
             bool m_overridden;
 
             GLenum m_format;
@@ -99,6 +103,10 @@ namespace TrenchBroom {
 
             mutable GLuint m_textureId;
             mutable BufferList m_buffers;
+
+            // Cached results of matching the texture based smart tags against this texture, see Model::TagManager.
+            mutable size_t m_tagMatchCacheId;
+            mutable uint64_t m_tagMatches;
         public:
             Texture(const std::string& name, size_t width, size_t height, const Color& averageColor, Buffer&& buffer, GLenum format, TextureType type);
             Texture(const std::string& name, size_t width, size_t height, const Color& averageColor, BufferList&& buffers, GLenum format, TextureType type);
@@ -133,6 +141,20 @@ namespace TrenchBroom {
             bool overridden() const;
             void setOverridden(bool overridden);
 
+            /**
+             * Returns the cached smart tag matches of this texture if they were cached under the given cache id.
+             *
+             * @param cacheId identifies the smart tags that the cached matches were computed for
+             * @return the cached matches as a bit mask of tag types
+             */
+            std::optional<uint64_t> cachedTagMatches(size_t cacheId) const;
+
+            /**
+             * Caches the given smart tag matches of this texture under the given cache id, replacing any previously
+             * cached matches.
+             */
+            void setCachedTagMatches(size_t cacheId, uint64_t tagMatches) const;
+
             bool isPrepared() const;
             void prepare(GLuint textureId, int minFilter, int magFilter);
             void setMode(int minFilter, int magFilter);
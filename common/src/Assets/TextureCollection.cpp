@@ -29,25 +29,39 @@
 
 namespace TrenchBroom {
     namespace Assets {
+        static thread_local size_t suppressUsageCountNotificationsDepth = 0u;
+
+        TextureCollection::SuppressUsageCountNotifications::SuppressUsageCountNotifications() {
+            ++suppressUsageCountNotificationsDepth;
+        }
+
+        TextureCollection::SuppressUsageCountNotifications::~SuppressUsageCountNotifications() {
+            --suppressUsageCountNotificationsDepth;
+        }
+
         TextureCollection::TextureCollection() :
         m_loaded(false),
-        m_usageCount(0) {}
+        m_usageCount(0),
+        m_preparedCount(0) {}
 
         TextureCollection::TextureCollection(const std::vector<Texture*>& textures) :
         m_loaded(false),
-        m_usageCount(0) {
+        m_usageCount(0),
+        m_preparedCount(0) {
             addTextures(textures);
         }
 
         TextureCollection::TextureCollection(const IO::Path& path) :
         m_loaded(false),
         m_path(path),
-        m_usageCount(0) {}
+        m_usageCount(0),
+        m_preparedCount(0) {}
 
         TextureCollection::TextureCollection(const IO::Path& path, const std::vector<Texture*>& textures) :
         m_loaded(true),
         m_path(path),
-        m_usageCount(0) {
+        m_usageCount(0),
+        m_preparedCount(0) {
             addTextures(textures);
         }
 
@@ -116,20 +130,35 @@ namespace TrenchBroom {
         }
 
         bool TextureCollection::prepared() const {
-            return !m_textureIds.empty();
+            return !m_textureIds.empty() && m_preparedCount == m_textureIds.size();
         }
 
-        void TextureCollection::prepare(const int minFilter, const int magFilter) {
-            assert(!prepared());
+        static size_t uploadSize(const Texture& texture) {
+            size_t result = 0;
+            for (const auto& buffer : texture.buffersIfUnprepared()) {
+                result += buffer.size();
+            }
+            return result;
+        }
 
-            m_textureIds.resize(textureCount());
-            glAssert(glGenTextures(static_cast<GLsizei>(textureCount()),
-                                   static_cast<GLuint*>(&m_textureIds.front())));
+        size_t TextureCollection::prepare(const int minFilter, const int magFilter, const size_t maxBytes) {
+            assert(!prepared());
 
-            for (size_t i = 0; i < textureCount(); ++i) {
-                Texture* texture = m_textures[i];
-                texture->prepare(m_textureIds[i], minFilter, magFilter);
+            if (m_textureIds.empty()) {
+                m_textureIds.resize(textureCount());
+                glAssert(glGenTextures(static_cast<GLsizei>(textureCount()),
+                                       static_cast<GLuint*>(&m_textureIds.front())));
             }
+
+            size_t uploadedBytes = 0;
+            do {
+                Texture* texture = m_textures[m_preparedCount];
+                uploadedBytes += uploadSize(*texture);
+                texture->prepare(m_textureIds[m_preparedCount], minFilter, magFilter);
+                ++m_preparedCount;
+            } while (m_preparedCount < textureCount() && uploadedBytes < maxBytes);
+
+            return uploadedBytes;
         }
 
         void TextureCollection::setTextureMode(const int minFilter, const int magFilter) {
@@ -140,13 +169,17 @@ namespace TrenchBroom {
 
         void TextureCollection::incUsageCount() {
             ++m_usageCount;
-            usageCountDidChange();
+            if (suppressUsageCountNotificationsDepth == 0u) {
+                usageCountDidChange();
+            }
         }
 
         void TextureCollection::decUsageCount() {
-            assert(m_usageCount > 0);
-            --m_usageCount;
-            usageCountDidChange();
+            [[maybe_unused]] const auto previousUsageCount = m_usageCount--;
+            assert(previousUsageCount > 0);
+            if (suppressUsageCountNotificationsDepth == 0u) {
+                usageCountDidChange();
+            }
         }
     }
 }
@@ -20,10 +20,13 @@
 #ifndef TrenchBroom_TextureCollection
 #define TrenchBroom_TextureCollection
 
+#include "Macros.h"
 #include "Notifier.h"
 #include "IO/Path.h"
 #include "Renderer/GL.h"
 
+#include <atomic>
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -39,13 +42,28 @@ namespace TrenchBroom {
             IO::Path m_path;
             std::vector<Texture*> m_textures;
 
-            size_t m_usageCount;
+            std::atomic<size_t> m_usageCount;
 
             TextureIdList m_textureIds;
+            size_t m_preparedCount;
 
             friend class Texture;
         public:
             Notifier<> usageCountDidChange;
+
+            /**
+             * While an instance of this class exists, usage count changes made on the current thread do not notify the
+             * observers of usageCountDidChange. The observers must only be called on the UI thread, so worker threads
+             * that copy brush faces must create an instance of this class. The brushes they create must be committed
+             * on the UI thread, which replaces the previous brushes and notifies the observers then.
+             */
+            class SuppressUsageCountNotifications {
+            public:
+                SuppressUsageCountNotifications();
+                ~SuppressUsageCountNotifications();
+
+                deleteCopyAndMove(SuppressUsageCountNotifications)
+            };
         public:
             TextureCollection();
             explicit TextureCollection(const std::vector<Texture*>& textures);
@@ -67,7 +85,18 @@ namespace TrenchBroom {
             size_t usageCount() const;
 
             bool prepared() const;
-            void prepare(int minFilter, int magFilter);
+
+            /**
+             * Uploads textures of this collection to the GPU, continuing with the first texture that has not been
+             * uploaded yet, until at least the given number of bytes has been uploaded or all textures are uploaded.
+             * At least one texture is uploaded per call.
+             *
+             * @param minFilter the minification filter
+             * @param magFilter the magnification filter
+             * @param maxBytes the number of bytes after which to stop uploading
+             * @return the number of bytes that were uploaded
+             */
+            size_t prepare(int minFilter, int magFilter, size_t maxBytes = std::numeric_limits<size_t>::max());
             void setTextureMode(int minFilter, int magFilter);
         private:
             void incUsageCount();
@@ -19,18 +19,24 @@
 
 #include "TextureManager.h"
 
+#include "BufferedLogger.h"
 #include "Exceptions.h"
+#include "InternedString.h"
 #include "Logger.h"
 #include "Assets/Texture.h"
 #include "Assets/TextureCollection.h"
 #include "IO/TextureLoader.h"
 
 #include <kdl/map_utils.h>
+#include <kdl/parallel.h>
 #include <kdl/string_format.h>
 #include <kdl/vector_utils.h>
 
 #include <algorithm>
+#include <cassert>
+#include <chrono>
 #include <iterator>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -59,31 +65,37 @@ namespace TrenchBroom {
         m_logger(logger),
         m_minFilter(minFilter),
         m_magFilter(magFilter),
-        m_resetTextureMode(false) {}
+        m_resetTextureMode(false),
+        m_uploadBudget(DefaultUploadBudget),
+        m_loadingCount(0u),
+        m_loadLogger(std::make_unique<BufferedLogger>(logger)),
+        m_cancelLoads(false) {}
 
         TextureManager::~TextureManager() {
             clear();
         }
 
-        void TextureManager::setTextureCollections(const std::vector<IO::Path>& paths, IO::TextureLoader& loader) {
+        Logger& TextureManager::loadLogger() {
+            return *m_loadLogger;
+        }
+
+        void TextureManager::setTextureCollections(const std::vector<IO::Path>& paths, std::unique_ptr<IO::TextureLoader> loader) {
+            cancelLoads();
+
             auto collections = collectionMap();
             m_collections.clear();
             clear();
 
-            for (const auto& path : paths) {
+            // collections that must be loaded are represented by placeholders until they have been decoded
+            const auto mustLoad = findCollectionsToLoad(paths, collections);
+            auto requests = std::deque<LoadRequest>();
+            for (size_t i = 0; i < paths.size(); ++i) {
+                const auto& path = paths[i];
                 const auto it = collections.find(path);
-                if (it == std::end(collections) || !it->second->loaded()) {
-                    try {
-                        auto collection = loader.loadTextureCollection(path);
-                        m_logger.info() << "Loaded texture collection '" << path << "'";
-                        collection->usageCountDidChange.addObserver(usageCountDidChange);
-                        addTextureCollection(collection.release());
-                    } catch (const Exception& e) {
-                        addTextureCollection(new Assets::TextureCollection(path));
-                        if (it == std::end(collections)) {
-                            m_logger.error() << "Could not load texture collection '" << path << "': " << e.what();
-                        }
-                    }
+                if (mustLoad[i]) {
+                    // don't report the same error again if the collection could not be loaded before
+                    requests.push_back(LoadRequest{ path, it == std::end(collections) });
+                    addTextureCollection(new Assets::TextureCollection(path));
                 } else {
                     addTextureCollection(it->second);
                 }
@@ -94,6 +106,20 @@ namespace TrenchBroom {
 
             updateTextures();
             kdl::vec_append(m_toRemove, kdl::map_values(collections));
+
+            if (!requests.empty()) {
+                m_loader = std::move(loader);
+                m_loadingCount = requests.size();
+
+                const auto workerCount = std::min(requests.size(), kdl::parallel_thread_count());
+                {
+                    std::lock_guard<std::mutex> lock(m_loadMutex);
+                    m_pendingLoads = std::move(requests);
+                }
+                for (size_t i = 0; i < workerCount; ++i) {
+                    m_loadWorkers.push_back(std::async(std::launch::async, [this]() { runLoadWorker(); }));
+                }
+            }
         }
 
         void TextureManager::setTextureCollections(const std::vector<TextureCollection*>& collections) {
@@ -105,6 +131,21 @@ namespace TrenchBroom {
             updateTextures();
         }
 
+        std::vector<bool> TextureManager::findCollectionsToLoad(const std::vector<IO::Path>& paths, TextureCollectionMap collections) {
+            auto result = std::vector<bool>();
+            result.reserve(paths.size());
+
+            for (const auto& path : paths) {
+                const auto it = collections.find(path);
+                result.push_back(it == std::end(collections) || !it->second->loaded());
+                if (it != std::end(collections)) {
+                    collections.erase(it);
+                }
+            }
+
+            return result;
+        }
+
         TextureManager::TextureCollectionMap TextureManager::collectionMap() const {
             auto result = TextureCollectionMap();
             for (auto* collection : m_collections) {
@@ -123,11 +164,14 @@ namespace TrenchBroom {
         }
 
         void TextureManager::clear() {
+            cancelLoads();
+
             kdl::vec_clear_and_delete(m_collections);
             kdl::vec_clear_and_delete(m_toRemove);
 
             m_toPrepare.clear();
             m_texturesByName.clear();
+            m_texturesById.clear();
             m_textures.clear();
 
             // Remove logging because it might fail when the document is already destroyed.
@@ -139,10 +183,132 @@ namespace TrenchBroom {
             m_resetTextureMode = true;
         }
 
+        void TextureManager::setUploadBudget(const size_t uploadBudget) {
+            m_uploadBudget = uploadBudget;
+        }
+
         void TextureManager::commitChanges() {
+            // the placeholders replaced by commitLoadedCollections may still be referenced by views until they have
+            // been notified, so they are deleted in the next call
+            kdl::vec_clear_and_delete(m_toRemove);
+
+            commitLoadedCollections();
             resetTextureMode();
             prepare();
-            kdl::vec_clear_and_delete(m_toRemove);
+        }
+
+        bool TextureManager::hasPendingChanges() const {
+            return !m_toPrepare.empty();
+        }
+
+        void TextureManager::commitLoadedCollections() {
+            auto results = std::vector<LoadResult>();
+            {
+                std::lock_guard<std::mutex> lock(m_loadMutex);
+                std::swap(results, m_finishedLoads);
+            }
+
+            m_loadLogger->flush();
+
+            // forget the workers that have run out of requests
+            using namespace std::chrono_literals;
+            kdl::vec_erase_if(m_loadWorkers, [](const auto& worker) { return worker.wait_for(0s) == std::future_status::ready; });
+
+            if (results.empty()) {
+                return;
+            }
+
+            auto loadedCollections = std::vector<TextureCollection*>();
+            for (auto& result : results) {
+                assert(m_loadingCount > 0u);
+                --m_loadingCount;
+
+                if (result.collection != nullptr) {
+                    const auto it = std::find_if(std::begin(m_collections), std::end(m_collections), [&](const auto* collection) {
+                        return !collection->loaded() && collection->path() == result.path;
+                    });
+                    assert(it != std::end(m_collections));
+
+                    m_logger.info() << "Loaded texture collection '" << result.path << "'";
+                    m_toRemove.push_back(*it);
+
+                    auto* collection = result.collection.release();
+                    collection->usageCountDidChange.addObserver(usageCountDidChange);
+                    *it = collection;
+                    m_toPrepare.push_back(collection);
+                    loadedCollections.push_back(collection);
+                } else if (result.reportErrors) {
+                    m_logger.error() << "Could not load texture collection '" << result.path << "': " << result.error;
+                }
+            }
+
+            if (m_loadingCount == 0u) {
+                m_loader.reset();
+            }
+
+            updateTextures();
+            collectionsWereLoadedNotifier(loadedCollections);
+        }
+
+        bool TextureManager::hasPendingLoads() const {
+            return m_loadingCount > 0u;
+        }
+
+        void TextureManager::waitForPendingLoads() {
+            for (auto& worker : m_loadWorkers) {
+                worker.get();
+            }
+            m_loadWorkers.clear();
+        }
+
+        void TextureManager::runLoadWorker() {
+            while (true) {
+                auto request = LoadRequest();
+                {
+                    std::lock_guard<std::mutex> lock(m_loadMutex);
+                    if (m_cancelLoads || m_pendingLoads.empty()) {
+                        return;
+                    }
+                    request = std::move(m_pendingLoads.front());
+                    m_pendingLoads.pop_front();
+                }
+
+                auto result = LoadResult{ std::move(request.path), request.reportErrors, nullptr, "" };
+                try {
+                    result.collection = m_loader->loadTextureCollection(result.path);
+                } catch (const Exception& e) {
+                    result.error = e.what();
+                }
+
+                std::lock_guard<std::mutex> lock(m_loadMutex);
+                m_finishedLoads.push_back(std::move(result));
+            }
+        }
+
+        void TextureManager::cancelLoads() {
+            {
+                std::lock_guard<std::mutex> lock(m_loadMutex);
+                m_cancelLoads = true;
+                m_pendingLoads.clear();
+            }
+
+            // wait for the workers to finish the collections they are currently decoding
+            for (auto& worker : m_loadWorkers) {
+                worker.get();
+            }
+            m_loadWorkers.clear();
+
+            {
+                std::lock_guard<std::mutex> lock(m_loadMutex);
+                m_finishedLoads.clear();
+                m_cancelLoads = false;
+            }
+
+            m_loader.reset();
+            m_loadingCount = 0u;
+
+            // the messages of the cancelled loads are dropped, see clear()
+            m_loadLogger->discard();
         }
 
         Texture* TextureManager::texture(const std::string& name) const {
@@ -154,6 +320,11 @@ namespace TrenchBroom {
             }
         }
 
+        Texture* TextureManager::texture(const InternedString& name) const {
+            const auto id = name.toLower().id();
+            return id < m_texturesById.size() ? m_texturesById[id] : nullptr;
+        }
+
         const std::vector<Texture*>& TextureManager::textures() const {
             return m_textures;
         }
@@ -179,13 +350,27 @@ namespace TrenchBroom {
         }
 
         void TextureManager::prepare() {
-            std::for_each(std::begin(m_toPrepare), std::end(m_toPrepare),
-                          [this](auto collection) { collection->prepare(m_minFilter, m_magFilter); });
-            m_toPrepare.clear();
+            // upload at most m_uploadBudget bytes (but at least one texture) so that uploading large collections
+            // doesn't stall rendering
+            auto remainingBudget = m_uploadBudget;
+            auto it = std::begin(m_toPrepare);
+            while (it != std::end(m_toPrepare)) {
+                auto* collection = *it;
+                const auto uploadedBytes = collection->prepare(m_minFilter, m_magFilter, remainingBudget);
+                remainingBudget -= std::min(uploadedBytes, remainingBudget);
+                if (collection->prepared()) {
+                    ++it;
+                }
+                if (remainingBudget == 0u) {
+                    break;
+                }
+            }
+            m_toPrepare.erase(std::begin(m_toPrepare), it);
         }
 
         void TextureManager::updateTextures() {
             m_texturesByName.clear();
+            m_texturesById.clear();
             m_textures.clear();
 
             for (auto* collection : m_collections) {
@@ -204,6 +389,14 @@ namespace TrenchBroom {
             }
 
             m_textures = kdl::map_values(m_texturesByName);
+
+            for (const auto& [name, texture] : m_texturesByName) {
+                const auto id = InternedString(name).id();
+                if (id >= m_texturesById.size()) {
+                    m_texturesById.resize(id + 1u, nullptr);
+                }
+                m_texturesById[id] = texture;
+            }
         }
     }
 }
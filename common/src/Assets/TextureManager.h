@@ -21,16 +21,22 @@
 #define TrenchBroom_TextureManager
 
 #include "Notifier.h"
+#include "IO/Path.h"
 
+#include <deque>
+#include <future>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
 namespace TrenchBroom {
+    class BufferedLogger;
+    class InternedString;
     class Logger;
 
     namespace IO {
-        class Path;
         class TextureLoader;
     }
 
@@ -38,8 +44,32 @@ namespace TrenchBroom {
         class Texture;
         class TextureCollection;
 
+        /**
+         * Manages the texture collections of a document.
+         *
+         * Texture collections are decoded on worker threads. Until a collection has been decoded, it is represented by
+         * an unloaded placeholder collection without any textures. The decoded collections replace their placeholders
+         * in commitChanges, and their textures are then uploaded to the GPU within the upload budget.
+         */
         class TextureManager {
+        public:
+            /**
+             * The default number of bytes of texture data that is uploaded to the GPU per call to commitChanges.
+             */
+            static const size_t DefaultUploadBudget = 16u * 1024u * 1024u;
         private:
+            struct LoadRequest {
+                IO::Path path;
+                bool reportErrors;
+            };
+
+            struct LoadResult {
+                IO::Path path;
+                bool reportErrors;
+                std::unique_ptr<TextureCollection> collection;
+                std::string error;
+            };
+
             using TextureCollectionMap = std::map<IO::Path, TextureCollection*>;
             using TextureCollectionMapEntry = std::pair<IO::Path, TextureCollection*>;
             using TextureMap = std::map<std::string, Texture*>;
@@ -52,33 +82,117 @@ namespace TrenchBroom {
             std::vector<TextureCollection*> m_toRemove;
 
             TextureMap m_texturesByName;
+            // indexed by the IDs of the interned lower case texture names
+            std::vector<Texture*> m_texturesById;
             std::vector<Texture*> m_textures;
 
             int m_minFilter;
             int m_magFilter;
             bool m_resetTextureMode;
+            size_t m_uploadBudget;
+
+            /**
+             * The loader used by the workers, and the number of placeholder collections that are waiting for their
+             * collections to be decoded. Only accessed by the calling thread.
+             */
+            std::unique_ptr<IO::TextureLoader> m_loader;
+            size_t m_loadingCount;
+            std::vector<std::future<void>> m_loadWorkers;
+
+            /**
+             * Collects the messages logged while decoding texture collections on worker threads.
+             */
+            std::unique_ptr<BufferedLogger> m_loadLogger;
+
+            // guarded by m_loadMutex
+            std::mutex m_loadMutex;
+            std::deque<LoadRequest> m_pendingLoads;
+            std::vector<LoadResult> m_finishedLoads;
+            bool m_cancelLoads;
         public:
             Notifier<> usageCountDidChange;
+
+            /**
+             * Notified by commitLoadedCollections with the decoded texture collections that have replaced their
+             * placeholders, so that their textures can be assigned to the brush faces that use them.
+             */
+            Notifier<const std::vector<TextureCollection*>&> collectionsWereLoadedNotifier;
         public:
             TextureManager(int magFilter, int minFilter, Logger& logger);
             ~TextureManager();
 
-            void setTextureCollections(const std::vector<IO::Path>& paths, IO::TextureLoader& loader);
+            /**
+             * Returns the logger to pass to the texture loaders given to setTextureCollections. Messages logged from
+             * worker threads are passed on to this manager's logger in commitChanges.
+             */
+            Logger& loadLogger();
+
+            /**
+             * Sets the texture collections with the given paths and returns immediately. Collections that are not
+             * loaded yet are decoded by the given loader on worker threads, see commitLoadedCollections.
+             */
+            void setTextureCollections(const std::vector<IO::Path>& paths, std::unique_ptr<IO::TextureLoader> loader);
             void setTextureCollections(const std::vector<TextureCollection*>& collections);
         private:
+            static std::vector<bool> findCollectionsToLoad(const std::vector<IO::Path>& paths, TextureCollectionMap collections);
             TextureCollectionMap collectionMap() const;
             void addTextureCollection(Assets::TextureCollection* collection);
         public:
             void clear();
 
             void setTextureMode(int minFilter, int magFilter);
+
+            /**
+             * Sets the maximum number of bytes of texture data to upload to the GPU per call to commitChanges. At
+             * least one texture is uploaded per call if any are pending.
+             */
+            void setUploadBudget(size_t uploadBudget);
+
+            /**
+             * Uploads pending textures to the GPU within the upload budget and deletes removed texture collections.
+             * Textures that have not been uploaded yet are rendered using their average color.
+             */
             void commitChanges();
 
+            /**
+             * Indicates whether there are textures left to upload, i.e., whether commitChanges should be called
+             * again. Texture collections that are still being decoded are not considered, see hasPendingLoads.
+             */
+            bool hasPendingChanges() const;
+
+            /**
+             * Replaces the placeholders of the texture collections that have been decoded since the last call, passes
+             * on the messages that were logged while decoding them and notifies collectionsWereLoadedNotifier. This
+             * is called by commitChanges, but it doesn't require an OpenGL context.
+             */
+            void commitLoadedCollections();
+
+            /**
+             * Indicates whether any texture collections are still being decoded, i.e., whether
+             * commitLoadedCollections should be called again.
+             */
+            bool hasPendingLoads() const;
+
+            /**
+             * Blocks until the worker threads have decoded all pending texture collections. The collections must
+             * still be committed by calling commitLoadedCollections.
+             */
+            void waitForPendingLoads();
+
             Texture* texture(const std::string& name) const;
+
+            /**
+             * Returns the texture with the given name, ignoring case. This doesn't require a lookup by name and
+             * should be preferred if the name is already interned.
+             */
+            Texture* texture(const InternedString& name) const;
             const std::vector<Texture*>& textures() const;
             const std::vector<TextureCollection*>& collections() const;
             const std::vector<std::string> collectionNames() const;
         private:
+            void runLoadWorker();
+            void cancelLoads();
+
             void resetTextureMode();
             void prepare();
 
@@ -0,0 +1,62 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRENCHBROOM_BUFFEREDLOGGER_H
+#define TRENCHBROOM_BUFFEREDLOGGER_H
+
+#include "Macros.h"
+#include "Logger.h"
+
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+class QString;
+
+namespace TrenchBroom {
+    /**
+     * A logger that can be used from multiple threads at once. Messages are stored until they are passed on to the
+     * target logger by calling flush(), which must happen on the thread that owns the target logger. Any remaining
+     * messages are flushed when this logger is destroyed.
+     */
+    class BufferedLogger : public Logger {
+    private:
+        Logger& m_target;
+        std::mutex m_mutex;
+        std::vector<std::pair<LogLevel, std::string>> m_messages;
+    public:
+        explicit BufferedLogger(Logger& target);
+        ~BufferedLogger() override;
+
+        void flush();
+
+        /**
+         * Removes all stored messages without passing them on to the target logger.
+         */
+        void discard();
+    private:
+        void doLog(LogLevel level, const std::string& message) override;
+        void doLog(LogLevel level, const QString& message) override;
+
+        deleteCopyAndMove(BufferedLogger)
+    };
+}
+
+#endif /* TRENCHBROOM_BUFFEREDLOGGER_H */
@@ -76,6 +76,13 @@ namespace TrenchBroom {
             Value evaluate(const EvaluationContext& context) const;
             bool optimize();
 
+            /**
+             * Returns the names of all variables that are referenced by this expression, sorted and without
+             * duplicates. The value of this expression only depends on the values of these variables.
+             */
+            std::vector<std::string> variableNames() const;
+            void appendVariableNames(std::vector<std::string>& result) const;
+
             size_t line() const;
             size_t column() const;
 
@@ -94,6 +101,7 @@ namespace TrenchBroom {
             LiteralExpression(Value value);
             
             const Value& evaluate(const EvaluationContext& context) const;
+            void appendVariableNames(std::vector<std::string>& result) const;
             
             friend std::ostream& operator<<(std::ostream& str, const LiteralExpression& exp);
         };
@@ -105,6 +113,7 @@ namespace TrenchBroom {
             VariableExpression(std::string variableName);
             
             Value evaluate(const EvaluationContext& context) const;
+            void appendVariableNames(std::vector<std::string>& result) const;
             
             friend std::ostream& operator<<(std::ostream& str, const VariableExpression& exp);
         };
@@ -117,6 +126,7 @@ namespace TrenchBroom {
             
             Value evaluate(const EvaluationContext& context) const;
             std::optional<LiteralExpression> optimize();
+            void appendVariableNames(std::vector<std::string>& result) const;
             
             friend std::ostream& operator<<(std::ostream& str, const ArrayExpression& exp);
         };
@@ -129,6 +139,7 @@ namespace TrenchBroom {
 
             Value evaluate(const EvaluationContext& context) const;
             std::optional<LiteralExpression> optimize();
+            void appendVariableNames(std::vector<std::string>& result) const;
             
             friend std::ostream& operator<<(std::ostream& str, const MapExpression& exp);
         };
@@ -150,6 +161,7 @@ namespace TrenchBroom {
 
             Value evaluate(const EvaluationContext& context) const;
             std::optional<LiteralExpression> optimize();
+            void appendVariableNames(std::vector<std::string>& result) const;
             
             friend std::ostream& operator<<(std::ostream& str, const UnaryExpression& exp);
         };
@@ -191,6 +203,7 @@ namespace TrenchBroom {
 
             Value evaluate(const EvaluationContext& context) const;
             std::optional<LiteralExpression> optimize();
+            void appendVariableNames(std::vector<std::string>& result) const;
             
             size_t precedence() const;
 
@@ -208,6 +221,7 @@ namespace TrenchBroom {
             
             Value evaluate(const EvaluationContext& context) const;
             std::optional<LiteralExpression> optimize();
+            void appendVariableNames(std::vector<std::string>& result) const;
             
             friend std::ostream& operator<<(std::ostream& str, const SubscriptExpression& exp);
         };
@@ -220,6 +234,7 @@ namespace TrenchBroom {
 
             Value evaluate(const EvaluationContext& context) const;
             std::optional<LiteralExpression> optimize();
+            void appendVariableNames(std::vector<std::string>& result) const;
             
             friend std::ostream& operator<<(std::ostream& str, const SwitchExpression& exp);
         };
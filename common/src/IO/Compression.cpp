@@ -0,0 +1,57 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Compression.h"
+
+#include "Exceptions.h"
+
+#include <miniz/miniz.h>
+
+#include <string>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace IO {
+        std::vector<unsigned char> compressData(const std::string& data) {
+            auto compressedSize = mz_compressBound(static_cast<mz_ulong>(data.size()));
+            auto result = std::vector<unsigned char>(compressedSize);
+
+            const auto* source = reinterpret_cast<const unsigned char*>(data.data());
+            if (mz_compress2(result.data(), &compressedSize, source, static_cast<mz_ulong>(data.size()), MZ_BEST_SPEED) != MZ_OK) {
+                throw FileFormatException("Could not compress " + std::to_string(data.size()) + " bytes");
+            }
+
+            result.resize(compressedSize);
+            result.shrink_to_fit();
+            return result;
+        }
+
+        std::string decompressData(const std::vector<unsigned char>& data, const size_t size) {
+            auto result = std::string(size, '\0');
+
+            auto uncompressedSize = static_cast<mz_ulong>(size);
+            auto* dest = reinterpret_cast<unsigned char*>(result.data());
+            if (mz_uncompress(dest, &uncompressedSize, data.data(), static_cast<mz_ulong>(data.size())) != MZ_OK || uncompressedSize != size) {
+                throw FileFormatException("Could not decompress " + std::to_string(data.size()) + " bytes");
+            }
+
+            return result;
+        }
+    }
+}
@@ -0,0 +1,52 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRENCHBROOM_COMPRESSION_H
+#define TRENCHBROOM_COMPRESSION_H
+
+#include <string>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace IO {
+        /**
+         * Compresses the given data using deflate. Compression favors speed over size.
+         *
+         * @param data the data to compress
+         * @return the compressed data
+         *
+         * @throw FileFormatException if the data cannot be compressed
+         */
+        std::vector<unsigned char> compressData(const std::string& data);
+
+        /**
+         * Decompresses data that was compressed using compressData.
+         *
+         * @param data the compressed data
+         * @param size the size of the uncompressed data in bytes
+         * @return the uncompressed data
+         *
+         * @throw FileFormatException if the data cannot be decompressed or if its uncompressed size does not match
+         * the given size
+         */
+        std::string decompressData(const std::vector<unsigned char>& data, size_t size);
+    }
+}
+
+#endif
@@ -138,7 +138,7 @@ namespace TrenchBroom {
                     throw FileNotFoundException(fixedPath.asString());
                 }
 
-                return std::make_shared<CFile>(fixedPath);
+                return std::make_shared<MappedFile>(fixedPath);
             }
 
             std::string readFile(const Path& path) {
@@ -20,7 +20,9 @@
 #include "File.h"
 
 #include "Exceptions.h"
-#include "IO/IOUtils.h"
+#include "IO/PathQt.h"
+
+#include <QFile>
 
 namespace TrenchBroom {
     namespace IO {
@@ -63,31 +65,43 @@ namespace TrenchBroom {
             return static_cast<size_t>(m_end - m_begin);
         }
 
-        CFile::CFile(const Path& path) :
-        File(path) {
-            m_file = std::fopen(path.asString().c_str(), "rb");
-            if (m_file == nullptr) {
+        MappedFile::MappedFile(const Path& path) :
+        File(path),
+        m_file(std::make_unique<QFile>(pathAsQString(path))),
+        m_begin(nullptr),
+        m_end(nullptr) {
+            if (!m_file->open(QIODevice::ReadOnly)) {
                 throw FileSystemException("Cannot open file " + path.asString());
             }
-            m_size = fileSize(m_file);
-        }
 
-        CFile::~CFile() {
-            if (m_file != nullptr) {
-                std::fclose(m_file);
+            const auto size = m_file->size();
+            if (size > 0) {
+                const auto* data = m_file->map(0, size);
+                if (data == nullptr) {
+                    throw FileSystemException("Cannot map file " + path.asString() + ": " + m_file->errorString().toStdString());
+                }
+                m_begin = reinterpret_cast<const char*>(data);
+                m_end = m_begin + size;
             }
         }
 
-        Reader CFile::reader() const {
-            return Reader::from(m_file);
+        // QFile unmaps all mapped regions when it is closed or destroyed
+        MappedFile::~MappedFile() = default;
+
+        Reader MappedFile::reader() const {
+            return Reader::from(m_begin, m_end);
         }
 
-        size_t CFile::size() const {
-            return m_size;
+        size_t MappedFile::size() const {
+            return static_cast<size_t>(m_end - m_begin);
+        }
+
+        const char* MappedFile::begin() const {
+            return m_begin;
         }
 
-        std::FILE* CFile::file() const {
-            return m_file;
+        const char* MappedFile::end() const {
+            return m_end;
         }
 
         FileView::FileView(const Path& path, std::shared_ptr<File> file, const size_t offset, const size_t length) :
@@ -23,9 +23,10 @@
 #include "IO/Path.h"
 #include "IO/Reader.h"
 
-#include <cstdio>
 #include <memory>
 
+class QFile;
+
 namespace TrenchBroom {
     namespace IO {
         /**
@@ -107,31 +108,40 @@ namespace TrenchBroom {
         };
 
         /**
-         * A file that is backed by a physical file on the disk. The file is opened in the constructor and closed in
-         * the destructor.
+         * A file that is backed by a physical file on the disk which is mapped into memory. The file is opened and
+         * mapped in the constructor, and it is unmapped and closed in the destructor.
+         *
+         * Readers created from this file (or from views into it) read directly from the mapped memory, so buffering
+         * a file or a portion of it does not copy any data.
          */
-        class CFile : public File {
+        class MappedFile : public File {
         private:
-            std::FILE* m_file;
-            size_t m_size;
+            std::unique_ptr<QFile> m_file;
+            const char* m_begin;
+            const char* m_end;
         public:
             /**
-             * Creates a new file with the given path and opens the file for reading.
+             * Creates a new file with the given path, opens the file for reading and maps it into memory.
              *
              * @param path the path of the file
              *
-             * @throw FileSystemException if the file cannot be opened
+             * @throw FileSystemException if the file cannot be opened or mapped
              */
-            explicit CFile(const Path& path);
-            ~CFile() override;
+            explicit MappedFile(const Path& path);
+            ~MappedFile() override;
 
             Reader reader() const override;
             size_t size() const override;
 
             /**
-             * Returns the underlying file.
+             * Returns a pointer to the beginning of the mapped memory, or nullptr if the file is empty.
+             */
+            const char* begin() const;
+
+            /**
+             * Returns a pointer to the end of the mapped memory, or nullptr if the file is empty.
              */
-            std::FILE* file() const;
+            const char* end() const;
         };
 
         /**
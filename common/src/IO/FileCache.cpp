@@ -0,0 +1,135 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FileCache.h"
+
+#include "IO/File.h"
+
+#include <iterator>
+
+namespace TrenchBroom {
+    namespace IO {
+        FileCache::FileCache(const size_t capacity) :
+        m_capacity(capacity),
+        m_size(0u),
+        m_hits(0u),
+        m_misses(0u),
+        m_evictions(0u) {}
+
+        std::shared_ptr<File> FileCache::get(const Path& imagePath, const Path& filePath) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            const auto it = m_index.find(Key(imagePath, filePath));
+            if (it == std::end(m_index)) {
+                ++m_misses;
+                return nullptr;
+            }
+
+            ++m_hits;
+            m_entries.splice(std::begin(m_entries), m_entries, it->second);
+            return it->second->second;
+        }
+
+        bool FileCache::contains(const Path& imagePath, const Path& filePath) const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_index.count(Key(imagePath, filePath)) > 0u;
+        }
+
+        void FileCache::put(const Path& imagePath, const Path& filePath, std::shared_ptr<File> file) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            auto key = Key(imagePath, filePath);
+            const auto it = m_index.find(key);
+            if (it != std::end(m_index)) {
+                remove(it->second);
+            }
+
+            const auto fileSize = file->size();
+            if (m_capacity > 0u) {
+                if (fileSize > m_capacity) {
+                    return;
+                }
+                evictUntil(m_capacity - fileSize);
+            }
+
+            m_entries.emplace_front(key, std::move(file));
+            m_index.emplace(std::move(key), std::begin(m_entries));
+            m_size += fileSize;
+        }
+
+        void FileCache::evict(const Path& imagePath) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            auto it = m_index.lower_bound(Key(imagePath, Path()));
+            while (it != std::end(m_index) && it->first.first == imagePath) {
+                const auto entryIt = it->second;
+                ++it;
+                remove(entryIt);
+            }
+        }
+
+        void FileCache::clear() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            m_index.clear();
+            m_entries.clear();
+            m_size = 0u;
+        }
+
+        size_t FileCache::capacity() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_capacity;
+        }
+
+        void FileCache::setCapacity(const size_t capacity) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            m_capacity = capacity;
+            if (m_capacity > 0u) {
+                evictUntil(m_capacity);
+            }
+        }
+
+        FileCache::Statistics FileCache::statistics() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return Statistics{m_hits, m_misses, m_evictions, m_entries.size(), m_size, m_capacity};
+        }
+
+        void FileCache::resetStatistics() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            m_hits = 0u;
+            m_misses = 0u;
+            m_evictions = 0u;
+        }
+
+        void FileCache::evictUntil(const size_t size) {
+            while (m_size > size && !m_entries.empty()) {
+                remove(std::prev(std::end(m_entries)));
+                ++m_evictions;
+            }
+        }
+
+        void FileCache::remove(const EntryList::iterator it) {
+            m_size -= it->second->size();
+            m_index.erase(it->first);
+            m_entries.erase(it);
+        }
+    }
+}
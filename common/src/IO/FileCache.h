@@ -0,0 +1,112 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRENCHBROOM_FILECACHE_H
+#define TRENCHBROOM_FILECACHE_H
+
+#include "IO/Path.h"
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace TrenchBroom {
+    namespace IO {
+        class File;
+
+        /**
+         * A thread safe cache of files that are expensive to create, such as decompressed entries of an image file
+         * system. Each cached file is identified by the path of the image it was read from and its path within that
+         * image.
+         *
+         * The cache has a capacity in bytes. If adding a file would exceed the capacity, the least recently used files
+         * are evicted until the file fits. Files that are larger than the capacity are not cached at all. A capacity
+         * of 0 means that the cache is unlimited.
+         */
+        class FileCache {
+        public:
+            static const size_t DefaultCapacity = 64u * 1024u * 1024u;
+
+            struct Statistics {
+                size_t hits;
+                size_t misses;
+                size_t evictions;
+                size_t entries;
+                size_t size;
+                size_t capacity;
+            };
+        private:
+            using Key = std::pair<Path, Path>;
+            using Entry = std::pair<Key, std::shared_ptr<File>>;
+            using EntryList = std::list<Entry>;
+
+            mutable std::mutex m_mutex;
+            size_t m_capacity;
+            size_t m_size;
+            // the most recently used entry is at the front
+            EntryList m_entries;
+            std::map<Key, EntryList::iterator> m_index;
+
+            size_t m_hits;
+            size_t m_misses;
+            size_t m_evictions;
+        public:
+            explicit FileCache(size_t capacity = DefaultCapacity);
+
+            /**
+             * Returns the cached file for the given paths, or nullptr if no such file is cached. Counts as a hit or
+             * a miss in the cache statistics.
+             *
+             * @param imagePath the path of the image that contains the file
+             * @param filePath the path of the file within the image
+             */
+            std::shared_ptr<File> get(const Path& imagePath, const Path& filePath);
+
+            /**
+             * Indicates whether a file with the given paths is cached. Does not affect the cache statistics or the
+             * order in which files are evicted.
+             */
+            bool contains(const Path& imagePath, const Path& filePath) const;
+
+            /**
+             * Adds the given file to the cache, replacing any file that was previously cached under the same paths.
+             */
+            void put(const Path& imagePath, const Path& filePath, std::shared_ptr<File> file);
+
+            /**
+             * Removes all files read from the image with the given path.
+             */
+            void evict(const Path& imagePath);
+            void clear();
+
+            size_t capacity() const;
+            void setCapacity(size_t capacity);
+
+            Statistics statistics() const;
+            void resetStatistics();
+        private:
+            void evictUntil(size_t size);
+            void remove(EntryList::iterator it);
+        };
+    }
+}
+
+#endif /* TRENCHBROOM_FILECACHE_H */
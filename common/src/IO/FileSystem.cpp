@@ -143,6 +143,17 @@ namespace TrenchBroom {
             }
         }
 
+        void FileSystem::prefetch(const std::vector<Path>& paths) const {
+            doPrefetch(paths);
+            if (m_next) {
+                // files that exist in this file system shadow the files of the next file systems
+                const auto remainingPaths = kdl::vec_filter(paths, [&](const Path& path) { return !doFileExists(path); });
+                if (!remainingPaths.empty()) {
+                    m_next->prefetch(remainingPaths);
+                }
+            }
+        }
+
         Path FileSystem::_makeAbsolute(const Path& path) const {
             if (doFileExists(path) || doDirectoryExists(path)) {
                 // If the file is present in this file system, make it absolute here.
@@ -193,6 +204,8 @@ namespace TrenchBroom {
             throw FileSystemException("Cannot make absolute path of '" + path.asString() + "'");
         }
 
+        void FileSystem::doPrefetch(const std::vector<Path>& /* paths */) const {}
+
         WritableFileSystem::WritableFileSystem() = default;
         WritableFileSystem::~WritableFileSystem() = default;
 
@@ -115,6 +115,15 @@ namespace TrenchBroom {
 
             std::vector<Path> getDirectoryContents(const Path& directoryPath) const;
             std::shared_ptr<File> openFile(const Path& path) const;
+
+            /**
+             * Prepares the files with the given paths so that opening them later is cheap, e.g. by decompressing them
+             * in parallel. Each path is only prefetched by the first file system in the chain that contains it.
+             * Paths that do not exist are ignored.
+             *
+             * @param paths the paths of the files to prefetch
+             */
+            void prefetch(const std::vector<Path>& paths) const;
         private: // private API to be used for chaining, avoids multiple checks of parameters
             bool _canMakeAbsolute(const Path& path) const;
             Path _makeAbsolute(const Path& path) const;
@@ -209,6 +218,7 @@ namespace TrenchBroom {
             virtual std::vector<Path> doGetDirectoryContents(const Path& path) const = 0;
 
             virtual std::shared_ptr<File> doOpenFile(const Path& path) const = 0;
+            virtual void doPrefetch(const std::vector<Path>& paths) const;
         };
 
         class WritableFileSystem {
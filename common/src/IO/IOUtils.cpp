@@ -19,7 +19,6 @@
 
 #include "IOUtils.h"
 
-#include "Ensure.h"
 #include "Exceptions.h"
 #include "IO/Path.h"
 
@@ -49,29 +48,6 @@ namespace TrenchBroom {
             }
         }
 
-        size_t fileSize(std::FILE* file) {
-            ensure(file != nullptr, "file is null");
-            const auto pos = std::ftell(file);
-            if (pos < 0) {
-                throw FileSystemException("ftell failed");
-            }
-
-            if (std::fseek(file, 0, SEEK_END) != 0) {
-                throw FileSystemException("fseek failed");
-            }
-
-            const auto size = std::ftell(file);
-            if (size < 0) {
-                throw FileSystemException("ftell failed");
-            }
-
-            if (std::fseek(file, pos, SEEK_SET) != 0) {
-                throw FileSystemException("fseek failed");
-            }
-
-            return static_cast<size_t>(size);
-        }
-
         std::string readGameComment(std::istream& stream) {
             return readInfoComment(stream, "Game");
         }
@@ -103,5 +79,10 @@ namespace TrenchBroom {
             std::fprintf(stream, "// Game: %s\n", gameName.c_str());
             std::fprintf(stream, "// Format: %s\n", mapFormat.c_str());
         }
+
+        void writeGameComment(std::string& str, const std::string& gameName, const std::string& mapFormat) {
+            str.append("// Game: ").append(gameName).append("\n");
+            str.append("// Format: ").append(mapFormat).append("\n");
+        }
     }
 }
@@ -40,13 +40,12 @@ namespace TrenchBroom {
             deleteCopyAndMove(OpenFile)
         };
 
-        size_t fileSize(std::FILE* file);
-
         std::string readGameComment(std::istream& stream);
         std::string readFormatComment(std::istream& stream);
         std::string readInfoComment(std::istream& stream, const std::string& name);
 
         void writeGameComment(FILE* stream, const std::string& gameName, const std::string& mapFormat);
+        void writeGameComment(std::string& str, const std::string& gameName, const std::string& mapFormat);
     }
 }
 
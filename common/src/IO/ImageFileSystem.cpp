@@ -20,8 +20,12 @@
 #include "ImageFileSystem.h"
 
 #include "Ensure.h"
+#include "Exceptions.h"
 #include "IO/DiskFileSystem.h"
 #include "IO/File.h"
+#include "IO/FileCache.h"
+
+#include <kdl/parallel.h>
 
 #include <cassert>
 #include <memory>
@@ -30,10 +34,18 @@ namespace TrenchBroom {
     namespace IO {
         ImageFileSystemBase::FileEntry::~FileEntry() = default;
 
-       std::shared_ptr<File> ImageFileSystemBase::FileEntry::open() const {
+        std::shared_ptr<File> ImageFileSystemBase::FileEntry::open() const {
             return doOpen();
         }
 
+        bool ImageFileSystemBase::FileEntry::compressed() const {
+            return doIsCompressed();
+        }
+
+        bool ImageFileSystemBase::FileEntry::doIsCompressed() const {
+            return false;
+        }
+
         ImageFileSystemBase::SimpleFileEntry::SimpleFileEntry(std::shared_ptr<File> file) :
         m_file(std::move(file)) {}
 
@@ -50,6 +62,10 @@ namespace TrenchBroom {
             return std::make_shared<OwningBufferFile>(m_file->path(), std::move(data), m_uncompressedSize);
         }
 
+        bool ImageFileSystemBase::CompressedFileEntry::doIsCompressed() const {
+            return true;
+        }
+
         ImageFileSystemBase::Directory::Directory(const Path& path) :
         m_path(path) {}
 
@@ -165,6 +181,9 @@ namespace TrenchBroom {
         ImageFileSystemBase::~ImageFileSystemBase() = default;
 
         void ImageFileSystemBase::initialize() {
+            // the image may have changed since its files were cached
+            fileCache().evict(m_path);
+
             try {
                 doReadDirectory();
             } catch (const std::exception& e) {
@@ -177,6 +196,32 @@ namespace TrenchBroom {
             initialize();
         }
 
+        void ImageFileSystemBase::doPrefetch(const std::vector<Path>& paths) const {
+            std::vector<std::pair<Path, const FileEntry*>> entries;
+            for (const auto& path : paths) {
+                const auto searchPath = path.makeLowerCase().makeCanonical();
+                if (m_root.fileExists(searchPath)) {
+                    const auto& entry = m_root.findFile(searchPath);
+                    if (entry.compressed() && !fileCache().contains(m_path, searchPath)) {
+                        entries.emplace_back(searchPath, &entry);
+                    }
+                }
+            }
+
+            kdl::parallel_for(entries.size(), [&](const size_t i) {
+                try {
+                    openFileEntry(entries[i].first, *entries[i].second);
+                } catch (const Exception&) {
+                    // the error will be reported when the file is opened
+                }
+            });
+        }
+
+        FileCache& ImageFileSystemBase::fileCache() {
+            static FileCache cache;
+            return cache;
+        }
+
         bool ImageFileSystemBase::doDirectoryExists(const Path& path) const {
             const auto searchPath = path.makeLowerCase().makeCanonical();
             return m_root.directoryExists(searchPath);
@@ -195,12 +240,27 @@ namespace TrenchBroom {
 
         std::shared_ptr<File> ImageFileSystemBase::doOpenFile(const Path& path) const {
             const auto searchPath = path.makeLowerCase().makeCanonical();
-            return m_root.findFile(path).open();
+            return openFileEntry(searchPath, m_root.findFile(searchPath));
+        }
+
+        std::shared_ptr<File> ImageFileSystemBase::openFileEntry(const Path& searchPath, const FileEntry& entry) const {
+            if (!entry.compressed()) {
+                return entry.open();
+            }
+
+            auto& cache = fileCache();
+            if (auto file = cache.get(m_path, searchPath)) {
+                return file;
+            }
+
+            auto file = entry.open();
+            cache.put(m_path, searchPath, file);
+            return file;
         }
 
         ImageFileSystem::ImageFileSystem(std::shared_ptr<FileSystem> next, const Path& path) :
         ImageFileSystemBase(std::move(next), path),
-        m_file(std::make_shared<CFile>(path)) {
+        m_file(std::make_shared<MappedFile>(path)) {
             ensure(m_path.isAbsolute(), "path must be absolute");
         }
     }
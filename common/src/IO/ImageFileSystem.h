@@ -30,8 +30,9 @@
 
 namespace TrenchBroom {
     namespace IO {
-        class CFile;
         class File;
+        class FileCache;
+        class MappedFile;
 
         class ImageFileSystemBase : public FileSystem {
         protected:
@@ -40,8 +41,15 @@ namespace TrenchBroom {
                 virtual ~FileEntry();
 
                 std::shared_ptr<File> open() const;
+
+                /**
+                 * Indicates whether opening this entry requires decompressing it. Such entries are stored in the
+                 * shared file cache once they have been opened.
+                 */
+                bool compressed() const;
             private:
                 virtual std::shared_ptr<File> doOpen() const = 0;
+                virtual bool doIsCompressed() const;
             };
 
             class SimpleFileEntry : public FileEntry {
@@ -62,6 +70,7 @@ namespace TrenchBroom {
                 ~CompressedFileEntry() override = default;
             private:
                 std::shared_ptr<File> doOpen() const override;
+                bool doIsCompressed() const override;
                 virtual std::unique_ptr<char[]> decompress(std::shared_ptr<File> file, size_t uncompressedSize) const = 0;
             };
 
@@ -102,19 +111,36 @@ namespace TrenchBroom {
              * Reload this file system.
              */
             void reload();
+
+            /**
+             * Returns the cache of decompressed files that is shared by all image file systems.
+             */
+            static FileCache& fileCache();
         private:
             bool doDirectoryExists(const Path& path) const override;
             bool doFileExists(const Path& path) const override;
 
             std::vector<Path> doGetDirectoryContents(const Path& path) const override;
             std::shared_ptr<File> doOpenFile(const Path& path) const override;
+
+            /**
+             * Decompresses the files with the given paths in parallel and stores them in the shared file cache.
+             * Paths that do not exist in this file system, files that are not compressed or already cached, and
+             * files that cannot be decompressed are skipped.
+             *
+             * Decompressing entries concurrently requires that the entries do not share any mutable state. Zip
+             * archives meet this requirement only because they are opened with mz_zip_reader_init_mem, so that miniz
+             * reads from the mapped file instead of seeking in a shared file handle.
+             */
+            void doPrefetch(const std::vector<Path>& paths) const override;
+            std::shared_ptr<File> openFileEntry(const Path& searchPath, const FileEntry& entry) const;
         private:
             virtual void doReadDirectory() = 0;
         };
 
         class ImageFileSystem : public ImageFileSystemBase {
         protected:
-            std::shared_ptr<CFile> m_file;
+            std::shared_ptr<MappedFile> m_file;
         protected:
             ImageFileSystem(std::shared_ptr<FileSystem> next, const Path& path);
         };
@@ -26,64 +26,73 @@
 #include "Model/BrushFace.h"
 #include "Model/EntityAttributes.h"
 
+#include <kdl/parallel.h>
+
+#include <cstdarg>
+#include <cstdio>
 #include <memory>
-#include <sstream>
+#include <string>
 
 namespace TrenchBroom {
     namespace IO {
+        /**
+         * Appends the result of formatting the given arguments according to the given printf style format string
+         * to the given string.
+         */
+        static void appendFormat(std::string& str, const char* format, ...) {
+            char buffer[256];
+
+            va_list args;
+            va_start(args, format);
+            va_list argsCopy;
+            va_copy(argsCopy, args);
+
+            const int length = std::vsnprintf(buffer, sizeof(buffer), format, args);
+            if (length > 0) {
+                const auto size = static_cast<size_t>(length);
+                if (size < sizeof(buffer)) {
+                    str.append(buffer, size);
+                } else {
+                    const auto offset = str.size();
+                    str.resize(offset + size + 1u);
+                    std::vsnprintf(&str[offset], size + 1u, format, argsCopy);
+                    str.resize(offset + size);
+                }
+            }
+
+            va_end(argsCopy);
+            va_end(args);
+        }
+
         class QuakeFileSerializer : public MapFileSerializer {
-        private:
-            std::string FacePointFormat;
-            std::string TextureInfoFormat;
-            std::string ValveTextureInfoFormat;
         public:
-            explicit QuakeFileSerializer(FILE* stream) :
-            MapFileSerializer(stream),
-            FacePointFormat(getFacePointFormat()),
-            TextureInfoFormat(" %s %.6g %.6g %.6g %.6g %.6g"),
-            ValveTextureInfoFormat(" %s [ %.6g %.6g %.6g %.6g ] [ %.6g %.6g %.6g %.6g ] %.6g %.6g %.6g") {}
-        private:
-            static std::string getFacePointFormat() {
-                std::stringstream str;
-                str <<
-                "( %." << FloatPrecision << "g " <<
-                "%." << FloatPrecision << "g " <<
-                "%." << FloatPrecision << "g ) " <<
-                "( %." << FloatPrecision << "g " <<
-                "%." << FloatPrecision << "g " <<
-                "%." << FloatPrecision << "g ) " <<
-                "( %." << FloatPrecision << "g " <<
-                "%." << FloatPrecision << "g " <<
-                "%." << FloatPrecision << "g )";
-                return str.str();
-            }
+            QuakeFileSerializer() :
+            MapFileSerializer() {}
         private:
-            size_t doWriteBrushFace(FILE* stream, const Model::BrushFace& face) override {
-                writeFacePoints(stream, face);
-                writeTextureInfo(stream, face);
-                std::fprintf(stream, "\n");
-                return 1;
+            void doWriteBrushFace(std::string& buffer, const Model::BrushFace& face) const override {
+                writeFacePoints(buffer, face);
+                writeTextureInfo(buffer, face);
+                buffer.push_back('\n');
             }
         protected:
-            void writeFacePoints(FILE* stream, const Model::BrushFace& face) {
+            void writeFacePoints(std::string& buffer, const Model::BrushFace& face) const {
                 const Model::BrushFace::Points& points = face.points();
 
-                std::fprintf(stream, FacePointFormat.c_str(),
-                             points[0].x(),
-                             points[0].y(),
-                             points[0].z(),
-                             points[1].x(),
-                             points[1].y(),
-                             points[1].z(),
-                             points[2].x(),
-                             points[2].y(),
-                             points[2].z());
+                appendFormat(buffer, "( %.*g %.*g %.*g ) ( %.*g %.*g %.*g ) ( %.*g %.*g %.*g )",
+                             FloatPrecision, points[0].x(),
+                             FloatPrecision, points[0].y(),
+                             FloatPrecision, points[0].z(),
+                             FloatPrecision, points[1].x(),
+                             FloatPrecision, points[1].y(),
+                             FloatPrecision, points[1].z(),
+                             FloatPrecision, points[2].x(),
+                             FloatPrecision, points[2].y(),
+                             FloatPrecision, points[2].z());
             }
 
-            void writeTextureInfo(FILE* stream, const Model::BrushFace& face) {
-                const std::string& textureName = face.attributes().textureName().empty() ? Model::BrushFaceAttributes::NoTextureName : face.attributes().textureName();
-                std::fprintf(stream, TextureInfoFormat.c_str(),
-                             textureName.c_str(),
+            void writeTextureInfo(std::string& buffer, const Model::BrushFace& face) const {
+                writeTextureName(buffer, face);
+                appendFormat(buffer, " %.6g %.6g %.6g %.6g %.6g",
                              static_cast<double>(face.attributes().xOffset()),
                              static_cast<double>(face.attributes().yOffset()),
                              static_cast<double>(face.attributes().rotation()),
@@ -91,14 +100,12 @@ namespace TrenchBroom {
                              static_cast<double>(face.attributes().yScale()));
             }
 
-            void writeValveTextureInfo(FILE* stream, const Model::BrushFace& face) {
-                const std::string& textureName = face.attributes().textureName().empty() ? Model::BrushFaceAttributes::NoTextureName : face.attributes().textureName();
+            void writeValveTextureInfo(std::string& buffer, const Model::BrushFace& face) const {
                 const vm::vec3 xAxis = face.textureXAxis();
                 const vm::vec3 yAxis = face.textureYAxis();
 
-                std::fprintf(stream, ValveTextureInfoFormat.c_str(),
-                             textureName.c_str(),
-
+                writeTextureName(buffer, face);
+                appendFormat(buffer, " [ %.6g %.6g %.6g %.6g ] [ %.6g %.6g %.6g %.6g ] %.6g %.6g %.6g",
                              xAxis.x(),
                              xAxis.y(),
                              xAxis.z(),
@@ -113,30 +120,32 @@ namespace TrenchBroom {
                              static_cast<double>(face.attributes().xScale()),
                              static_cast<double>(face.attributes().yScale()));
             }
+        private:
+            void writeTextureName(std::string& buffer, const Model::BrushFace& face) const {
+                const std::string& textureName = face.attributes().textureName().empty() ? Model::BrushFaceAttributes::NoTextureName : face.attributes().textureName();
+                buffer.push_back(' ');
+                buffer.append(textureName);
+            }
         };
 
         class Quake2FileSerializer : public QuakeFileSerializer {
-        private:
-            std::string SurfaceAttributesFormat;
         public:
-            explicit Quake2FileSerializer(FILE* stream) :
-            QuakeFileSerializer(stream),
-            SurfaceAttributesFormat(" %d %d %.6g") {}
+            Quake2FileSerializer() :
+            QuakeFileSerializer() {}
         private:
-            size_t doWriteBrushFace(FILE* stream, const Model::BrushFace& face) override {
-                writeFacePoints(stream, face);
-                writeTextureInfo(stream, face);
+            void doWriteBrushFace(std::string& buffer, const Model::BrushFace& face) const override {
+                writeFacePoints(buffer, face);
+                writeTextureInfo(buffer, face);
 
                 // Neverball's "mapc" doesn't like it if surface attributes aren't present.
                 // This suggests the Radiants always output these, so it's probably a compatibility danger.
-                writeSurfaceAttributes(stream, face);
+                writeSurfaceAttributes(buffer, face);
 
-                std::fprintf(stream, "\n");
-                return 1;
+                buffer.push_back('\n');
             }
         protected:
-            void writeSurfaceAttributes(FILE* stream, const Model::BrushFace& face) {
-                std::fprintf(stream, SurfaceAttributesFormat.c_str(),
+            void writeSurfaceAttributes(std::string& buffer, const Model::BrushFace& face) const {
+                appendFormat(buffer, " %d %d %.6g",
                              face.attributes().surfaceContents(),
                              face.attributes().surfaceFlags(),
                              static_cast<double>(face.attributes().surfaceValue()));
@@ -145,44 +154,39 @@ namespace TrenchBroom {
 
         class Quake2ValveFileSerializer : public Quake2FileSerializer {
         public:
-            explicit Quake2ValveFileSerializer(FILE* stream) :
-            Quake2FileSerializer(stream) {}
+            Quake2ValveFileSerializer() :
+            Quake2FileSerializer() {}
         private:
-            size_t doWriteBrushFace(FILE* stream, const Model::BrushFace& face) override {
-                writeFacePoints(stream, face);
-                writeValveTextureInfo(stream, face);
-                writeSurfaceAttributes(stream, face);
+            void doWriteBrushFace(std::string& buffer, const Model::BrushFace& face) const override {
+                writeFacePoints(buffer, face);
+                writeValveTextureInfo(buffer, face);
+                writeSurfaceAttributes(buffer, face);
 
-                std::fprintf(stream, "\n");
-                return 1;
+                buffer.push_back('\n');
             }
         };
 
         class DaikatanaFileSerializer : public Quake2FileSerializer {
-        private:
-            std::string SurfaceColorFormat;
         public:
-            explicit DaikatanaFileSerializer(FILE* stream) :
-            Quake2FileSerializer(stream),
-            SurfaceColorFormat(" %d %d %d") {}
+            DaikatanaFileSerializer() :
+            Quake2FileSerializer() {}
         private:
-            size_t doWriteBrushFace(FILE* stream, const Model::BrushFace& face) override {
-                writeFacePoints(stream, face);
-                writeTextureInfo(stream, face);
+            void doWriteBrushFace(std::string& buffer, const Model::BrushFace& face) const override {
+                writeFacePoints(buffer, face);
+                writeTextureInfo(buffer, face);
 
                 if (face.attributes().hasSurfaceAttributes() || face.attributes().hasColor()) {
-                    writeSurfaceAttributes(stream, face);
+                    writeSurfaceAttributes(buffer, face);
                 }
                 if (face.attributes().hasColor()) {
-                    writeSurfaceColor(stream, face);
+                    writeSurfaceColor(buffer, face);
                 }
 
-                std::fprintf(stream, "\n");
-                return 1;
+                buffer.push_back('\n');
             }
         protected:
-            void writeSurfaceColor(FILE* stream, const Model::BrushFace& face) {
-                std::fprintf(stream, SurfaceColorFormat.c_str(),
+            void writeSurfaceColor(std::string& buffer, const Model::BrushFace& face) const {
+                appendFormat(buffer, " %d %d %d",
                              static_cast<int>(face.attributes().color().r()),
                              static_cast<int>(face.attributes().color().g()),
                              static_cast<int>(face.attributes().color().b()));
@@ -191,102 +195,129 @@ namespace TrenchBroom {
 
         class Hexen2FileSerializer : public QuakeFileSerializer {
         public:
-            explicit Hexen2FileSerializer(FILE* stream):
-            QuakeFileSerializer(stream) {}
+            Hexen2FileSerializer() :
+            QuakeFileSerializer() {}
         private:
-            size_t doWriteBrushFace(FILE* stream, const Model::BrushFace& face) override {
-                writeFacePoints(stream, face);
-                writeTextureInfo(stream, face);
-                std::fprintf(stream, " 0\n"); // extra value written here
-                return 1;
+            void doWriteBrushFace(std::string& buffer, const Model::BrushFace& face) const override {
+                writeFacePoints(buffer, face);
+                writeTextureInfo(buffer, face);
+                buffer.append(" 0\n"); // extra value written here
             }
         };
 
         class ValveFileSerializer : public QuakeFileSerializer {
         public:
-            explicit ValveFileSerializer(FILE* stream) :
-            QuakeFileSerializer(stream) {}
+            ValveFileSerializer() :
+            QuakeFileSerializer() {}
         private:
-            size_t doWriteBrushFace(FILE* stream, const Model::BrushFace& face) override {
-                writeFacePoints(stream, face);
-                writeValveTextureInfo(stream, face);
-                std::fprintf(stream, "\n");
-                return 1;
+            void doWriteBrushFace(std::string& buffer, const Model::BrushFace& face) const override {
+                writeFacePoints(buffer, face);
+                writeValveTextureInfo(buffer, face);
+                buffer.push_back('\n');
             }
         };
 
         std::unique_ptr<NodeSerializer> MapFileSerializer::create(const Model::MapFormat format, FILE* stream) {
+            ensure(stream != nullptr, "stream is null");
+
+            auto serializer = create(format);
+            serializer->m_stream = stream;
+            return serializer;
+        }
+
+        std::unique_ptr<NodeSerializer> MapFileSerializer::create(const Model::MapFormat format, std::string& output) {
+            auto serializer = create(format);
+            serializer->m_output = &output;
+            return serializer;
+        }
+
+        std::unique_ptr<MapFileSerializer> MapFileSerializer::create(const Model::MapFormat format) {
             switch (format) {
                 case Model::MapFormat::Standard:
-                    return std::make_unique<QuakeFileSerializer>(stream);
+                    return std::make_unique<QuakeFileSerializer>();
                 case Model::MapFormat::Quake2:
                     // TODO 2427: Implement Quake3 serializers and use them
                 case Model::MapFormat::Quake3:
                 case Model::MapFormat::Quake3_Legacy:
-                    return std::make_unique<Quake2FileSerializer>(stream);
+                    return std::make_unique<Quake2FileSerializer>();
                 case Model::MapFormat::Quake2_Valve:
                 case Model::MapFormat::Quake3_Valve:
-                    return std::make_unique<Quake2ValveFileSerializer>(stream);
+                    return std::make_unique<Quake2ValveFileSerializer>();
                 case Model::MapFormat::Daikatana:
-                    return std::make_unique<DaikatanaFileSerializer>(stream);
+                    return std::make_unique<DaikatanaFileSerializer>();
                 case Model::MapFormat::Valve:
-                    return std::make_unique<ValveFileSerializer>(stream);
+                    return std::make_unique<ValveFileSerializer>();
                 case Model::MapFormat::Hexen2:
-                    return std::make_unique<Hexen2FileSerializer>(stream);
+                    return std::make_unique<Hexen2FileSerializer>();
                 case Model::MapFormat::Unknown:
                     throw FileFormatException("Unknown map file format");
                 switchDefault()
             }
         }
 
-        MapFileSerializer::MapFileSerializer(FILE* stream) :
+        MapFileSerializer::MapFileSerializer() :
         m_line(1),
-        m_stream(stream) {
-            ensure(m_stream != nullptr, "stream is null");
-        }
+        m_stream(nullptr),
+        m_output(nullptr),
+        m_segmentCount(0) {}
 
         void MapFileSerializer::doBeginFile() {}
-        void MapFileSerializer::doEndFile() {}
+
+        void MapFileSerializer::doEndFile() {
+            flush();
+        }
 
         void MapFileSerializer::doBeginEntity(const Model::Node* /* node */) {
-            std::fprintf(m_stream, "// entity %u\n", entityNo());
+            auto& str = text();
+            str.append("// entity ");
+            str.append(std::to_string(entityNo()));
+            str.append("\n");
             ++m_line;
             m_startLineStack.push_back(m_line);
-            std::fprintf(m_stream, "{\n");
+            str.append("{\n");
             ++m_line;
         }
 
         void MapFileSerializer::doEndEntity(const Model::Node* node) {
-            std::fprintf(m_stream, "}\n");
+            text().append("}\n");
             ++m_line;
             setFilePosition(node);
         }
 
         void MapFileSerializer::doEntityAttribute(const Model::EntityAttribute& attribute) {
-            std::fprintf(m_stream, "\"%s\" \"%s\"\n",
-                         escapeEntityAttribute( attribute.name()).c_str(),
-                         escapeEntityAttribute(attribute.value()).c_str());
+            auto& str = text();
+            str.push_back('"');
+            str.append(escapeEntityAttribute(attribute.name()));
+            str.append("\" \"");
+            str.append(escapeEntityAttribute(attribute.value()));
+            str.append("\"\n");
             ++m_line;
         }
 
         void MapFileSerializer::doBeginBrush(const Model::BrushNode* /* brush */) {
-            std::fprintf(m_stream, "// brush %u\n", brushNo());
+            auto& str = text();
+            str.append("// brush ");
+            str.append(std::to_string(brushNo()));
+            str.append("\n");
             ++m_line;
             m_startLineStack.push_back(m_line);
-            std::fprintf(m_stream, "{\n");
+            str.append("{\n");
             ++m_line;
         }
 
         void MapFileSerializer::doEndBrush(const Model::BrushNode* brush) {
-            std::fprintf(m_stream, "}\n");
+            text().append("}\n");
             ++m_line;
             setFilePosition(brush);
         }
 
         void MapFileSerializer::doBrushFace(const Model::BrushFace& face) {
-            const size_t lines = doWriteBrushFace(m_stream, face);
-            face.setFilePosition(m_line, lines);
-            m_line += lines;
+            auto* segment = m_segmentCount > 0u ? &m_segments[m_segmentCount - 1u] : &startSegment();
+            segment->faces.push_back(&face);
+
+            // every face is written on a single line
+            face.setFilePosition(m_line, 1u);
+            ++m_line;
         }
 
         void MapFileSerializer::setFilePosition(const Model::Node* node) {
@@ -300,5 +331,60 @@ namespace TrenchBroom {
             m_startLineStack.pop_back();
             return result;
         }
+
+        std::string& MapFileSerializer::text() {
+            if (m_segmentCount == 0u || !m_segments[m_segmentCount - 1u].faces.empty()) {
+                return startSegment().text;
+            }
+            return m_segments[m_segmentCount - 1u].text;
+        }
+
+        MapFileSerializer::Segment& MapFileSerializer::startSegment() {
+            if (m_segmentCount == MaxPendingSegments) {
+                flush();
+            }
+
+            if (m_segmentCount == m_segments.size()) {
+                m_segments.emplace_back();
+            }
+
+            // segments are reused to avoid reallocating their buffers
+            auto& segment = m_segments[m_segmentCount++];
+            segment.text.clear();
+            segment.faces.clear();
+            segment.faceText.clear();
+            return segment;
+        }
+
+        void MapFileSerializer::flush() {
+            kdl::parallel_for(m_segmentCount, [&](const size_t i) {
+                auto& segment = m_segments[i];
+                for (const auto* face : segment.faces) {
+                    doWriteBrushFace(segment.faceText, *face);
+                }
+            });
+
+            size_t size = 0u;
+            for (size_t i = 0u; i < m_segmentCount; ++i) {
+                size += m_segments[i].text.size() + m_segments[i].faceText.size();
+            }
+
+            m_buffer.clear();
+            m_buffer.reserve(size);
+            for (size_t i = 0u; i < m_segmentCount; ++i) {
+                m_buffer.append(m_segments[i].text);
+                m_buffer.append(m_segments[i].faceText);
+            }
+            m_segmentCount = 0u;
+
+            if (m_output != nullptr) {
+                m_output->append(m_buffer);
+            } else if (!m_buffer.empty()) {
+                const auto written = std::fwrite(m_buffer.data(), 1u, m_buffer.size(), m_stream);
+                if (written != m_buffer.size()) {
+                    throw FileSystemException("Could not write map file: wrote " + std::to_string(written) + " of " + std::to_string(m_buffer.size()) + " bytes");
+                }
+            }
+        }
     }
 }
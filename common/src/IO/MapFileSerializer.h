@@ -25,6 +25,7 @@
 
 #include <cstdio> // for FILE*
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace TrenchBroom {
@@ -36,16 +37,44 @@ namespace TrenchBroom {
     }
 
     namespace IO {
+        /**
+         * Serializes nodes into a map file or into a string.
+         *
+         * The output is collected in memory and written to the file (or appended to the string) in bulk when the
+         * file ends (or when too much output is pending). Brush faces are not formatted when they are visited, instead, they are recorded and
+         * formatted in parallel before the pending output is written. The output is concatenated in the order in
+         * which the nodes were visited.
+         */
         class MapFileSerializer : public NodeSerializer {
         private:
+            /**
+             * A piece of the output: some text followed by a run of brush faces. The faces are formatted into
+             * faceText before the segment is written.
+             */
+            struct Segment {
+                std::string text;
+                std::vector<const Model::BrushFace*> faces;
+                std::string faceText;
+            };
+
+            static const size_t MaxPendingSegments = 16384;
+
             using LineStack = std::vector<size_t>;
             LineStack m_startLineStack;
             size_t m_line;
             FILE* m_stream;
+            std::string* m_output;
+
+            std::vector<Segment> m_segments;
+            size_t m_segmentCount;
+            std::string m_buffer;
         public:
             static std::unique_ptr<NodeSerializer> create(Model::MapFormat format, FILE* stream);
+            static std::unique_ptr<NodeSerializer> create(Model::MapFormat format, std::string& output);
         protected:
-            explicit MapFileSerializer(FILE* file);
+            MapFileSerializer();
+        private:
+            static std::unique_ptr<MapFileSerializer> create(Model::MapFormat format);
         private:
             void doBeginFile() override;
             void doEndFile() override;
@@ -59,8 +88,16 @@ namespace TrenchBroom {
         private:
             void setFilePosition(const Model::Node* node);
             size_t startLine();
+
+            std::string& text();
+            Segment& startSegment();
+            void flush();
         private:
-            virtual size_t doWriteBrushFace(FILE* stream, const Model::BrushFace& face) = 0;
+            /**
+             * Appends exactly one line (including the terminating newline) describing the given face to the given
+             * buffer. This is called concurrently for different faces and must not modify any state.
+             */
+            virtual void doWriteBrushFace(std::string& buffer, const Model::BrushFace& face) const = 0;
         };
     }
 }
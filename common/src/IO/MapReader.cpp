@@ -33,6 +33,7 @@
 
 #include <kdl/map_utils.h>
 #include <kdl/overload.h>
+#include <kdl/parallel.h>
 #include <kdl/result.h>
 #include <kdl/string_format.h>
 #include <kdl/string_utils.h>
@@ -72,23 +73,28 @@ namespace TrenchBroom {
         StandardMapParser(begin, end),
         m_factory(nullptr),
         m_brushParent(nullptr),
-        m_currentNode(nullptr) {}
+        m_currentNode(nullptr),
+        m_inBrush(false) {}
 
         MapReader::MapReader(const std::string& str) :
         StandardMapParser(str),
         m_factory(nullptr),
         m_brushParent(nullptr),
-        m_currentNode(nullptr) {}
+        m_currentNode(nullptr),
+        m_inBrush(false) {}
 
         void MapReader::readEntities(Model::MapFormat format, const vm::bbox3& worldBounds, ParserStatus& status) {
             m_worldBounds = worldBounds;
+            clearBrushes();
             parseEntities(format, status);
             resolveNodes(status);
         }
 
         void MapReader::readBrushes(Model::MapFormat format, const vm::bbox3& worldBounds, ParserStatus& status) {
             m_worldBounds = worldBounds;
+            clearBrushes();
             parseBrushes(format, status);
+            createBrushes(status);
         }
 
         void MapReader::readBrushFaces(Model::MapFormat format, const vm::bbox3& worldBounds, ParserStatus& status) {
@@ -119,6 +125,8 @@ namespace TrenchBroom {
         }
 
         void MapReader::onEndEntity(const size_t startLine, const size_t lineCount, ParserStatus& status) {
+            createBrushes(status);
+
             if (m_currentNode != nullptr)
                 setFilePosition(m_currentNode, startLine, lineCount);
             else
@@ -129,10 +137,13 @@ namespace TrenchBroom {
 
         void MapReader::onBeginBrush(const size_t /* line */, ParserStatus& /* status */) {
             assert(m_faces.empty());
+            assert(m_faceErrors.empty());
+            m_inBrush = true;
         }
 
         void MapReader::onEndBrush(const size_t startLine, const size_t lineCount, const ExtraAttributes& extraAttributes, ParserStatus& status) {
             createBrush(startLine, lineCount, extraAttributes, status);
+            m_inBrush = false;
         }
 
         void MapReader::onBrushFace(const size_t line, const vm::vec3& point1, const vm::vec3& point2, const vm::vec3& point3, const Model::BrushFaceAttributes& attribs, const vm::vec3& texAxisX, const vm::vec3& texAxisY, ParserStatus& status) {
@@ -143,7 +154,13 @@ namespace TrenchBroom {
                         onBrushFace(std::move(face), status);
                     },
                     [&](const Model::BrushError e) {
-                        status.error(line, kdl::str_to_string("Skipping face: ", e));
+                        auto msg = kdl::str_to_string("Skipping face: ", e);
+                        if (m_inBrush) {
+                            // report this error together with the brush so that the messages remain in file order
+                            m_faceErrors.emplace_back(line, std::move(msg));
+                        } else {
+                            status.error(line, msg);
+                        }
                     },
                 });
         }
@@ -243,25 +260,61 @@ namespace TrenchBroom {
             m_brushParent = entity;
         }
 
-        void MapReader::createBrush(const size_t startLine, const size_t lineCount, const ExtraAttributes& extraAttributes, ParserStatus& status) {
-            Model::Brush::create(m_worldBounds, std::move(m_faces))
-                .and_then(
+        /**
+         * Only records the brush; its geometry is built later on by createBrushes.
+         */
+        void MapReader::createBrush(const size_t startLine, const size_t lineCount, const ExtraAttributes& extraAttributes, ParserStatus& /* status */) {
+            m_brushInfos.push_back(BrushInfo{m_brushParent, std::move(m_faces), std::move(m_faceErrors), startLine, lineCount, extraAttributes});
+            m_faces.clear();
+            m_faceErrors.clear();
+        }
+
+        /**
+         * Builds the geometry of all recorded brushes in parallel and then creates the brush nodes in file order.
+         *
+         * This is called at the end of every entity so that the brushes are added to their parents in the same
+         * order as if they had been created immediately. Errors are also reported in file order.
+         */
+        void MapReader::createBrushes(ParserStatus& status) {
+            // spawning worker threads isn't worth it for the few brushes of a typical brush entity
+            static const size_t MinBrushCountForParallelCreation = 64u;
+
+            if (m_brushInfos.empty()) {
+                return;
+            }
+
+            const auto numThreads = m_brushInfos.size() < MinBrushCountForParallelCreation ? 1u : kdl::parallel_thread_count();
+            auto brushes = kdl::vec_parallel_transform(std::move(m_brushInfos), [&](BrushInfo&& info) {
+                auto brush = Model::Brush::create(m_worldBounds, std::move(info.faces));
+                return std::make_pair(std::move(info), std::move(brush));
+            }, numThreads);
+            m_brushInfos.clear();
+
+            for (auto& [info, brush] : brushes) {
+                for (const auto& [line, msg] : info.faceErrors) {
+                    status.error(line, msg);
+                }
+
+                std::move(brush).visit(kdl::overload {
                     [&](Model::Brush&& b) {
                         Model::BrushNode* brushNode = m_factory->createBrush(std::move(b));
-                        setFilePosition(brushNode, startLine, lineCount);
-                        setExtraAttributes(brushNode, extraAttributes);
-                        
-                        onBrush(m_brushParent, brushNode, status);
-                        m_faces.clear();
-                        
-                        return kdl::void_result;
-                    }
-                ).handle_errors(
+                        setFilePosition(brushNode, info.startLine, info.lineCount);
+                        setExtraAttributes(brushNode, info.extraAttributes);
+
+                        onBrush(info.parent, brushNode, status);
+                    },
                     [&](const Model::BrushError e) {
-                        status.error(startLine, kdl::str_to_string("Skipping brush: ", e));
-                        m_faces.clear();
+                        status.error(info.startLine, kdl::str_to_string("Skipping brush: ", e));
                     }
-                );
+                });
+            }
+        }
+
+        void MapReader::clearBrushes() {
+            m_inBrush = false;
+            m_faces.clear();
+            m_faceErrors.clear();
+            m_brushInfos.clear();
         }
 
         MapReader::ParentInfo::Type MapReader::storeNode(Model::Node* node, const std::vector<Model::EntityAttribute>& attributes, ParserStatus& status) {
@@ -82,12 +82,29 @@ namespace TrenchBroom {
             using NodeParentPair = std::pair<Model::Node*, ParentInfo>;
             using NodeParentList = std::vector<NodeParentPair>;
 
+            using LineMessage = std::pair<size_t, std::string>;
+
+            /**
+             * A brush whose faces have been parsed, but whose geometry has not been built yet.
+             */
+            struct BrushInfo {
+                Model::Node* parent;
+                std::vector<Model::BrushFace> faces;
+                std::vector<LineMessage> faceErrors;
+                size_t startLine;
+                size_t lineCount;
+                ExtraAttributes extraAttributes;
+            };
+
             vm::bbox3 m_worldBounds;
             Model::ModelFactory* m_factory;
 
             Model::Node* m_brushParent;
             Model::Node* m_currentNode;
+            bool m_inBrush;
             std::vector<Model::BrushFace> m_faces;
+            std::vector<LineMessage> m_faceErrors;
+            std::vector<BrushInfo> m_brushInfos;
 
             LayerMap m_layers;
             GroupMap m_groups;
@@ -111,6 +128,8 @@ namespace TrenchBroom {
             void createGroup(size_t line, const std::vector<Model::EntityAttribute>& attributes, const ExtraAttributes& extraAttributes, ParserStatus& status);
             void createEntity(size_t line, const std::vector<Model::EntityAttribute>& attributes, const ExtraAttributes& extraAttributes, ParserStatus& status);
             void createBrush(size_t startLine, size_t lineCount, const ExtraAttributes& extraAttributes, ParserStatus& status);
+            void createBrushes(ParserStatus& status);
+            void clearBrushes();
 
             ParentInfo::Type storeNode(Model::Node* node, const std::vector<Model::EntityAttribute>& attributes, ParserStatus& status);
             void stripParentAttributes(Model::AttributableNode* attributable, ParentInfo::Type parentType);
@@ -108,6 +108,10 @@ namespace TrenchBroom {
         m_world(world),
         m_serializer(MapStreamSerializer::create(m_world.format(), stream)) {}
 
+        NodeWriter::NodeWriter(const Model::WorldNode& world, std::string& output) :
+        m_world(world),
+        m_serializer(MapFileSerializer::create(m_world.format(), output)) {}
+
         NodeWriter::NodeWriter(const Model::WorldNode& world, NodeSerializer* serializer) :
         m_world(world),
         m_serializer(serializer) {}
@@ -25,6 +25,7 @@
 #include <cstdio> // FILE*
 #include <map>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace TrenchBroom {
@@ -49,6 +50,7 @@ namespace TrenchBroom {
         public:
             NodeWriter(const Model::WorldNode& world, FILE* stream);
             NodeWriter(const Model::WorldNode& world, std::ostream& stream);
+            NodeWriter(const Model::WorldNode& world, std::string& output);
             NodeWriter(const Model::WorldNode& world, NodeSerializer* serializer);
 
             void writeMap();
@@ -19,6 +19,7 @@
 
 #include "Quake3ShaderFileSystem.h"
 
+#include "BufferedLogger.h"
 #include "Logger.h"
 #include "Assets/Quake3Shader.h"
 #include "IO/File.h"
@@ -26,10 +27,14 @@
 #include "IO/Quake3ShaderParser.h"
 #include "IO/SimpleParserStatus.h"
 
+#include <kdl/parallel.h>
 #include <kdl/vector_utils.h>
 
+#include <chrono>
+#include <iterator>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom {
@@ -42,6 +47,11 @@ namespace TrenchBroom {
             initialize();
         }
 
+        static long long elapsedMilliseconds(const std::chrono::steady_clock::time_point& start) {
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+            return std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+        }
+
         void Quake3ShaderFileSystem::doReadDirectory() {
             if (hasNext()) {
                 auto shaders = loadShaders();
@@ -50,63 +60,85 @@ namespace TrenchBroom {
         }
 
         std::vector<Assets::Quake3Shader> Quake3ShaderFileSystem::loadShaders() const {
+            const auto start = std::chrono::steady_clock::now();
             auto result = std::vector<Assets::Quake3Shader>();
 
             if (next().directoryExists(m_shaderSearchPath)) {
-                const auto paths = next().findItems(m_shaderSearchPath, FileExtensionMatcher("shader"));
-                for (const auto& path : paths) {
+                auto paths = next().findItems(m_shaderSearchPath, FileExtensionMatcher("shader"));
+
+                // the shader files are parsed on worker threads, so their messages are collected and logged afterwards
+                BufferedLogger bufferedLogger(m_logger);
+                auto shadersPerFile = kdl::vec_parallel_transform(std::move(paths), [&](const Path& path) {
                     const auto file = next().openFile(path);
                     auto bufferedReader = file->reader().buffer();
 
                     try {
                         Quake3ShaderParser parser(std::begin(bufferedReader), std::end(bufferedReader));
-                        SimpleParserStatus status(m_logger, file->path().asString());
-                        kdl::vec_append(result, parser.parse(status));
+                        SimpleParserStatus status(bufferedLogger, file->path().asString());
+                        return parser.parse(status);
                     } catch (const ParserException& e) {
-                        m_logger.warn() << "Skipping malformed shader file " << path << ": " << e.what();
+                        bufferedLogger.warn() << "Skipping malformed shader file " << path << ": " << e.what();
+                        return std::vector<Assets::Quake3Shader>();
                     }
+                });
+
+                // concatenate in the order of the files so that the result does not depend on the scheduling
+                for (auto& shaders : shadersPerFile) {
+                    kdl::vec_append(result, std::move(shaders));
                 }
             }
 
-            m_logger.info() << "Loaded " << result.size() << " shaders";
+            m_logger.info() << "Loaded " << result.size() << " shaders in " << elapsedMilliseconds(start) << "ms";
             return result;
         }
 
         void Quake3ShaderFileSystem::linkShaders(std::vector<Assets::Quake3Shader>& shaders) {
             const auto extensions = std::vector<std::string> { "tga", "png", "jpg", "jpeg" };
 
+            const auto scanStart = std::chrono::steady_clock::now();
             auto allImages = std::vector<Path>();
             for (const auto& path : m_textureSearchPaths) {
                 if (next().directoryExists(path)) {
                     kdl::vec_append(allImages, next().findItemsRecursively(path, FileExtensionMatcher(extensions)));
                 }
             }
+            m_logger.debug() << "Found " << allImages.size() << " texture images in " << elapsedMilliseconds(scanStart) << "ms";
 
             m_logger.info() << "Linking shaders...";
+            const auto linkStart = std::chrono::steady_clock::now();
             linkTextures(allImages, shaders);
             linkStandaloneShaders(shaders);
+            m_logger.info() << "Linked shaders in " << elapsedMilliseconds(linkStart) << "ms";
         }
 
         void Quake3ShaderFileSystem::linkTextures(const std::vector<Path>& textures, std::vector<Assets::Quake3Shader>& shaders) {
             m_logger.debug() << "Linking textures...";
+
+            // Index the shaders by their path so that every texture can be matched with a single lookup. If several
+            // shaders have the same path, the first one wins.
+            auto shaderIndices = std::unordered_map<std::string, size_t>();
+            shaderIndices.reserve(shaders.size());
+            for (size_t i = 0; i < shaders.size(); ++i) {
+                shaderIndices.emplace(shaders[i].shaderPath.asString(), i);
+            }
+
+            auto linked = std::vector<bool>(shaders.size(), false);
             for (const auto& texture : textures) {
                 const auto shaderPath = texture.deleteExtension();
 
                 // Only link a shader if it has not been linked yet.
                 if (!fileExists(shaderPath)) {
-                    const auto shaderIt = std::find_if(std::begin(shaders), std::end(shaders), [&shaderPath](const auto& shader){
-                        return shaderPath == shader.shaderPath;
-                    });
+                    const auto shaderIt = shaderIndices.find(shaderPath.asString());
 
-                    if (shaderIt != std::end(shaders)) {
+                    if (shaderIt != std::end(shaderIndices)) {
                         // Found a matching shader.
-                        auto& shader = *shaderIt;
+                        auto& shader = shaders[shaderIt->second];
 
                         auto shaderFile = std::make_shared<ObjectFile<Assets::Quake3Shader>>(shaderPath, shader);
                         m_root.addFile(shaderPath, shaderFile);
 
-                        // Remove the shader so that we don't revisit it when linking standalone shaders.
-                        shaders.erase(shaderIt);
+                        // Mark the shader so that we don't revisit it when linking standalone shaders.
+                        linked[shaderIt->second] = true;
                     } else {
                         // No matching shader found, generate one.
                         auto shader = Assets::Quake3Shader();
@@ -118,6 +150,18 @@ namespace TrenchBroom {
                     }
                 }
             }
+
+            // Remove the linked shaders so that we don't revisit them when linking standalone shaders.
+            size_t remaining = 0;
+            for (size_t i = 0; i < shaders.size(); ++i) {
+                if (!linked[i]) {
+                    if (remaining != i) {
+                        shaders[remaining] = std::move(shaders[i]);
+                    }
+                    ++remaining;
+                }
+            }
+            shaders.erase(std::next(std::begin(shaders), static_cast<std::ptrdiff_t>(remaining)), std::end(shaders));
         }
 
         void Quake3ShaderFileSystem::linkStandaloneShaders(std::vector<Assets::Quake3Shader>& shaders) {
@@ -19,11 +19,8 @@
 
 #include "Reader.h"
 
-#include "IO/IOUtils.h"
 #include "IO/ReaderException.h"
 
-#include <cassert>
-#include <cerrno>
 #include <cstring>
 #include <functional>
 #include <string>
@@ -70,78 +67,6 @@ namespace TrenchBroom {
             return doBuffer();
         }
 
-        Reader::FileSource::FileSource(std::FILE* file, const size_t offset, const size_t length) :
-        m_file(file),
-        m_offset(offset),
-        m_length(length),
-        m_position(0) {
-            assert(m_file != nullptr);
-            std::rewind(m_file);
-        }
-
-
-        size_t Reader::FileSource::doGetSize() const {
-            return m_length;
-        }
-
-        size_t Reader::FileSource::doGetPosition() const {
-            return m_position;
-        }
-
-        void Reader::FileSource::doRead(char* val, const size_t size) {
-            // We might consider removing this check under the assumption that the file position is set in the constructor
-            // of this reader and that no other reader will access the file while this reader is in use. This may be a
-            // reasonable assumption, since we usually read files one by one.
-
-            const auto pos = std::ftell(m_file);
-            if (pos < 0) {
-                throwError("ftell failed");
-            }
-            if (static_cast<size_t>(pos) != m_offset + m_position) {
-                if (std::fseek(m_file, static_cast<long>(m_offset + m_position), SEEK_SET) != 0) {
-                    throwError("fseek failed");
-                }
-            }
-            if (std::fread(val, 1, size, m_file) != size) {
-                throwError("fread failed");
-            }
-            m_position += size;
-        }
-
-        void Reader::FileSource::doSeek(const size_t position) {
-            m_position = position;
-        }
-
-        std::unique_ptr<Reader::Source> Reader::FileSource::doGetSubSource(const size_t position, const size_t length) const {
-            return std::make_unique<FileSource>(m_file, m_offset + position, length);
-        }
-
-        std::tuple<const char*, const char*, std::unique_ptr<char[]>> Reader::FileSource::doBuffer() const {
-            std::fseek(m_file, static_cast<long>(m_offset), SEEK_SET);
-
-            auto buffer = std::make_unique<char[]>(m_length);
-            const auto read = std::fread(buffer.get(), 1, m_length, m_file);
-            if (read != m_length) {
-                throwError("fread failed");
-            }
-
-            if (std::fseek(m_file, static_cast<long>(m_offset + m_position), SEEK_SET) != 0) {
-                throwError("fseek failed");
-            }
-
-            const char* begin = buffer.get();
-            const char* end = begin + m_length;
-            return std::make_tuple(begin, end, std::move(buffer));
-        }
-
-        void Reader::FileSource::throwError(const std::string& msg) const {
-            if (std::feof(m_file)) {
-                throw ReaderException(msg + ": unexpected end of file");
-            } else {
-                throw ReaderException(msg + ": " + std::strerror(errno));
-            }
-        }
-
         Reader::BufferSource::BufferSource(const char* begin, const char* end) :
         m_begin(begin),
         m_end(end),
@@ -189,10 +114,6 @@ namespace TrenchBroom {
 
         Reader::~Reader() = default;
 
-        Reader Reader::from(std::FILE* file) {
-            return Reader(std::make_unique<FileSource>(file, 0, fileSize(file)));
-        }
-
         Reader Reader::from(const char* begin, const char* end) {
             return Reader(std::make_unique<BufferSource>(begin, end));
         }
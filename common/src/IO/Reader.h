@@ -22,7 +22,6 @@
 
 #include <vecmath/vec.h>
 
-#include <cstdio>
 #include <memory>
 #include <string>
 
@@ -32,7 +31,7 @@ namespace TrenchBroom {
 
         /**
          * Accesses information from a stream of binary data. The underlying stream is represented by a source, which
-         * can either be a file or a memory region. Allows reading and converting data of various types for easier use.
+         * is a memory region. Allows reading and converting data of various types for easier use.
          */
         class Reader {
         private:
@@ -120,36 +119,6 @@ namespace TrenchBroom {
                 virtual std::tuple<const char*, const char*, std::unique_ptr<char[]>> doBuffer() const = 0;
             };
 
-            /**
-             * A reader source that reads directly from a file. Note that the seek position of the underlying C file
-             * is kept in sync with this file source's position automatically, that is, two readers can read from the
-             * same underlying file without causing problems.
-             */
-            class FileSource : public Source {
-            private:
-                std::FILE* m_file;
-                size_t m_offset;
-                size_t m_length;
-                size_t m_position;
-            public:
-                /**
-                 * Creates a new reader source for the given underlying file at the given offset and length.
-                 *
-                 * @param file the file
-                 * @param offset the offset into the file at which this reader source should begin
-                 * @param length the length of this reader source
-                 */
-                FileSource(std::FILE* file, size_t offset, size_t length);
-            private:
-                size_t doGetSize() const override;
-                size_t doGetPosition() const override;
-                void doRead(char* val, size_t size) override;
-                void doSeek(size_t position) override;
-                std::unique_ptr<Source> doGetSubSource(size_t position, size_t length) const override;
-                std::tuple<const char*, const char*, std::unique_ptr<char[]>> doBuffer() const override;
-            private:
-                [[noreturn]] void throwError(const std::string& msg) const;
-            };
         protected:
             /**
              * A reader source that reads from a memory region. Does not take ownership of the memory region and will
@@ -202,15 +171,6 @@ namespace TrenchBroom {
         public:
             virtual ~Reader();
         public:
-            /**
-             * Creates a new reader that reads from the given file.
-             *
-             * @param file the file to read from
-             * @return the reader
-             *
-             * @throw ReaderException if the reader cannot be created
-             */
-            static Reader from(std::FILE* file);
             /**
              * Creates a new reader that reads from the given memory region.
              *
@@ -93,6 +93,9 @@ namespace TrenchBroom {
         TextureCollectionLoader::FileList DirectoryTextureCollectionLoader::doFindTextures(const Path& path, const std::vector<std::string>& extensions) {
             const auto texturePaths = m_gameFS.findItems(path, FileExtensionMatcher(extensions));
 
+            // textures in archives are decompressed in parallel before they are opened one by one
+            m_gameFS.prefetch(texturePaths);
+
             FileList result;
             result.reserve(texturePaths.size());
 
@@ -23,7 +23,6 @@
 #include "Logger.h"
 #include "Assets/Palette.h"
 #include "Assets/TextureCollection.h"
-#include "Assets/TextureManager.h"
 #include "IO/FileSystem.h"
 #include "IO/FreeImageTextureReader.h"
 #include "IO/HlMipTextureReader.h"
@@ -106,9 +105,5 @@ namespace TrenchBroom {
         std::unique_ptr<Assets::TextureCollection> TextureLoader::loadTextureCollection(const Path& path) {
             return m_textureCollectionLoader->loadTextureCollection(path, m_textureExtensions, *m_textureReader);
         }
-
-        void TextureLoader::loadTextures(const std::vector<Path>& paths, Assets::TextureManager& textureManager) {
-            textureManager.setTextureCollections(paths, *this);
-        }
     }
 }
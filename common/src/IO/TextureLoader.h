@@ -32,7 +32,6 @@ namespace TrenchBroom {
     namespace Assets {
         class Palette;
         class TextureCollection;
-        class TextureManager;
     }
 
     namespace Model {
@@ -60,7 +59,6 @@ namespace TrenchBroom {
             static std::unique_ptr<TextureCollectionLoader> createTextureCollectionLoader(const FileSystem& gameFS, const std::vector<Path>& fileSearchPaths, const Model::TextureConfig& textureConfig, Logger& logger);
         public:
             std::unique_ptr<Assets::TextureCollection> loadTextureCollection(const Path& path);
-            void loadTextures(const std::vector<Path>& paths, Assets::TextureManager& textureManager);
 
             deleteCopyAndMove(TextureLoader)
         };
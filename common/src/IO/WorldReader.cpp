@@ -46,6 +46,7 @@ namespace TrenchBroom {
             sanitizeLayerSortIndicies(status);
             m_world->rebuildNodeTree();
             m_world->enableNodeTreeUpdates();
+            m_world->enableAttributableIndexUpdates();
             return std::move(m_world);
         }
 
@@ -93,6 +94,7 @@ namespace TrenchBroom {
         Model::ModelFactory& WorldReader::initialize(const Model::MapFormat format) {
             m_world = std::make_unique<Model::WorldNode>(format);
             m_world->disableNodeTreeUpdates();
+            m_world->disableAttributableIndexUpdates();
             return *m_world;
         }
 
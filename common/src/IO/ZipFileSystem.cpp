@@ -52,6 +52,10 @@ namespace TrenchBroom {
             return std::make_shared<OwningBufferFile>(path, std::move(data), uncompressedSize);
         }
 
+        bool ZipFileSystem::ZipCompressedFile::doIsCompressed() const {
+            return true;
+        }
+
         // ZipFileSystem
 
         ZipFileSystem::ZipFileSystem(const Path& path) :
@@ -69,8 +73,9 @@ namespace TrenchBroom {
         void ZipFileSystem::doReadDirectory() {
             mz_zip_zero_struct(&m_archive);
 
-            if (mz_zip_reader_init_cfile(&m_archive, m_file->file(), m_file->size(), 0) != MZ_TRUE) {
-                throw FileSystemException("Error calling mz_zip_reader_init_cfile");
+            // reading from memory doesn't share a file handle, which allows entries to be extracted concurrently
+            if (mz_zip_reader_init_mem(&m_archive, m_file->begin(), m_file->size(), 0) != MZ_TRUE) {
+                throw FileSystemException("Error calling mz_zip_reader_init_mem");
             }
 
             const mz_uint numFiles = mz_zip_reader_get_num_files(&m_archive);
@@ -42,6 +42,7 @@ namespace TrenchBroom {
                 ZipCompressedFile(ZipFileSystem* owner, mz_uint fileIndex);
             private:
                 std::shared_ptr<File> doOpen() const override;
+                bool doIsCompressed() const override;
             };
             friend class ZipCompressedFile;
         public:
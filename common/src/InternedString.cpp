@@ -0,0 +1,142 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "InternedString.h"
+
+#include <kdl/string_format.h>
+
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace TrenchBroom {
+    struct InternedString::Entry {
+        std::string str;
+        size_t id;
+        const Entry* lower;
+
+        Entry(std::string i_str, const size_t i_id) :
+        str(std::move(i_str)),
+        id(i_id),
+        lower(this) {}
+    };
+
+    struct InternedString::Table {
+        std::mutex mutex;
+        // a deque never moves its elements when it grows at the end, so the index keys and entry pointers remain valid
+        std::deque<Entry> entries;
+        std::unordered_map<std::string_view, const Entry*> index;
+
+        Table() {
+            // the empty string always has ID 0, no matter which string is interned first
+            intern(*this, "");
+        }
+    };
+
+    InternedString::InternedString() :
+    m_entry(emptyEntry()) {}
+
+    InternedString::InternedString(const std::string_view str) :
+    m_entry(intern(str)) {}
+
+    InternedString::InternedString(const std::string& str) :
+    m_entry(intern(str)) {}
+
+    InternedString::InternedString(const char* str) :
+    m_entry(intern(str)) {}
+
+    InternedString::InternedString(const Entry* entry) :
+    m_entry(entry) {}
+
+    const std::string& InternedString::str() const {
+        return m_entry->str;
+    }
+
+    bool InternedString::empty() const {
+        return m_entry->str.empty();
+    }
+
+    size_t InternedString::id() const {
+        return m_entry->id;
+    }
+
+    InternedString InternedString::toLower() const {
+        return InternedString(m_entry->lower);
+    }
+
+    size_t InternedString::count() {
+        auto& t = table();
+        std::lock_guard<std::mutex> lock(t.mutex);
+        return t.entries.size();
+    }
+
+    bool operator==(const InternedString& lhs, const InternedString& rhs) {
+        return lhs.m_entry == rhs.m_entry;
+    }
+
+    bool operator!=(const InternedString& lhs, const InternedString& rhs) {
+        return lhs.m_entry != rhs.m_entry;
+    }
+
+    bool operator<(const InternedString& lhs, const InternedString& rhs) {
+        return lhs.m_entry != rhs.m_entry && lhs.str() < rhs.str();
+    }
+
+    std::ostream& operator<<(std::ostream& str, const InternedString& internedString) {
+        str << internedString.str();
+        return str;
+    }
+
+    InternedString::Table& InternedString::table() {
+        static Table table;
+        return table;
+    }
+
+    const InternedString::Entry* InternedString::emptyEntry() {
+        static const Entry* entry = &table().entries.front();
+        return entry;
+    }
+
+    const InternedString::Entry* InternedString::intern(const std::string_view str) {
+        auto& t = table();
+        std::lock_guard<std::mutex> lock(t.mutex);
+        return intern(t, str);
+    }
+
+    const InternedString::Entry* InternedString::intern(Table& t, const std::string_view str) {
+        const auto it = t.index.find(str);
+        if (it != std::end(t.index)) {
+            return it->second;
+        }
+
+        // intern the lower case version first so that the new entry can refer to it
+        auto lowerStr = kdl::str_to_lower(str);
+        const Entry* lower = lowerStr != str ? intern(t, lowerStr) : nullptr;
+
+        auto& entry = t.entries.emplace_back(std::string(str), t.entries.size());
+        if (lower != nullptr) {
+            entry.lower = lower;
+        }
+        t.index.emplace(std::string_view(entry.str), &entry);
+        return &entry;
+    }
+}
@@ -0,0 +1,100 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRENCHBROOM_INTERNEDSTRING_H
+#define TRENCHBROOM_INTERNEDSTRING_H
+
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+
+namespace TrenchBroom {
+    /**
+     * A handle to a string that is stored in a global, thread safe table. Every distinct string is stored only once,
+     * and all interned strings that are equal share the same handle. Copying and comparing interned strings for
+     * equality is therefore as cheap as copying and comparing a pointer.
+     *
+     * Every interned string has a small, unique ID that can be used as an index into lookup tables. IDs are assigned
+     * in the order in which strings are interned, and the empty string has ID 0. Strings are never removed from the
+     * table, so interned strings and references to their contents remain valid for the lifetime of the program.
+     */
+    class InternedString {
+    private:
+        struct Entry;
+        struct Table;
+        const Entry* m_entry;
+    public:
+        /**
+         * Creates an interned empty string.
+         */
+        InternedString();
+
+        explicit InternedString(std::string_view str);
+        explicit InternedString(const std::string& str);
+        explicit InternedString(const char* str);
+
+        const std::string& str() const;
+        bool empty() const;
+
+        /**
+         * Returns the ID of this string.
+         */
+        size_t id() const;
+
+        /**
+         * Returns the interned lower case version of this string. This is cached and doesn't require another lookup.
+         */
+        InternedString toLower() const;
+
+        /**
+         * Returns the number of strings interned so far. All IDs are less than this number.
+         */
+        static size_t count();
+
+        friend bool operator==(const InternedString& lhs, const InternedString& rhs);
+        friend bool operator!=(const InternedString& lhs, const InternedString& rhs);
+
+        /**
+         * Compares the contents of the given strings lexicographically.
+         */
+        friend bool operator<(const InternedString& lhs, const InternedString& rhs);
+
+        friend std::ostream& operator<<(std::ostream& str, const InternedString& internedString);
+    private:
+        explicit InternedString(const Entry* entry);
+
+        static Table& table();
+        static const Entry* emptyEntry();
+        static const Entry* intern(std::string_view str);
+        static const Entry* intern(Table& table, std::string_view str);
+    };
+}
+
+namespace std {
+    template <>
+    struct hash<TrenchBroom::InternedString> {
+        size_t operator()(const TrenchBroom::InternedString& str) const {
+            return std::hash<size_t>()(str.id());
+        }
+    };
+}
+
+#endif /* TRENCHBROOM_INTERNEDSTRING_H */
@@ -26,6 +26,7 @@
 #include <kdl/collection_utils.h>
 #include <kdl/vector_utils.h>
 
+#include <cassert>
 #include <string>
 #include <vector>
 
@@ -169,7 +170,11 @@ namespace TrenchBroom {
         }
 
         const std::string& AttributableNode::classname(const std::string& defaultClassname) const {
-            return m_classname.empty() ? defaultClassname : m_classname;
+            return m_classname.empty() ? defaultClassname : m_classname.str();
+        }
+
+        const InternedString& AttributableNode::internedClassname() const {
+            return m_classname;
         }
 
         EntityAttributeSnapshot AttributableNode::attributeSnapshot(const std::string& name) const {
@@ -282,7 +287,7 @@ namespace TrenchBroom {
         }
 
         void AttributableNode::updateClassname() {
-            m_classname = attribute(AttributeNames::Classname);
+            m_classname = InternedString(attribute(AttributeNames::Classname));
         }
 
         void AttributableNode::addAttributesToIndex() {
@@ -392,6 +397,14 @@ namespace TrenchBroom {
             return result;
         }
 
+        void AttributableNode::addAllTargetLinks() {
+            assert(m_linkTargets.empty());
+            assert(m_killTargets.empty());
+
+            addAllLinkTargets();
+            addAllKillTargets();
+        }
+
         void AttributableNode::findMissingTargets(const std::string& prefix, std::vector<std::string>& result) const {
             for (const EntityAttribute& attribute : m_attributes.numberedAttributes(prefix)) {
                 const std::string& targetname = attribute.value();
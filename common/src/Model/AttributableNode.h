@@ -20,6 +20,7 @@
 #ifndef TrenchBroom_AttributableNode
 #define TrenchBroom_AttributableNode
 
+#include "InternedString.h"
 #include "Model/EntityAttributes.h"
 #include "Model/Node.h"
 
@@ -53,7 +54,7 @@ namespace TrenchBroom {
             std::vector<AttributableNode*> m_killTargets;
 
             // cache the classname for faster access
-            std::string m_classname;
+            InternedString m_classname;
         public:
             virtual ~AttributableNode() override;
         public: // definition
@@ -78,6 +79,7 @@ namespace TrenchBroom {
 
             const std::string& attribute(const std::string& name, const std::string& defaultValue = DefaultAttributeValue) const;
             const std::string& classname(const std::string& defaultClassname = AttributeValues::NoClassname) const;
+            const InternedString& internedClassname() const;
 
             EntityAttributeSnapshot attributeSnapshot(const std::string& name) const;
 
@@ -128,6 +130,13 @@ namespace TrenchBroom {
             bool hasMissingSources() const;
             std::vector<std::string> findMissingLinkTargets() const;
             std::vector<std::string> findMissingKillTargets() const;
+
+            /**
+             * Links this node to every node whose targetname is referenced by one of this node's target or killtarget
+             * attributes. This is used to establish the links of nodes whose attributes were added to the attributable
+             * node index in bulk, and must only be called if this node does not have any link or kill targets yet.
+             */
+            void addAllTargetLinks();
         private: // link management internals
             void findMissingTargets(const std::string& prefix, std::vector<std::string>& result) const;
 
@@ -26,8 +26,10 @@
 #include <kdl/compact_trie.h>
 #include <kdl/vector_utils.h>
 
-#include <list>
+#include <algorithm>
+#include <iterator>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom {
@@ -48,22 +50,23 @@ namespace TrenchBroom {
             return AttributableNodeIndexQuery(Type_Any);
         }
 
-        std::set<AttributableNode*> AttributableNodeIndexQuery::execute(const AttributableNodeStringIndex& index) const {
-            std::set<AttributableNode*> result;
+        std::vector<AttributableNode*> AttributableNodeIndexQuery::execute(const AttributableNodeStringIndex& index) const {
+            std::vector<AttributableNode*> result;
             switch (m_type) {
                 case Type_Exact:
-                    index.find_matches(m_pattern, std::inserter(result, std::end(result)));
+                    index.find_exact(m_pattern, std::back_inserter(result));
                     break;
                 case Type_Prefix:
-                    index.find_matches(m_pattern + "*", std::inserter(result, std::end(result)));
+                    index.find_prefix(m_pattern, std::back_inserter(result));
                     break;
                 case Type_Numbered:
-                    index.find_matches(m_pattern + "%*", std::inserter(result, std::end(result)));
+                    index.find_matches(m_pattern + "%*", std::back_inserter(result));
                     break;
                 case Type_Any:
                     break;
                 switchDefault()
             }
+            kdl::vec_sort_and_remove_duplicates(result);
             return result;
         }
 
@@ -115,6 +118,35 @@ namespace TrenchBroom {
                 removeAttribute(attributable, attribute.name(), attribute.value());
         }
 
+        void AttributableNodeIndex::addAttributableNodes(const std::vector<AttributableNode*>& attributables) {
+            using Entry = std::pair<const std::string*, AttributableNode*>;
+            const auto compareEntries = [](const Entry& lhs, const Entry& rhs) { return *lhs.first < *rhs.first; };
+
+            std::vector<Entry> names;
+            std::vector<Entry> values;
+            for (auto* attributable : attributables) {
+                for (const EntityAttribute& attribute : attributable->attributes()) {
+                    names.emplace_back(&attribute.name(), attributable);
+                    values.emplace_back(&attribute.value(), attributable);
+                }
+            }
+
+            std::sort(std::begin(names), std::end(names), compareEntries);
+            std::sort(std::begin(values), std::end(values), compareEntries);
+
+            for (const auto& [name, attributable] : names) {
+                m_nameIndex->insert(*name, attributable);
+            }
+            for (const auto& [value, attributable] : values) {
+                m_valueIndex->insert(*value, attributable);
+            }
+        }
+
+        void AttributableNodeIndex::clear() {
+            m_nameIndex->clear();
+            m_valueIndex->clear();
+        }
+
         void AttributableNodeIndex::addAttribute(AttributableNode* attributable, const std::string& name, const std::string& value) {
             m_nameIndex->insert(name, attributable);
             m_valueIndex->insert(value, attributable);
@@ -126,24 +158,16 @@ namespace TrenchBroom {
         }
 
         std::vector<AttributableNode*> AttributableNodeIndex::findAttributableNodes(const AttributableNodeIndexQuery& nameQuery, const std::string& value) const {
-            const std::set<AttributableNode*> nameResult = nameQuery.execute(*m_nameIndex);
+            // Every candidate is checked against the name query anyway, so it suffices to look up the nodes having the
+            // given value. Values such as target names are far more selective than names, and the exact lookup does
+            // not need to allocate any matching state.
+            std::vector<AttributableNode*> result;
+            m_valueIndex->find_exact(value, std::back_inserter(result));
+            kdl::vec_sort_and_remove_duplicates(result);
 
-            std::set<AttributableNode*> valueResult;
-            m_valueIndex->find_matches(value, std::inserter(valueResult, std::end(valueResult)));
-            if (nameResult.empty() || valueResult.empty()) {
-                return {};
-            }
-
-            std::vector<AttributableNode*> result = kdl::set_intersection(nameResult, valueResult);
-
-            auto it = std::begin(result);
-            while (it != std::end(result)) {
-                const AttributableNode* node = *it;
-                if (!nameQuery.execute(node, value))
-                    it = result.erase(it);
-                else
-                    ++it;
-            }
+            result.erase(std::remove_if(std::begin(result), std::end(result), [&](const AttributableNode* node) {
+                return !nameQuery.execute(node, value);
+            }), std::end(result));
 
             return result;
         }
@@ -157,8 +181,8 @@ namespace TrenchBroom {
         std::vector<std::string> AttributableNodeIndex::allValuesForNames(const AttributableNodeIndexQuery& keyQuery) const {
             std::vector<std::string> result;
 
-            const std::set<AttributableNode*> nameResult = keyQuery.execute(*m_nameIndex);
-            for (const auto node : nameResult) {
+            const std::vector<AttributableNode*> nameResult = keyQuery.execute(*m_nameIndex);
+            for (const auto* node : nameResult) {
                 const auto matchingAttributes = keyQuery.execute(node);
                 for (const auto& attribute : matchingAttributes) {
                     result.push_back(attribute.value());
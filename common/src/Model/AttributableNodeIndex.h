@@ -23,7 +23,6 @@
 #include <kdl/compact_trie_forward.h>
 
 #include <memory>
-#include <set>
 #include <string>
 #include <vector>
 
@@ -51,7 +50,10 @@ namespace TrenchBroom {
             static AttributableNodeIndexQuery numbered(const std::string& pattern);
             static AttributableNodeIndexQuery any();
 
-            std::set<AttributableNode*> execute(const AttributableNodeStringIndex& index) const;
+            /**
+             * Returns the nodes in the given index whose keys match this query, sorted and without duplicates.
+             */
+            std::vector<AttributableNode*> execute(const AttributableNodeStringIndex& index) const;
             bool execute(const AttributableNode* node, const std::string& value) const;
             std::vector<Model::EntityAttribute> execute(const AttributableNode* node) const;
         private:
@@ -69,9 +71,22 @@ namespace TrenchBroom {
             void addAttributableNode(AttributableNode* attributable);
             void removeAttributableNode(AttributableNode* attributable);
 
+            /**
+             * Adds the attributes of all of the given nodes to this index at once. The attributes are sorted by name
+             * and value before they are inserted, so that successive insertions follow mostly the same path in the
+             * underlying tries.
+             */
+            void addAttributableNodes(const std::vector<AttributableNode*>& attributables);
+
+            void clear();
+
             void addAttribute(AttributableNode* attributable, const std::string& name, const std::string& value);
             void removeAttribute(AttributableNode* attributable, const std::string& name, const std::string& value);
 
+            /**
+             * Returns the nodes that have an attribute matching the given name query with exactly the given value. The
+             * returned nodes are sorted and contain no duplicates.
+             */
             std::vector<AttributableNode*> findAttributableNodes(const AttributableNodeIndexQuery& keyQuery, const std::string& value) const;
             std::vector<std::string> allNames() const;
             std::vector<std::string> allValuesForNames(const AttributableNodeIndexQuery& keyQuery) const;
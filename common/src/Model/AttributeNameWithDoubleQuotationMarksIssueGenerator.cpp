@@ -66,6 +66,10 @@ namespace TrenchBroom {
                                                               [] (const std::string& value) { return value; }));
         }
 
+        bool AttributeNameWithDoubleQuotationMarksIssueGenerator::doIsThreadSafe() const {
+            return true;
+        }
+
         void AttributeNameWithDoubleQuotationMarksIssueGenerator::doGenerate(AttributableNode* node, IssueList& issues) const {
             for (const EntityAttribute& attribute : node->attributes()) {
                 const std::string& attributeName = attribute.name();
@@ -32,6 +32,7 @@ namespace TrenchBroom {
         public:
             AttributeNameWithDoubleQuotationMarksIssueGenerator();
         private:
+            bool doIsThreadSafe() const override;
             void doGenerate(AttributableNode* node, IssueList& issues) const override;
         };
     }
@@ -66,6 +66,10 @@ namespace TrenchBroom {
                                                               [] (const std::string& value) { return kdl::str_replace_every(value, "\"", "'"); }));
         }
 
+        bool AttributeValueWithDoubleQuotationMarksIssueGenerator::doIsThreadSafe() const {
+            return true;
+        }
+
         void AttributeValueWithDoubleQuotationMarksIssueGenerator::doGenerate(AttributableNode* node, IssueList& issues) const {
             for (const EntityAttribute& attribute : node->attributes()) {
                 const std::string& attributeName = attribute.name();
@@ -32,6 +32,7 @@ namespace TrenchBroom {
         public:
             AttributeValueWithDoubleQuotationMarksIssueGenerator();
         private:
+            bool doIsThreadSafe() const override;
             void doGenerate(AttributableNode* node, IssueList& issues) const override;
         };
     }
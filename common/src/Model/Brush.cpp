@@ -51,18 +51,11 @@
 
 namespace TrenchBroom {
     namespace Model {
-        class Brush::CopyCallback : public BrushGeometry::CopyCallback {
-        public:
-            void faceWasCopied(const BrushFaceGeometry* original, BrushFaceGeometry* copy) const override {
-                copy->setPayload(original->payload());
-            }
-        };
-
         Brush::Brush() {}
 
         Brush::Brush(const Brush& other) :
         m_faces(other.m_faces),
-        m_geometry(other.m_geometry ? std::make_unique<BrushGeometry>(*other.m_geometry, CopyCallback()) : nullptr) {
+        m_geometry(other.m_geometry) {
             if (m_geometry) {
                 for (BrushFaceGeometry* faceGeometry : m_geometry->faces()) {
                     if (const auto faceIndex = faceGeometry->payload()) {
@@ -277,6 +270,18 @@ namespace TrenchBroom {
             return Brush::create(worldBounds, std::move(faces));
         }
 
+        size_t Brush::memorySize() const {
+            // texture names are interned, so they are not owned by the faces
+            size_t result = sizeof(Brush) + m_faces.capacity() * sizeof(BrushFace);
+            if (m_geometry != nullptr && m_geometry.use_count() == 1) {
+                result += sizeof(BrushGeometry);
+                result += m_geometry->vertexCount() * sizeof(BrushVertex);
+                result += m_geometry->edgeCount() * (sizeof(BrushEdge) + 2u * sizeof(BrushHalfEdge));
+                result += m_geometry->faceCount() * sizeof(BrushFaceGeometry);
+            }
+            return result;
+        }
+
         size_t Brush::vertexCount() const {
             ensure(m_geometry != nullptr, "geometry is null");
             return m_geometry->vertexCount();
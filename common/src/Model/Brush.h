@@ -42,8 +42,6 @@ namespace TrenchBroom {
 
         class Brush {
         private:
-            class CopyCallback;
-            
             /**
              * Epsilon value to use when finding a vertex after applying a vertex operation
              */
@@ -53,7 +51,13 @@ namespace TrenchBroom {
             using EdgeList = BrushEdgeList;
         private:
             std::vector<BrushFace> m_faces;
-            std::unique_ptr<BrushGeometry> m_geometry;
+
+            /**
+             * The geometry is never modified once it has been built, so copies of a brush share it instead of
+             * cloning the polyhedron. Only the faces are copied, and they are linked to the shared geometry using the
+             * face indices stored in the face geometries' payloads.
+             */
+            std::shared_ptr<BrushGeometry> m_geometry;
         public:
             Brush();
 
@@ -85,6 +89,12 @@ namespace TrenchBroom {
             const std::vector<BrushFace>& faces() const;
             std::vector<BrushFace>& faces();
 
+            /**
+             * Returns an estimate of the number of bytes of memory held by this brush. The geometry is not counted
+             * while it is shared with other brushes.
+             */
+            size_t memorySize() const;
+
             bool closed() const;
             bool fullySpecified() const;
         public: // clone face attributes from matching faces of other brushes
@@ -168,6 +168,7 @@ namespace TrenchBroom {
             void setGeometry(BrushFaceGeometry* geometry);
 
             size_t lineNumber() const;
+            size_t lineCount() const;
             void setFilePosition(size_t lineNumber, size_t lineCount) const;
 
             bool selected() const;
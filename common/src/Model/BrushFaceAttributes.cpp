@@ -87,7 +87,7 @@ namespace TrenchBroom {
         }
 
         BrushFaceAttributes BrushFaceAttributes::takeSnapshot() const {
-            BrushFaceAttributes result(m_textureName);
+            BrushFaceAttributes result(m_textureName.str());
             result.m_offset = m_offset;
             result.m_scale = m_scale;
             result.m_rotation = m_rotation;
@@ -99,6 +99,10 @@ namespace TrenchBroom {
         }
 
         const std::string& BrushFaceAttributes::textureName() const {
+            return m_textureName.str();
+        }
+
+        const InternedString& BrushFaceAttributes::internedTextureName() const {
             return m_textureName;
         }
 
@@ -163,10 +167,11 @@ namespace TrenchBroom {
         }
         
         bool BrushFaceAttributes::setTextureName(const std::string& textureName) {
-            if (textureName == m_textureName) {
+            const auto internedTextureName = InternedString(textureName);
+            if (internedTextureName == m_textureName) {
                 return false;
             } else {
-                m_textureName = textureName;
+                m_textureName = internedTextureName;
                 return true;
             }
         }
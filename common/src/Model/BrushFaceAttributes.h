@@ -21,6 +21,7 @@
 #define TrenchBroom_BrushFaceAttributes
 
 #include "Color.h"
+#include "InternedString.h"
 
 #include <vecmath/forward.h>
 
@@ -36,7 +37,7 @@ namespace TrenchBroom {
         public:
             static const std::string NoTextureName;
         private:
-            std::string m_textureName;
+            InternedString m_textureName;
 
             vm::vec2f m_offset;
             vm::vec2f m_scale;
@@ -60,6 +61,7 @@ namespace TrenchBroom {
             BrushFaceAttributes takeSnapshot() const;
 
             const std::string& textureName() const;
+            const InternedString& internedTextureName() const;
 
             const vm::vec2f& offset() const;
             float xOffset() const;
@@ -20,37 +20,149 @@
 #include "BrushSnapshot.h"
 
 #include "Exceptions.h"
-#include "Model/BrushError.h"
+#include "IO/Compression.h"
+#include "IO/Reader.h"
 #include "Model/BrushFace.h"
 #include "Model/BrushNode.h"
+#include "Model/ParallelTexCoordSystem.h"
+#include "Model/ParaxialTexCoordSystem.h"
 
 #include <kdl/overload.h>
 #include <kdl/result.h>
 #include <kdl/string_utils.h>
 #include <kdl/vector_utils.h>
 
+#include <cstdint>
+#include <memory>
+#include <string>
+
 namespace TrenchBroom {
     namespace Model {
         BrushSnapshot::BrushSnapshot(BrushNode* brushNode) :
-        m_brushNode(brushNode) {
-            const Brush& brush = m_brushNode->brush();
-            for (const BrushFace& face : brush.faces()) {
-                BrushFace& copy = m_faces.emplace_back(face);
-                copy.setTexture(nullptr);
+        m_brushNode(brushNode),
+        m_brush(m_brushNode->brush()),
+        m_uncompressedSize(0u),
+        m_compressed(false) {
+            for (BrushFace& face : m_brush.faces()) {
+                face.setTexture(nullptr);
             }
         }
 
         kdl::result<void, SnapshotErrors> BrushSnapshot::doRestore(const vm::bbox3& worldBounds) {
-            return Brush::create(worldBounds, std::move(m_faces))
-                .visit(kdl::overload {
-                    [&](Brush&& b) {
-                        m_brushNode->setBrush(std::move(b));
-                        return kdl::result<void, SnapshotErrors>::success();
-                    },
-                    [](const BrushError e) {
-                        return kdl::result<void, SnapshotErrors>::error(SnapshotErrors{e});
-                    }
-                });
+            if (m_compressed) {
+                return Brush::create(worldBounds, decompressFaces())
+                    .visit(kdl::overload {
+                        [&](Brush&& b) {
+                            m_brushNode->setBrush(std::move(b));
+                            return kdl::result<void, SnapshotErrors>::success();
+                        },
+                        [](const BrushError e) {
+                            return kdl::result<void, SnapshotErrors>::error(SnapshotErrors{e});
+                        }
+                    });
+            }
+
+            // the geometry of the snapshot is still valid, so it need not be rebuilt from the faces
+            m_brushNode->setBrush(std::move(m_brush));
+            return kdl::result<void, SnapshotErrors>::success();
+        }
+
+        size_t BrushSnapshot::doGetMemorySize() const {
+            // the geometry is shared with the current brush unless the brush was rebuilt after the snapshot was taken
+            return sizeof(BrushSnapshot) - sizeof(Brush) + m_brush.memorySize() + m_compressedFaces.capacity();
+        }
+
+        template <typename T>
+        static void write(std::string& buffer, const T& value) {
+            buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        /**
+         * The faces are stored in binary form rather than in map file syntax because the latter does not preserve
+         * the exact values of the face points and texture attributes.
+         */
+        void BrushSnapshot::doCompress() {
+            if (m_compressed) {
+                return;
+            }
+
+            auto buffer = std::string();
+            for (const BrushFace& face : m_brush.faces()) {
+                for (const vm::vec3& point : face.points()) {
+                    write(buffer, point);
+                }
+                write(buffer, face.boundary().normal);
+                write(buffer, face.boundary().distance);
+
+                const BrushFaceAttributes& attributes = face.attributes();
+                write(buffer, static_cast<uint64_t>(attributes.textureName().size()));
+                buffer.append(attributes.textureName());
+                write(buffer, attributes.offset());
+                write(buffer, attributes.scale());
+                write(buffer, attributes.rotation());
+                write(buffer, attributes.surfaceContents());
+                write(buffer, attributes.surfaceFlags());
+                write(buffer, attributes.surfaceValue());
+                write(buffer, static_cast<const vm::vec4f&>(attributes.color()));
+
+                // only parallel texture coordinate systems can take snapshots
+                const bool parallel = face.takeTexCoordSystemSnapshot() != nullptr;
+                write(buffer, parallel);
+                write(buffer, face.textureXAxis());
+                write(buffer, face.textureYAxis());
+
+                write(buffer, face.selected());
+                write(buffer, static_cast<uint64_t>(face.lineNumber()));
+                write(buffer, static_cast<uint64_t>(face.lineCount()));
+            }
+
+            m_compressedFaces = IO::compressData(buffer);
+            m_uncompressedSize = buffer.size();
+            m_brush = Brush();
+            m_compressed = true;
+        }
+
+        std::vector<BrushFace> BrushSnapshot::decompressFaces() const {
+            const auto buffer = IO::decompressData(m_compressedFaces, m_uncompressedSize);
+            auto reader = IO::Reader::from(buffer.data(), buffer.data() + buffer.size());
+
+            auto result = std::vector<BrushFace>();
+            while (!reader.eof()) {
+                auto points = BrushFace::Points();
+                for (vm::vec3& point : points) {
+                    point = reader.read<vm::vec3, vm::vec3>();
+                }
+                const auto normal = reader.read<vm::vec3, vm::vec3>();
+                const auto distance = reader.read<FloatType, FloatType>();
+
+                auto textureName = std::string(reader.readSize<uint64_t>(), '\0');
+                reader.read(textureName.data(), textureName.size());
+
+                auto attributes = BrushFaceAttributes(textureName);
+                attributes.setOffset(reader.read<vm::vec2f, vm::vec2f>());
+                attributes.setScale(reader.read<vm::vec2f, vm::vec2f>());
+                attributes.setRotation(reader.read<float, float>());
+                attributes.setSurfaceContents(reader.read<int, int>());
+                attributes.setSurfaceFlags(reader.read<int, int>());
+                attributes.setSurfaceValue(reader.read<float, float>());
+                attributes.setColor(Color(reader.read<vm::vec4f, vm::vec4f>()));
+
+                const auto parallel = reader.read<bool, bool>();
+                const auto xAxis = reader.read<vm::vec3, vm::vec3>();
+                const auto yAxis = reader.read<vm::vec3, vm::vec3>();
+                auto texCoordSystem = parallel
+                    ? std::unique_ptr<TexCoordSystem>(std::make_unique<ParallelTexCoordSystem>(xAxis, yAxis))
+                    : std::unique_ptr<TexCoordSystem>(std::make_unique<ParaxialTexCoordSystem>(ParaxialTexCoordSystem::planeNormalIndex(normal), xAxis, yAxis));
+
+                auto& face = result.emplace_back(points, vm::plane3(distance, normal), attributes, std::move(texCoordSystem));
+                if (reader.read<bool, bool>()) {
+                    face.select();
+                }
+                const auto lineNumber = reader.readSize<uint64_t>();
+                const auto lineCount = reader.readSize<uint64_t>();
+                face.setFilePosition(lineNumber, lineCount);
+            }
+            return result;
         }
     }
 }
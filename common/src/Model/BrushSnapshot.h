@@ -20,6 +20,7 @@
 #ifndef TrenchBroom_BrushSnapshot
 #define TrenchBroom_BrushSnapshot
 
+#include "Model/Brush.h"
 #include "Model/NodeSnapshot.h"
 
 #include <kdl/result_forward.h>
@@ -29,18 +30,25 @@
 namespace TrenchBroom {
     namespace Model {
         class BrushNode;
-        class BrushFace;
 
         class BrushSnapshot : public NodeSnapshot {
         private:
             BrushNode* m_brushNode;
-            std::vector<BrushFace> m_faces;
+            Brush m_brush; // shares its geometry with the brush of m_brushNode
+
+            // the faces are moved here by doCompress, the geometry is rebuilt when the snapshot is restored
+            std::vector<unsigned char> m_compressedFaces;
+            size_t m_uncompressedSize;
+            bool m_compressed;
         public:
             BrushSnapshot(BrushNode* brushNode);
         private:
             void takeSnapshot(BrushNode* brushNode);
             
             kdl::result<void, SnapshotErrors> doRestore(const vm::bbox3& worldBounds) override;
+            size_t doGetMemorySize() const override;
+            void doCompress() override;
+            std::vector<BrushFace> decompressFaces() const;
         };
     }
 }
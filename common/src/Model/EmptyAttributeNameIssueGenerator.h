@@ -33,6 +33,7 @@ namespace TrenchBroom {
         public:
             EmptyAttributeNameIssueGenerator();
         private:
+            bool doIsThreadSafe() const override;
             void doGenerate(AttributableNode* node, IssueList& issues) const override;
         };
     }
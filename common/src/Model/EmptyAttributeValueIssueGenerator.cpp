@@ -81,6 +81,10 @@ namespace TrenchBroom {
             addQuickFix(new EmptyAttributeValueIssueQuickFix());
         }
 
+        bool EmptyAttributeValueIssueGenerator::doIsThreadSafe() const {
+            return true;
+        }
+
         void EmptyAttributeValueIssueGenerator::doGenerate(AttributableNode* node, IssueList& issues) const {
             for (const EntityAttribute& attribute : node->attributes()) {
                 if (attribute.value().empty())
@@ -33,6 +33,7 @@ namespace TrenchBroom {
         public:
             EmptyAttributeValueIssueGenerator();
         private:
+            bool doIsThreadSafe() const override;
             void doGenerate(AttributableNode* node, IssueList& issues) const override;
         };
     }
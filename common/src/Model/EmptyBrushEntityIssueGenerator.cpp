@@ -65,6 +65,10 @@ namespace TrenchBroom {
             addQuickFix(new EmptyBrushEntityIssueQuickFix());
         }
 
+        bool EmptyBrushEntityIssueGenerator::doIsThreadSafe() const {
+            return true;
+        }
+
         void EmptyBrushEntityIssueGenerator::doGenerate(EntityNode* entity, IssueList& issues) const {
             ensure(entity != nullptr, "entity is null");
             const Assets::EntityDefinition* definition = entity->definition();
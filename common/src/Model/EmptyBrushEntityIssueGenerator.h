@@ -33,6 +33,7 @@ namespace TrenchBroom {
         public:
             EmptyBrushEntityIssueGenerator();
         private:
+            bool doIsThreadSafe() const override;
             void doGenerate(EntityNode* entity, IssueList& issues) const override;
         };
     }
@@ -64,6 +64,10 @@ namespace TrenchBroom {
             addQuickFix(new EmptyGroupIssueQuickFix());
         }
 
+        bool EmptyGroupIssueGenerator::doIsThreadSafe() const {
+            return true;
+        }
+
         void EmptyGroupIssueGenerator::doGenerate(GroupNode* group, IssueList& issues) const {
             ensure(group != nullptr, "group is null");
             if (!group->hasChildren())
@@ -33,6 +33,7 @@ namespace TrenchBroom {
         public:
             EmptyGroupIssueGenerator();
         private:
+            bool doIsThreadSafe() const override;
             void doGenerate(GroupNode* group, IssueList& issues) const override;
         };
     }
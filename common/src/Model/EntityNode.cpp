@@ -146,7 +146,33 @@ namespace TrenchBroom {
                 return Assets::ModelSpecification();
             } else {
                 auto* pointDefinition = static_cast<Assets::PointEntityDefinition*>(m_definition);
-                return pointDefinition->model(m_attributes);
+                const auto& variableNames = pointDefinition->modelDefinition().variableNames();
+
+                if (m_cachedModelSpecification && m_cachedModelSpecification->definition == m_definition) {
+                    // compare the cached attribute values in place so that a cache hit doesn't copy any strings
+                    const auto& cachedValues = m_cachedModelSpecification->attributeValues;
+                    bool cacheHit = cachedValues.size() == variableNames.size();
+                    for (size_t i = 0u; i < variableNames.size() && cacheHit; ++i) {
+                        const auto* value = m_attributes.attribute(variableNames[i]);
+                        cacheHit = value != nullptr ? cachedValues[i] == *value : !cachedValues[i].has_value();
+                    }
+
+                    if (cacheHit) {
+                        return m_cachedModelSpecification->modelSpecification;
+                    }
+                }
+
+                std::vector<std::optional<std::string>> attributeValues;
+                attributeValues.reserve(variableNames.size());
+                for (const auto& name : variableNames) {
+                    const auto* value = m_attributes.attribute(name);
+                    attributeValues.push_back(value != nullptr ? std::optional<std::string>(*value) : std::nullopt);
+                }
+
+                // if the evaluation throws, the cache is left as it is and the next call will evaluate again
+                auto modelSpecification = pointDefinition->model(m_attributes);
+                m_cachedModelSpecification = CachedModelSpecification{ m_definition, std::move(attributeValues), modelSpecification };
+                return modelSpecification;
             }
         }
 
@@ -310,6 +336,11 @@ namespace TrenchBroom {
         }
 
         void EntityNode::doAttributesDidChange(const vm::bbox3& oldBounds) {
+            // the definition may have been replaced by a new one that happens to live at the same address
+            if (m_cachedModelSpecification && m_cachedModelSpecification->definition != m_definition) {
+                m_cachedModelSpecification = std::nullopt;
+            }
+
             // update m_cachedOrigin and m_cachedRotation. Must be done first because nodePhysicalBoundsDidChange() might
             // call origin()
             cacheAttributes();
@@ -22,6 +22,7 @@
 
 #include "FloatType.h"
 #include "Macros.h"
+#include "Assets/ModelDefinition.h"
 #include "Model/AttributableNode.h"
 #include "Model/HitType.h"
 #include "Model/Object.h"
@@ -32,14 +33,15 @@
 #include <vecmath/bbox.h>
 #include <vecmath/util.h>
 
+#include <optional>
 #include <string>
 #include <vector>
 
 namespace TrenchBroom {
     namespace Assets {
         enum class PitchType;
+        class EntityDefinition;
         class EntityModelFrame;
-        struct ModelSpecification;
     }
 
     namespace Model {
@@ -56,6 +58,17 @@ namespace TrenchBroom {
             mutable vm::vec3 m_cachedOrigin;
             mutable vm::mat4x4 m_cachedRotation;
 
+            /**
+             * The result of the last model specification evaluation together with the definition and the values of
+             * the attributes it was evaluated with.
+             */
+            struct CachedModelSpecification {
+                const Assets::EntityDefinition* definition;
+                std::vector<std::optional<std::string>> attributeValues;
+                Assets::ModelSpecification modelSpecification;
+            };
+            mutable std::optional<CachedModelSpecification> m_cachedModelSpecification;
+
             const Assets::EntityModelFrame* m_modelFrame;
         public:
             EntityNode();
@@ -79,6 +92,12 @@ namespace TrenchBroom {
             void setOrigin(const vm::vec3& origin);
             void applyRotation(const vm::mat4x4& transformation);
         public: // entity model
+            /**
+             * Returns the model specification of this entity. The result is cached and only re-evaluated if the
+             * entity definition or the value of an attribute referenced by the model expression has changed.
+             *
+             * @throws EL::Exception if the model expression could not be evaluated
+             */
             Assets::ModelSpecification modelSpecification() const;
             const vm::bbox3& modelBounds() const;
             const Assets::EntityModelFrame* modelFrame() const;
@@ -20,19 +20,81 @@
 #include "EntitySnapshot.h"
 
 #include "Exceptions.h"
+#include "IO/Compression.h"
+#include "IO/Reader.h"
 #include "Model/EntityNode.h"
 
 #include <kdl/result.h>
 
+#include <cstdint>
+#include <string>
+#include <vector>
+
 namespace TrenchBroom {
     namespace Model {
         EntitySnapshot::EntitySnapshot(EntityNode* entity) :
         m_entity(entity),
-        m_attributesSnapshot(entity->attributes()) {}
+        m_attributesSnapshot(entity->attributes()),
+        m_uncompressedSize(0u),
+        m_compressed(false) {}
 
         kdl::result<void, SnapshotErrors> EntitySnapshot::doRestore(const vm::bbox3& /* worldBounds */) {
-            m_entity->setAttributes(m_attributesSnapshot);
+            if (m_compressed) {
+                m_entity->setAttributes(decompressAttributes());
+            } else {
+                m_entity->setAttributes(m_attributesSnapshot);
+            }
             return kdl::result<void, SnapshotErrors>::success();
         }
+
+        size_t EntitySnapshot::doGetMemorySize() const {
+            size_t result = sizeof(EntitySnapshot) + m_compressedAttributes.capacity();
+            for (const EntityAttribute& attribute : m_attributesSnapshot) {
+                result += sizeof(EntityAttribute) + attribute.name().capacity() + attribute.value().capacity();
+            }
+            return result;
+        }
+
+        static void writeString(std::string& buffer, const std::string& str) {
+            const auto size = static_cast<uint64_t>(str.size());
+            buffer.append(reinterpret_cast<const char*>(&size), sizeof(size));
+            buffer.append(str);
+        }
+
+        static std::string readString(IO::Reader& reader) {
+            auto str = std::string(reader.readSize<uint64_t>(), '\0');
+            reader.read(str.data(), str.size());
+            return str;
+        }
+
+        void EntitySnapshot::doCompress() {
+            if (m_compressed) {
+                return;
+            }
+
+            auto buffer = std::string();
+            for (const EntityAttribute& attribute : m_attributesSnapshot) {
+                writeString(buffer, attribute.name());
+                writeString(buffer, attribute.value());
+            }
+
+            m_compressedAttributes = IO::compressData(buffer);
+            m_uncompressedSize = buffer.size();
+            m_attributesSnapshot = std::vector<EntityAttribute>();
+            m_compressed = true;
+        }
+
+        std::vector<EntityAttribute> EntitySnapshot::decompressAttributes() const {
+            const auto buffer = IO::decompressData(m_compressedAttributes, m_uncompressedSize);
+            auto reader = IO::Reader::from(buffer.data(), buffer.data() + buffer.size());
+
+            auto result = std::vector<EntityAttribute>();
+            while (!reader.eof()) {
+                auto name = readString(reader);
+                auto value = readString(reader);
+                result.emplace_back(std::move(name), std::move(value));
+            }
+            return result;
+        }
     }
 }
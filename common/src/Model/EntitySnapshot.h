@@ -38,10 +38,18 @@ namespace TrenchBroom {
         private:
             EntityNode* m_entity;
             std::vector<EntityAttribute> m_attributesSnapshot;
+
+            // the attributes are moved here by doCompress
+            std::vector<unsigned char> m_compressedAttributes;
+            size_t m_uncompressedSize;
+            bool m_compressed;
         public:
             EntitySnapshot(EntityNode* entity);
         private:
             kdl::result<void, SnapshotErrors> doRestore(const vm::bbox3& worldBounds) override;
+            size_t doGetMemorySize() const override;
+            void doCompress() override;
+            std::vector<EntityAttribute> decompressAttributes() const;
         };
     }
 }
@@ -86,6 +86,10 @@ namespace TrenchBroom {
             doWriteMap(world, path);
         }
 
+        std::string Game::writeMapToString(WorldNode& world) const {
+            return doWriteMapToString(world);
+        }
+
         void Game::exportMap(WorldNode& world, const Model::ExportFormat format, const IO::Path& path) const {
             doExportMap(world, format, path);
         }
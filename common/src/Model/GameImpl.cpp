@@ -26,6 +26,7 @@
 #include "Assets/Palette.h"
 #include "Assets/EntityModel.h"
 #include "Assets/EntityDefinitionFileSpec.h"
+#include "Assets/TextureManager.h"
 #include "IO/AseParser.h"
 #include "IO/BrushFaceReader.h"
 #include "IO/Bsp29Parser.h"
@@ -191,6 +192,17 @@ namespace TrenchBroom {
             writer.writeMap();
         }
 
+        std::string GameImpl::doWriteMapToString(WorldNode& world) const {
+            const auto mapFormatName = formatName(world.format());
+
+            std::string result;
+            IO::writeGameComment(result, gameName(), mapFormatName);
+
+            IO::NodeWriter writer(world, result);
+            writer.writeMap();
+            return result;
+        }
+
         void GameImpl::doExportMap(WorldNode& world, const Model::ExportFormat format, const IO::Path& path) const {
             switch (format) {
                 case Model::ExportFormat::WavefrontObj:
@@ -234,12 +246,15 @@ namespace TrenchBroom {
             }
         }
 
-        void GameImpl::doLoadTextureCollections(AttributableNode& node, const IO::Path& documentPath, Assets::TextureManager& textureManager, Logger& logger) const {
+        void GameImpl::doLoadTextureCollections(AttributableNode& node, const IO::Path& documentPath, Assets::TextureManager& textureManager, Logger& /* logger */) const {
             const auto paths = extractTextureCollections(node);
 
             const auto fileSearchPaths = textureCollectionSearchPaths(documentPath);
-            IO::TextureLoader textureLoader(m_fs, fileSearchPaths, m_config.textureConfig(), logger);
-            textureLoader.loadTextures(paths, textureManager);
+
+            // texture collections are decoded on worker threads, so the loader reports to the texture manager's
+            // load logger, which passes its messages on afterwards
+            auto textureLoader = std::make_unique<IO::TextureLoader>(m_fs, fileSearchPaths, m_config.textureConfig(), textureManager.loadLogger());
+            textureManager.setTextureCollections(paths, std::move(textureLoader));
         }
 
         std::vector<IO::Path> GameImpl::textureCollectionSearchPaths(const IO::Path& documentPath) const {
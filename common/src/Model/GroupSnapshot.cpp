@@ -59,5 +59,19 @@ namespace TrenchBroom {
                 ? kdl::result<void, SnapshotErrors>::success()
                 : kdl::result<void, SnapshotErrors>::error(std::move(errors));
         }
+
+        size_t GroupSnapshot::doGetMemorySize() const {
+            size_t result = sizeof(GroupSnapshot);
+            for (const NodeSnapshot* snapshot : m_snapshots) {
+                result += snapshot->memorySize();
+            }
+            return result;
+        }
+
+        void GroupSnapshot::doCompress() {
+            for (NodeSnapshot* snapshot : m_snapshots) {
+                snapshot->compress();
+            }
+        }
     }
 }
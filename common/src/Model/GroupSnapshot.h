@@ -43,6 +43,8 @@ namespace TrenchBroom {
             void takeSnapshot(GroupNode* group);
             
             kdl::result<void, SnapshotErrors> doRestore(const vm::bbox3& worldBounds) override;
+            size_t doGetMemorySize() const override;
+            void doCompress() override;
         };
     }
 }
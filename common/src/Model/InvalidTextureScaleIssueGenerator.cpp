@@ -85,6 +85,10 @@ namespace TrenchBroom {
             addQuickFix(new InvalidTextureScaleIssueQuickFix());
         }
 
+        bool InvalidTextureScaleIssueGenerator::doIsThreadSafe() const {
+            return true;
+        }
+
         void InvalidTextureScaleIssueGenerator::doGenerate(BrushNode* brushNode, IssueList& issues) const {
             const Brush& brush = brushNode->brush();
             for (size_t i = 0u; i < brush.faceCount(); ++i) {
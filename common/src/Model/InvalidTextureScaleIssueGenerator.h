@@ -33,6 +33,7 @@ namespace TrenchBroom {
         public:
             InvalidTextureScaleIssueGenerator();
         private:
+            bool doIsThreadSafe() const override;
             void doGenerate(BrushNode* brushNode, IssueList& issues) const override;
         };
     }
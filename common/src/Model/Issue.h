@@ -34,6 +34,8 @@ namespace TrenchBroom {
 
         class Issue {
         private:
+            friend class Node;
+
             size_t m_seqId;
         protected:
             Node* const m_node;
@@ -71,6 +71,10 @@ namespace TrenchBroom {
             addQuickFix(new LinkSourceIssueQuickFix());
         }
 
+        bool LinkSourceIssueGenerator::doIsThreadSafe() const {
+            return true;
+        }
+
         void LinkSourceIssueGenerator::doGenerate(AttributableNode* node, IssueList& issues) const {
             if (node->hasMissingSources())
                 issues.push_back(new LinkSourceIssue(node));
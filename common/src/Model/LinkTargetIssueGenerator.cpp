@@ -82,6 +82,10 @@ namespace TrenchBroom {
             addQuickFix(new LinkTargetIssueQuickFix());
         }
 
+        bool LinkTargetIssueGenerator::doIsThreadSafe() const {
+            return true;
+        }
+
         void LinkTargetIssueGenerator::doGenerate(AttributableNode* node, IssueList& issues) const {
             processKeys(node, node->findMissingLinkTargets(), issues);
             processKeys(node, node->findMissingKillTargets(), issues);
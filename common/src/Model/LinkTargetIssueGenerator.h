@@ -34,6 +34,7 @@ namespace TrenchBroom {
         public:
             LinkTargetIssueGenerator();
         private:
+            bool doIsThreadSafe() const override;
             void doGenerate(AttributableNode* node, IssueList& issues) const override;
             void processKeys(AttributableNode* node, const std::vector<std::string>& names, IssueList& issues) const;
         };
@@ -61,6 +61,10 @@ namespace TrenchBroom {
             addQuickFix(new RemoveEntityAttributesQuickFix(LongAttributeNameIssue::Type));
         }
 
+        bool LongAttributeNameIssueGenerator::doIsThreadSafe() const {
+            return true;
+        }
+
         void LongAttributeNameIssueGenerator::doGenerate(AttributableNode* node, IssueList& issues) const {
             for (const EntityAttribute& attribute : node->attributes()) {
                 const std::string& attributeName = attribute.name();
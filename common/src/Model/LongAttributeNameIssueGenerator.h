@@ -34,6 +34,7 @@ namespace TrenchBroom {
         public:
             LongAttributeNameIssueGenerator(size_t maxLength);
         private:
+            bool doIsThreadSafe() const override;
             void doGenerate(AttributableNode* node, IssueList& issues) const override;
         };
     }
@@ -88,6 +88,10 @@ namespace TrenchBroom {
             addQuickFix(new TruncateLongAttributeValueIssueQuickFix(m_maxLength));
         }
 
+        bool LongAttributeValueIssueGenerator::doIsThreadSafe() const {
+            return true;
+        }
+
         void LongAttributeValueIssueGenerator::doGenerate(AttributableNode* node, IssueList& issues) const {
             for (const EntityAttribute& attribute : node->attributes()) {
                 const auto& attributeName = attribute.name();
@@ -35,6 +35,7 @@ namespace TrenchBroom {
         public:
             LongAttributeValueIssueGenerator(size_t maxLength);
         private:
+            bool doIsThreadSafe() const override;
             void doGenerate(AttributableNode* node, IssueList& issues) const override;
         };
     }
@@ -64,6 +64,10 @@ namespace TrenchBroom {
             addQuickFix(new MissingDefinitionIssueQuickFix());
         }
 
+        bool MissingDefinitionIssueGenerator::doIsThreadSafe() const {
+            return true;
+        }
+
         void MissingDefinitionIssueGenerator::doGenerate(AttributableNode* node, IssueList& issues) const {
             if (node->definition() == nullptr)
                 issues.push_back(new MissingDefinitionIssue(node));
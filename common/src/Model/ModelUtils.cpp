@@ -20,7 +20,15 @@
 #include "ModelUtils.h"
 
 #include "Ensure.h"
+#include "Model/AttributableNode.h"
+#include "Model/Brush.h"
+#include "Model/BrushNode.h"
 #include "Model/CollectNodesVisitor.h"
+#include "Model/EntityNode.h"
+#include "Model/GroupNode.h"
+#include "Model/LayerNode.h"
+#include "Model/NodeVisitor.h"
+#include "Model/WorldNode.h"
 
 #include <kdl/vector_utils.h>
 
@@ -69,5 +77,42 @@ namespace TrenchBroom {
 
             return result;
         }
+
+        class ComputeMemorySizeVisitor : public ConstNodeVisitor {
+        private:
+            size_t m_memorySize;
+        public:
+            ComputeMemorySizeVisitor() :
+            m_memorySize(0u) {}
+
+            size_t memorySize() const { return m_memorySize; }
+        private:
+            void doVisit(const WorldNode* world) override   { visitAttributableNode(world, sizeof(WorldNode)); }
+            void doVisit(const LayerNode* layer) override   { visitAttributableNode(layer, sizeof(LayerNode)); }
+            void doVisit(const GroupNode* group) override   { visitAttributableNode(group, sizeof(GroupNode)); }
+            void doVisit(const EntityNode* entity) override { visitAttributableNode(entity, sizeof(EntityNode)); }
+            void doVisit(const BrushNode* brush) override   { m_memorySize += sizeof(BrushNode) - sizeof(Brush) + brush->brush().memorySize(); }
+
+            void visitAttributableNode(const AttributableNode* attributable, const size_t nodeSize) {
+                m_memorySize += nodeSize;
+                for (const EntityAttribute& attribute : attributable->attributes()) {
+                    m_memorySize += sizeof(EntityAttribute) + attribute.name().capacity() + attribute.value().capacity();
+                }
+            }
+        };
+
+        size_t memorySize(const std::vector<Node*>& nodes) {
+            ComputeMemorySizeVisitor visitor;
+            Node::acceptAndRecurse(std::begin(nodes), std::end(nodes), visitor);
+            return visitor.memorySize();
+        }
+
+        size_t memorySize(const std::map<Node*, std::vector<Node*>>& nodes) {
+            size_t result = 0u;
+            for (const auto& entry : nodes) {
+                result += sizeof(entry) + entry.second.capacity() * sizeof(Node*);
+            }
+            return result;
+        }
     }
 }
@@ -43,6 +43,17 @@ namespace TrenchBroom {
         std::vector<Node*> collectChildren(const std::map<Node*, std::vector<Node*>>& nodes);
         std::vector<Node*> collectDescendants(const std::vector<Node*>& nodes);
         std::map<Node*, std::vector<Node*>> parentChildrenMap(const std::vector<Node*>& nodes);
+
+        /**
+         * Returns an estimate of the number of bytes of memory held by the given nodes and their descendants.
+         */
+        size_t memorySize(const std::vector<Node*>& nodes);
+
+        /**
+         * Returns an estimate of the number of bytes of memory held by the given map itself. The nodes are not
+         * counted.
+         */
+        size_t memorySize(const std::map<Node*, std::vector<Node*>>& nodes);
     }
 }
 
@@ -26,6 +26,7 @@
 #include "Model/LockState.h"
 #include "Model/VisibilityState.h"
 
+#include <kdl/parallel.h>
 #include <kdl/vector_utils.h>
 
 #include <vecmath/bbox.h>
@@ -606,6 +607,49 @@ namespace TrenchBroom {
             return m_issues;
         }
 
+        bool Node::issuesValid() const {
+            return m_issuesValid;
+        }
+
+        void Node::validateIssues(const std::vector<Node*>& nodes, const std::vector<IssueGenerator*>& issueGenerators) {
+            const auto invalidNodes = kdl::vec_filter(nodes, [](const Node* node) { return !node->m_issuesValid; });
+
+            // the bounds of entities, groups and layers are cached lazily, so compute them before fanning out
+            for (const Node* node : invalidNodes) {
+                node->logicalBounds();
+                node->physicalBounds();
+            }
+
+            // the issues of each invalid node, by generator, for the thread safe generators
+            std::vector<std::vector<std::vector<Issue*>>> parallelIssues(invalidNodes.size());
+            kdl::parallel_for(invalidNodes.size(), [&](const size_t i) {
+                auto& nodeIssues = parallelIssues[i];
+                nodeIssues.resize(issueGenerators.size());
+                for (size_t j = 0u; j < issueGenerators.size(); ++j) {
+                    if (issueGenerators[j]->threadSafe()) {
+                        invalidNodes[i]->doGenerateIssues(issueGenerators[j], nodeIssues[j]);
+                    }
+                }
+            });
+
+            for (size_t i = 0u; i < invalidNodes.size(); ++i) {
+                Node* node = invalidNodes[i];
+                for (size_t j = 0u; j < issueGenerators.size(); ++j) {
+                    if (issueGenerators[j]->threadSafe()) {
+                        kdl::vec_append(node->m_issues, parallelIssues[i][j]);
+                    } else {
+                        node->doGenerateIssues(issueGenerators[j], node->m_issues);
+                    }
+                }
+
+                // the issues were created in arbitrary order, so renumber them to keep their order deterministic
+                for (Issue* issue : node->m_issues) {
+                    issue->m_seqId = Issue::nextSeqId();
+                }
+                node->m_issuesValid = true;
+            }
+        }
+
         bool Node::issueHidden(const IssueType type) const {
             return (type & m_hiddenIssues) != 0;
         }
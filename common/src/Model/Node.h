@@ -296,6 +296,14 @@ namespace TrenchBroom {
             bool containsLine(size_t lineNumber) const;
         public: // issue management
             const std::vector<Issue*>& issues(const std::vector<IssueGenerator*>& issueGenerators);
+            bool issuesValid() const;
+
+            /**
+             * Generates the issues of those of the given nodes whose issues are not valid. Thread safe issue
+             * generators are run on the nodes in parallel, the others are run on the calling thread. The resulting
+             * issues are the same as if issues() had been called on each of the nodes in the given order.
+             */
+            static void validateIssues(const std::vector<Node*>& nodes, const std::vector<IssueGenerator*>& issueGenerators);
 
             bool issueHidden(IssueType type) const;
             void setIssueHidden(IssueType type, bool hidden);
@@ -28,5 +28,13 @@ namespace TrenchBroom {
         kdl::result<void, SnapshotErrors> NodeSnapshot::restore(const vm::bbox3& worldBounds) {
             return doRestore(worldBounds);
         }
+
+        size_t NodeSnapshot::memorySize() const {
+            return doGetMemorySize();
+        }
+
+        void NodeSnapshot::compress() {
+            doCompress();
+        }
     }
 }
@@ -35,8 +35,21 @@ namespace TrenchBroom {
         public:
             virtual ~NodeSnapshot();
             kdl::result<void, SnapshotErrors> restore(const vm::bbox3& worldBounds);
+
+            /**
+             * Returns an estimate of the number of bytes of memory held by this snapshot.
+             */
+            size_t memorySize() const;
+
+            /**
+             * Compresses the state held by this snapshot to reduce its memory usage. The state is decompressed
+             * transparently when the snapshot is restored.
+             */
+            void compress();
         private:
             virtual kdl::result<void, SnapshotErrors> doRestore(const vm::bbox3& worldBounds) = 0;
+            virtual size_t doGetMemorySize() const = 0;
+            virtual void doCompress() = 0;
         };
     }
 }
@@ -81,6 +81,10 @@ namespace TrenchBroom {
             addQuickFix(new PointEntityWithBrushesIssueQuickFix());
         }
 
+        bool PointEntityWithBrushesIssueGenerator::doIsThreadSafe() const {
+            return true;
+        }
+
         void PointEntityWithBrushesIssueGenerator::doGenerate(EntityNode* entity, IssueList& issues) const {
             ensure(entity != nullptr, "entity is null");
             const Assets::EntityDefinition* definition = entity->definition();
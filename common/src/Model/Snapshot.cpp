@@ -50,6 +50,20 @@ namespace TrenchBroom {
                 : kdl::result<void, SnapshotErrors>::error(std::move(errors));
         }
 
+        size_t Snapshot::memorySize() const {
+            size_t result = sizeof(Snapshot);
+            for (const NodeSnapshot* snapshot : m_nodeSnapshots) {
+                result += snapshot->memorySize();
+            }
+            return result;
+        }
+
+        void Snapshot::compress() {
+            for (NodeSnapshot* snapshot : m_nodeSnapshots) {
+                snapshot->compress();
+            }
+        }
+
         void Snapshot::takeSnapshot(Node* node) {
             NodeSnapshot* snapshot = node->takeSnapshot();
             if (snapshot != nullptr)
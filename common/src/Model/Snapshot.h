@@ -61,6 +61,17 @@ namespace TrenchBroom {
              * @return nothing on success or an error if restore failed
              */
             kdl::result<void, SnapshotErrors> restoreNodes(const vm::bbox3& worldBounds);
+
+            /**
+             * Returns an estimate of the number of bytes of memory held by this snapshot.
+             */
+            size_t memorySize() const;
+
+            /**
+             * Compresses the snapshotted states to reduce the memory held by this snapshot. Restoring the nodes
+             * decompresses them again.
+             */
+            void compress();
         private:
             void takeSnapshot(Node* node);
             
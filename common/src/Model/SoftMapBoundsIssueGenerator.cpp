@@ -82,6 +82,10 @@ namespace TrenchBroom {
             }
         }
 
+        bool SoftMapBoundsIssueGenerator::doIsThreadSafe() const {
+            return true;
+        }
+
         void SoftMapBoundsIssueGenerator::doGenerate(EntityNode* entity, IssueList& issues) const {
             generateInternal(entity, issues);
         }
@@ -45,6 +45,7 @@ namespace TrenchBroom {
             explicit SoftMapBoundsIssueGenerator(std::weak_ptr<Game> game, const WorldNode* world);
         private:
             void generateInternal(Node* node, IssueList& issues) const;
+            bool doIsThreadSafe() const override;
             void doGenerate(EntityNode* brush, IssueList& issues) const override;
             void doGenerate(BrushNode* brush, IssueList& issues) const override;
         };
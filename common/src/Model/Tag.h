@@ -30,6 +30,10 @@
 #include <vector>
 
 namespace TrenchBroom {
+    namespace Assets {
+        class Texture;
+    }
+
     namespace Model {
         class ConstTagVisitor;
         class TagManager;
@@ -299,6 +303,22 @@ namespace TrenchBroom {
              */
             virtual bool matches(const Taggable& taggable) const = 0;
 
+            /**
+             * Indicates whether this tag matcher matches a brush face if and only if it matches the face's texture. The
+             * results of such matchers are cached per texture by the tag manager.
+             *
+             * @return true if this tag matcher only depends on the texture of a brush face and false otherwise
+             */
+            virtual bool matchesByTexture() const;
+
+            /**
+             * Evaluates this tag matcher against the given texture. Only meaningful if matchesByTexture() returns true.
+             *
+             * @param texture the texture to match against, may be null
+             * @return true if this matcher matches the given texture and false otherwise
+             */
+            virtual bool matchesTexture(const Assets::Texture* texture) const;
+
             /**
              * Modifies the current selection so that this tag matcher would match it.
              *
@@ -365,6 +385,19 @@ namespace TrenchBroom {
              */
             bool matches(const Taggable& taggable) const;
 
+            /**
+             * Indicates whether this smart tag matches a brush face if and only if it matches the face's texture.
+             */
+            bool matchesByTexture() const;
+
+            /**
+             * Indicates whether this smart tag matches the given texture. Only meaningful if matchesByTexture() returns
+             * true.
+             *
+             * @param texture the texture to match, may be null
+             */
+            bool matchesTexture(const Assets::Texture* texture) const;
+
             /**
              * Updates the given tag depending on whether or not the matcher matches against it.
              *
@@ -20,10 +20,16 @@
 #include "TagManager.h"
 
 #include "Ensure.h"
+#include "Assets/Texture.h"
+#include "Model/BrushFace.h"
 #include "Model/Tag.h"
 #include "Model/TagType.h"
+#include "Model/TagVisitor.h"
+
+#include <kdl/string_compare.h>
 
 #include <algorithm>
+#include <atomic>
 #include <stdexcept>
 #include <string>
 
@@ -45,6 +51,12 @@ namespace TrenchBroom {
             return lhs < rhs;
         }
 
+        TagManager::TagManager() :
+        m_textureTagTypes(TagType::NoType),
+        m_textureCacheId(0u) {
+            resetTextureTagCache();
+        }
+
         const std::vector<SmartTag>& TagManager::smartTags() const {
             return m_smartTags.get_data();
         }
@@ -91,15 +103,60 @@ namespace TrenchBroom {
 
                 it->setIndex(nextIndex);
             }
+
+            resetTextureTagCache();
         }
 
         void TagManager::clearSmartTags() {
             m_smartTags.clear();
+            resetTextureTagCache();
         }
 
+        class FindFaceTexture : public ConstTagVisitor {
+        private:
+            const Assets::Texture* m_texture;
+        public:
+            FindFaceTexture() :
+            m_texture(nullptr) {}
+
+            const Assets::Texture* texture() const {
+                return m_texture;
+            }
+
+            void visit(const BrushFace& face) override {
+                // only use the texture if it is in sync with the face's texture name, which is what texture name
+                // matchers see
+                const auto* texture = face.texture();
+                if (texture != nullptr && kdl::ci::str_is_equal(texture->name(), face.attributes().textureName())) {
+                    m_texture = texture;
+                }
+            }
+        };
+
         void TagManager::updateTags(Taggable& taggable) const {
+            const Assets::Texture* texture = nullptr;
+            if (m_textureTagTypes != TagType::NoType) {
+                FindFaceTexture findTexture;
+                taggable.accept(findTexture);
+                texture = findTexture.texture();
+            }
+
+            if (texture == nullptr) {
+                for (const auto& tag : m_smartTags) {
+                    tag.update(taggable);
+                }
+                return;
+            }
+
+            const auto matches = textureTagMatches(*texture);
             for (const auto& tag : m_smartTags) {
-                tag.update(taggable);
+                if ((m_textureTagTypes & tag.type()) == 0) {
+                    tag.update(taggable);
+                } else if ((matches & tag.type()) != 0) {
+                    taggable.addTag(tag);
+                } else {
+                    taggable.removeTag(tag);
+                }
             }
         }
 
@@ -109,5 +166,34 @@ namespace TrenchBroom {
             ensure(index <= Bits, "no more tag types");
             return index;
         }
+
+        void TagManager::resetTextureTagCache() {
+            // cache ids are unique across all tag managers since textures may be shared between documents
+            static std::atomic<size_t> nextCacheId(1u);
+            m_textureCacheId = nextCacheId++;
+
+            m_textureTagTypes = TagType::NoType;
+            for (const auto& tag : m_smartTags) {
+                if (tag.matchesByTexture()) {
+                    m_textureTagTypes |= tag.type();
+                }
+            }
+        }
+
+        TagType::Type TagManager::textureTagMatches(const Assets::Texture& texture) const {
+            if (const auto cachedMatches = texture.cachedTagMatches(m_textureCacheId)) {
+                return *cachedMatches;
+            }
+
+            auto matches = TagType::NoType;
+            for (const auto& tag : m_smartTags) {
+                if ((m_textureTagTypes & tag.type()) != 0 && tag.matchesTexture(&texture)) {
+                    matches |= tag.type();
+                }
+            }
+
+            texture.setCachedTagMatches(m_textureCacheId, matches);
+            return matches;
+        }
     }
 }
@@ -21,15 +21,24 @@
 #define TRENCHBROOM_TAGMANAGER_H
 
 #include "Model/Tag.h"
+#include "Model/TagType.h"
 
 #include <kdl/vector_set.h>
 
 #include <string>
 
 namespace TrenchBroom {
+    namespace Assets {
+        class Texture;
+    }
+
     namespace Model {
         /**
          * Manages the tags used in a document and updates smart tags on taggable objects.
+         *
+         * The results of smart tags whose matchers only depend on the texture of a brush face are cached on the
+         * textures as a bit mask of tag types, so that updating the tags of a face only needs to evaluate these
+         * matchers once per texture.
          */
         class TagManager {
         private:
@@ -41,7 +50,20 @@ namespace TrenchBroom {
             };
 
             kdl::vector_set<SmartTag, TagCmp> m_smartTags;
+
+            /**
+             * The types of the smart tags whose matchers only depend on the texture of a brush face.
+             */
+            TagType::Type m_textureTagTypes;
+
+            /**
+             * Identifies the registered smart tags in the match results cached on textures. Changes whenever the
+             * registered smart tags change.
+             */
+            size_t m_textureCacheId;
         public:
+            TagManager();
+
             /**
              * Returns a vector containing all smart tags registered with this manager.
              */
@@ -108,6 +130,8 @@ namespace TrenchBroom {
             void updateTags(Taggable& taggable) const;
         private:
             size_t freeTagIndex();
+            void resetTextureTagCache();
+            TagType::Type textureTagMatches(const Assets::Texture& texture) const;
         };
     }
 }
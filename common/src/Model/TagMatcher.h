@@ -73,10 +73,9 @@ namespace TrenchBroom {
 
         class TextureTagMatcher : public TagMatcher {
         public:
+            bool matchesByTexture() const override;
             void enable(TagMatcherCallback& callback, MapFacade& facade) const override;
             bool canEnable() const override;
-        private:
-            virtual bool matchesTexture(Assets::Texture* texture) const = 0;
         };
 
         class TextureNameTagMatcher : public TextureTagMatcher {
@@ -86,8 +85,8 @@ namespace TrenchBroom {
             explicit TextureNameTagMatcher(const std::string& pattern);
             std::unique_ptr<TagMatcher> clone() const override;
             bool matches(const Taggable& taggable) const override;
+            bool matchesTexture(const Assets::Texture* texture) const override;
         private:
-            bool matchesTexture(Assets::Texture* texture) const override;
             bool matchesTextureName(std::string_view textureName) const;
         };
 
@@ -99,8 +98,7 @@ namespace TrenchBroom {
             explicit SurfaceParmTagMatcher(const kdl::vector_set<std::string>& parameters);
             std::unique_ptr<TagMatcher> clone() const override;
             bool matches(const Taggable& taggable) const override;
-        private:
-            bool matchesTexture(Assets::Texture* texture) const override;
+            bool matchesTexture(const Assets::Texture* texture) const override;
         };
 
         class FlagsTagMatcher : public TagMatcher {
@@ -65,6 +65,10 @@ namespace TrenchBroom {
             addQuickFix(new WorldBoundsIssueQuickFix());
         }
 
+        bool WorldBoundsIssueGenerator::doIsThreadSafe() const {
+            return true;
+        }
+
         void WorldBoundsIssueGenerator::doGenerate(EntityNode* entity, IssueList& issues) const {
             if (!m_bounds.contains(entity->logicalBounds()))
                 issues.push_back(new WorldBoundsIssue(entity));
@@ -38,6 +38,7 @@ namespace TrenchBroom {
         public:
             explicit WorldBoundsIssueGenerator(const vm::bbox3& bounds);
         private:
+            bool doIsThreadSafe() const override;
             void doGenerate(EntityNode* brush, IssueList& issues) const override;
             void doGenerate(BrushNode* brush, IssueList& issues) const override;
         };
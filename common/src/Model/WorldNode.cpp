@@ -51,7 +51,8 @@ namespace TrenchBroom {
         m_attributableIndex(std::make_unique<AttributableNodeIndex>()),
         m_issueGeneratorRegistry(std::make_unique<IssueGeneratorRegistry>()),
         m_nodeTree(std::make_unique<NodeTree>()),
-        m_updateNodeTree(true) {
+        m_updateNodeTree(true),
+        m_updateAttributableIndex(true) {
             addOrUpdateAttribute(AttributeNames::Classname, AttributeValues::WorldspawnClassname);
             createDefaultLayer();
         }
@@ -188,6 +189,40 @@ namespace TrenchBroom {
             m_nodeTree->clearAndBuild(collect.nodes(), [](const auto* node){ return node->physicalBounds(); });
         }
 
+        class WorldNode::CollectAttributableNodes : public NodeVisitor {
+        private:
+            std::vector<AttributableNode*> m_nodes;
+        public:
+            const std::vector<AttributableNode*>& nodes() const { return m_nodes; }
+        private:
+            void doVisit(WorldNode* world) override   { m_nodes.push_back(world); }
+            void doVisit(LayerNode* layer) override   { m_nodes.push_back(layer); }
+            void doVisit(GroupNode* group) override   { m_nodes.push_back(group); }
+            void doVisit(EntityNode* entity) override { m_nodes.push_back(entity); }
+            void doVisit(BrushNode*) override         {}
+        };
+
+        void WorldNode::disableAttributableIndexUpdates() {
+            m_updateAttributableIndex = false;
+        }
+
+        void WorldNode::enableAttributableIndexUpdates() {
+            if (m_updateAttributableIndex) {
+                return;
+            }
+
+            CollectAttributableNodes collect;
+            acceptAndRecurse(collect);
+
+            m_attributableIndex->clear();
+            m_attributableIndex->addAttributableNodes(collect.nodes());
+            m_updateAttributableIndex = true;
+
+            for (auto* node : collect.nodes()) {
+                node->addAllTargetLinks();
+            }
+        }
+
         class WorldNode::InvalidateAllIssuesVisitor : public NodeVisitor {
         private:
             void doVisit(WorldNode* world) override   { invalidateIssues(world);  }
@@ -335,21 +370,31 @@ namespace TrenchBroom {
         }
 
         void WorldNode::doFindAttributableNodesWithAttribute(const std::string& name, const std::string& value, std::vector<Model::AttributableNode*>& result) const {
+            if (!m_updateAttributableIndex) {
+                return;
+            }
             kdl::vec_append(result,
                 m_attributableIndex->findAttributableNodes(AttributableNodeIndexQuery::exact(name), value));
         }
 
         void WorldNode::doFindAttributableNodesWithNumberedAttribute(const std::string& prefix, const std::string& value, std::vector<Model::AttributableNode*>& result) const {
+            if (!m_updateAttributableIndex) {
+                return;
+            }
             kdl::vec_append(result,
                 m_attributableIndex->findAttributableNodes(AttributableNodeIndexQuery::numbered(prefix), value));
         }
 
         void WorldNode::doAddToIndex(AttributableNode* attributable, const std::string& name, const std::string& value) {
-            m_attributableIndex->addAttribute(attributable, name, value);
+            if (m_updateAttributableIndex) {
+                m_attributableIndex->addAttribute(attributable, name, value);
+            }
         }
 
         void WorldNode::doRemoveFromIndex(AttributableNode* attributable, const std::string& name, const std::string& value) {
-            m_attributableIndex->removeAttribute(attributable, name, value);
+            if (m_updateAttributableIndex) {
+                m_attributableIndex->removeAttribute(attributable, name, value);
+            }
         }
 
         void WorldNode::doAttributesDidChange(const vm::bbox3& /* oldBounds */) {}
@@ -54,6 +54,7 @@ namespace TrenchBroom {
             using NodeTree = AABBTree<FloatType, 3, Node*>;
             std::unique_ptr<NodeTree> m_nodeTree;
             bool m_updateNodeTree;
+            bool m_updateAttributableIndex;
         public:
             WorldNode(MapFormat mapFormat);
             ~WorldNode() override;
@@ -94,6 +95,22 @@ namespace TrenchBroom {
             void disableNodeTreeUpdates();
             void enableNodeTreeUpdates();
             void rebuildNodeTree();
+        private:
+            class CollectAttributableNodes;
+        public: // attributable node index bulk updating
+            /**
+             * Stops adding attributes to the attributable node index. While the index is disabled, no links between
+             * attributable nodes are established.
+             */
+            void disableAttributableIndexUpdates();
+
+            /**
+             * Rebuilds the attributable node index from all attributable nodes in this world at once, links them and
+             * resumes updating the index incrementally.
+             *
+             * Precondition: attributable index updates were disabled before any node with link attributes was added
+             */
+            void enableAttributableIndexUpdates();
         private:
             class InvalidateAllIssuesVisitor;
             void invalidateAllIssues();
@@ -133,6 +133,8 @@ namespace TrenchBroom {
 
         Preference<bool> TextureLock(IO::Path("Editor/Texture lock"), true);
         Preference<bool> UVLock(IO::Path("Editor/UV lock"), false);
+        Preference<int> UndoMemoryBudget(IO::Path("Editor/Undo memory budget (MB, 0 = unlimited)"), 0);
+        Preference<int> FileCacheCapacity(IO::Path("Editor/File cache capacity (MB, 0 = unlimited)"), 64);
 
         Preference<IO::Path>& RendererFontPath() {
             static Preference<IO::Path> fontPath(IO::Path("Renderer/Font name"), IO::Path("fonts/SourceSansPro-Regular.otf"));
@@ -261,6 +263,8 @@ namespace TrenchBroom {
                 &TextureMagFilter,
                 &TextureLock,
                 &UVLock,
+                &UndoMemoryBudget,
+                &FileCacheCapacity,
                 &RendererFontPath(),
                 &RendererFontSize,
                 &BrowserFontSize,
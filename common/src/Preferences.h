@@ -127,6 +127,10 @@ namespace TrenchBroom {
 
         extern Preference<bool> TextureLock;
         extern Preference<bool> UVLock;
+        /** The maximum memory used by the undo and redo history in megabytes, or 0 for no limit (the default). */
+        extern Preference<int> UndoMemoryBudget;
+        /** The maximum memory used by the cache of decompressed archive entries in megabytes, or 0 for no limit. */
+        extern Preference<int> FileCacheCapacity;
 
         Preference<IO::Path>& RendererFontPath();
         extern Preference<int> RendererFontSize;
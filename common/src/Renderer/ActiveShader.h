@@ -40,6 +40,15 @@ namespace TrenchBroom {
             void set(const std::string& name, const T& value) {
                 m_program.set(name, value);
             }
+
+            template <class T>
+            void setAttribute(const std::string& name, const T& value) {
+                m_program.setAttribute(name, value);
+            }
+
+            GLint findAttributeLocation(const std::string& name) const {
+                return m_program.findAttributeLocation(name);
+            }
         };
     }
 }
@@ -29,9 +29,14 @@
 #include "Model/TagAttribute.h"
 #include "Renderer/BrushRendererArrays.h"
 #include "Renderer/BrushRendererBrushCache.h"
+#include "Renderer/Camera.h"
 #include "Renderer/RenderContext.h"
 
+#include <vecmath/bbox.h>
+#include <vecmath/vec.h>
+
 #include <cassert>
+#include <cmath>
 #include <cstring>
 #include <vector>
 
@@ -125,6 +130,21 @@ namespace TrenchBroom {
 
         // BrushRenderer
 
+        const FloatType BrushRenderer::ChunkSize = 1024.0;
+
+        BrushRenderer::Chunk::Chunk() :
+        brushCount(0u),
+        vertexArray(std::make_shared<BrushVertexArray>()),
+        edgeIndices(std::make_shared<BrushIndexArray>()),
+        transparentFaces(std::make_shared<TextureToBrushIndicesMap>()),
+        opaqueFaces(std::make_shared<TextureToBrushIndicesMap>()) {}
+
+        void BrushRenderer::Chunk::updateRenderers(const Color& faceColor) {
+            opaqueFaceRenderer = FaceRenderer(vertexArray, opaqueFaces, faceColor);
+            transparentFaceRenderer = FaceRenderer(vertexArray, transparentFaces, faceColor);
+            edgeRenderer = IndexedEdgeRenderer(vertexArray, edgeIndices);
+        }
+
         BrushRenderer::BrushRenderer() :
         m_filter(std::make_unique<NoFilter>()),
         m_showEdges(false),
@@ -172,8 +192,11 @@ namespace TrenchBroom {
             m_invalidBrushes = m_allBrushes;
 
             assert(m_brushInfo.empty());
-            assert(m_transparentFaces->empty());
-            assert(m_opaqueFaces->empty());
+            for ([[maybe_unused]] const auto& entry : m_chunks) {
+                assert(entry.second->brushCount == 0u);
+                assert(entry.second->transparentFaces->empty());
+                assert(entry.second->opaqueFaces->empty());
+            }
         }
 
         void BrushRenderer::invalidateBrushes(const std::vector<Model::BrushNode*>& brushes) {
@@ -199,15 +222,7 @@ namespace TrenchBroom {
             m_brushInfo.clear();
             m_allBrushes.clear();
             m_invalidBrushes.clear();
-
-            m_vertexArray = std::make_shared<BrushVertexArray>();
-            m_edgeIndices = std::make_shared<BrushIndexArray>();
-            m_transparentFaces = std::make_shared<TextureToBrushIndicesMap>();
-            m_opaqueFaces = std::make_shared<TextureToBrushIndicesMap>();
-
-            m_opaqueFaceRenderer = FaceRenderer(m_vertexArray, m_opaqueFaces, m_faceColor);
-            m_transparentFaceRenderer = FaceRenderer(m_vertexArray, m_transparentFaces, m_faceColor);
-            m_edgeRenderer = IndexedEdgeRenderer(m_vertexArray, m_edgeIndices);
+            m_chunks.clear();
         }
 
         void BrushRenderer::setFaceColor(const Color& faceColor) {
@@ -273,11 +288,12 @@ namespace TrenchBroom {
                 if (!valid()) {
                     validate();
                 }
+                const auto chunks = visibleChunks(renderContext);
                 if (renderContext.showFaces()) {
-                    renderOpaqueFaces(renderBatch);
+                    renderOpaqueFaces(chunks, renderBatch);
                 }
                 if (renderContext.showEdges() || m_showEdges) {
-                    renderEdges(renderBatch);
+                    renderEdges(chunks, renderBatch);
                 }
             }
         }
@@ -288,31 +304,57 @@ namespace TrenchBroom {
                     validate();
                 }
                 if (renderContext.showFaces()) {
-                    renderTransparentFaces(renderBatch);
+                    renderTransparentFaces(visibleChunks(renderContext), renderBatch);
                 }
             }
         }
 
-        void BrushRenderer::renderOpaqueFaces(RenderBatch& renderBatch) {
-            m_opaqueFaceRenderer.setGrayscale(m_grayscale);
-            m_opaqueFaceRenderer.setTint(m_tint);
-            m_opaqueFaceRenderer.setTintColor(m_tintColor);
-            m_opaqueFaceRenderer.render(renderBatch);
+        std::vector<BrushRenderer::Chunk*> BrushRenderer::visibleChunks(const RenderContext& renderContext) const {
+            const Camera& camera = renderContext.camera();
+
+            std::vector<Chunk*> result;
+            result.reserve(m_chunks.size());
+            for (const auto& entry : m_chunks) {
+                const auto& chunk = entry.second;
+                if (camera.intersectsFrustum(vm::bbox3f(chunk->bounds))) {
+                    result.push_back(chunk.get());
+                }
+            }
+            return result;
         }
 
-        void BrushRenderer::renderTransparentFaces(RenderBatch& renderBatch) {
-            m_transparentFaceRenderer.setGrayscale(m_grayscale);
-            m_transparentFaceRenderer.setTint(m_tint);
-            m_transparentFaceRenderer.setTintColor(m_tintColor);
-            m_transparentFaceRenderer.setAlpha(m_transparencyAlpha);
-            m_transparentFaceRenderer.render(renderBatch);
+        void BrushRenderer::renderOpaqueFaces(const std::vector<Chunk*>& chunks, RenderBatch& renderBatch) {
+            for (Chunk* chunk : chunks) {
+                if (!chunk->opaqueFaces->empty()) {
+                    chunk->opaqueFaceRenderer.setGrayscale(m_grayscale);
+                    chunk->opaqueFaceRenderer.setTint(m_tint);
+                    chunk->opaqueFaceRenderer.setTintColor(m_tintColor);
+                    chunk->opaqueFaceRenderer.render(renderBatch);
+                }
+            }
         }
 
-        void BrushRenderer::renderEdges(RenderBatch& renderBatch) {
-            if (m_showOccludedEdges) {
-                m_edgeRenderer.renderOnTop(renderBatch, m_occludedEdgeColor);
+        void BrushRenderer::renderTransparentFaces(const std::vector<Chunk*>& chunks, RenderBatch& renderBatch) {
+            for (Chunk* chunk : chunks) {
+                if (!chunk->transparentFaces->empty()) {
+                    chunk->transparentFaceRenderer.setGrayscale(m_grayscale);
+                    chunk->transparentFaceRenderer.setTint(m_tint);
+                    chunk->transparentFaceRenderer.setTintColor(m_tintColor);
+                    chunk->transparentFaceRenderer.setAlpha(m_transparencyAlpha);
+                    chunk->transparentFaceRenderer.render(renderBatch);
+                }
+            }
+        }
+
+        void BrushRenderer::renderEdges(const std::vector<Chunk*>& chunks, RenderBatch& renderBatch) {
+            for (Chunk* chunk : chunks) {
+                if (chunk->edgeIndices->hasValidIndices()) {
+                    if (m_showOccludedEdges) {
+                        chunk->edgeRenderer.renderOnTop(renderBatch, m_occludedEdgeColor);
+                    }
+                    chunk->edgeRenderer.render(renderBatch, m_edgeColor);
+                }
             }
-            m_edgeRenderer.render(renderBatch, m_edgeColor);
         }
 
         class BrushRenderer::FilterWrapper : public BrushRenderer::Filter {
@@ -347,9 +389,14 @@ namespace TrenchBroom {
             m_invalidBrushes.clear();
             assert(valid());
 
-            m_opaqueFaceRenderer = FaceRenderer(m_vertexArray, m_opaqueFaces, m_faceColor);
-            m_transparentFaceRenderer = FaceRenderer(m_vertexArray, m_transparentFaces, m_faceColor);
-            m_edgeRenderer = IndexedEdgeRenderer(m_vertexArray, m_edgeIndices);
+            for (auto it = std::begin(m_chunks); it != std::end(m_chunks);) {
+                if (it->second->brushCount == 0u) {
+                    it = m_chunks.erase(it);
+                } else {
+                    it->second->updateRenderers(m_faceColor);
+                    ++it;
+                }
+            }
         }
 
         static size_t triIndicesCountForPolygon(const size_t vertexCount) {
@@ -438,6 +485,29 @@ namespace TrenchBroom {
             return false;
         }
 
+        BrushRenderer::Chunk& BrushRenderer::chunkForBrush(const Model::BrushNode* brush) {
+            const vm::bbox3& bounds = brush->logicalBounds();
+            const vm::vec3 center = bounds.center();
+            const auto key = ChunkKey(
+                static_cast<long>(std::floor(center.x() / ChunkSize)),
+                static_cast<long>(std::floor(center.y() / ChunkSize)),
+                static_cast<long>(std::floor(center.z() / ChunkSize)));
+
+            auto& chunk = m_chunks[key];
+            if (chunk == nullptr) {
+                chunk = std::make_unique<Chunk>();
+            }
+
+            if (chunk->brushCount == 0u) {
+                chunk->bounds = bounds;
+            } else {
+                chunk->bounds = vm::merge(chunk->bounds, bounds);
+            }
+            ++chunk->brushCount;
+
+            return *chunk;
+        }
+
         void BrushRenderer::validateBrush(const Model::BrushNode* brush) {
             assert(m_allBrushes.find(brush) != std::end(m_allBrushes));
             assert(m_invalidBrushes.find(brush) != std::end(m_invalidBrushes));
@@ -456,6 +526,8 @@ namespace TrenchBroom {
             }
 
             BrushInfo& info = m_brushInfo[brush];
+            Chunk& chunk = chunkForBrush(brush);
+            info.chunk = &chunk;
 
             // collect vertices
             auto& brushCache = brush->brushRendererBrushCache();
@@ -463,8 +535,7 @@ namespace TrenchBroom {
             const auto& cachedVertices = brushCache.cachedVertices();
             ensure(!cachedVertices.empty(), "Brush must have cached vertices");
 
-            assert(m_vertexArray != nullptr);
-            auto [vertBlock, dest] = m_vertexArray->getPointerToInsertVerticesAt(cachedVertices.size());
+            auto [vertBlock, dest] = chunk.vertexArray->getPointerToInsertVerticesAt(cachedVertices.size());
             std::memcpy(dest, cachedVertices.data(), cachedVertices.size() * sizeof(*dest));
             info.vertexHolderKey = vertBlock;
 
@@ -474,7 +545,7 @@ namespace TrenchBroom {
             {
                 const size_t edgeIndexCount = countMarkedEdgeIndices(brush, edgePolicy);
                 if (edgeIndexCount > 0) {
-                    auto [key, insertDest] = m_edgeIndices->getPointerToInsertElementsAt(edgeIndexCount);
+                    auto [key, insertDest] = chunk.edgeIndices->getPointerToInsertElementsAt(edgeIndexCount);
                     info.edgeIndicesKey = key;
                     getMarkedEdgeIndices(brush, edgePolicy, brushVerticesStartIndex, insertDest);
                 } else {
@@ -514,7 +585,7 @@ namespace TrenchBroom {
                 }
 
                 if (transparentIndexCount > 0) {
-                    TextureToBrushIndicesMap& faceVboMap = *m_transparentFaces;
+                    TextureToBrushIndicesMap& faceVboMap = *chunk.transparentFaces;
                     auto& holderPtr = faceVboMap[texture];
                     if (holderPtr == nullptr) {
                         // inserts into map!
@@ -541,7 +612,7 @@ namespace TrenchBroom {
                 }
 
                 if (opaqueIndexCount > 0) {
-                    TextureToBrushIndicesMap& faceVboMap = *m_opaqueFaces;
+                    TextureToBrushIndicesMap& faceVboMap = *chunk.opaqueFaces;
                     auto& holderPtr = faceVboMap[texture];
                     if (holderPtr == nullptr) {
                         // inserts into map!
@@ -601,29 +672,32 @@ namespace TrenchBroom {
             }
 
             const BrushInfo& info = it->second;
+            Chunk& chunk = *info.chunk;
+            assert(chunk.brushCount > 0u);
+            --chunk.brushCount;
 
             // update Vbo's
-            m_vertexArray->deleteVerticesWithKey(info.vertexHolderKey);
+            chunk.vertexArray->deleteVerticesWithKey(info.vertexHolderKey);
             if (info.edgeIndicesKey != nullptr) {
-                m_edgeIndices->zeroElementsWithKey(info.edgeIndicesKey);
+                chunk.edgeIndices->zeroElementsWithKey(info.edgeIndicesKey);
             }
 
             for (const auto& [texture, opaqueKey] : info.opaqueFaceIndicesKeys) {
-                std::shared_ptr<BrushIndexArray> faceIndexHolder = m_opaqueFaces->at(texture);
+                std::shared_ptr<BrushIndexArray> faceIndexHolder = chunk.opaqueFaces->at(texture);
                 faceIndexHolder->zeroElementsWithKey(opaqueKey);
 
                 if (!faceIndexHolder->hasValidIndices()) {
                     // There are no indices left to render for this texture, so delete the <Texture, BrushIndexArray> entry from the map
-                    m_opaqueFaces->erase(texture);
+                    chunk.opaqueFaces->erase(texture);
                 }
             }
             for (const auto& [texture, transparentKey] : info.transparentFaceIndicesKeys) {
-                std::shared_ptr<BrushIndexArray> faceIndexHolder = m_transparentFaces->at(texture);
+                std::shared_ptr<BrushIndexArray> faceIndexHolder = chunk.transparentFaces->at(texture);
                 faceIndexHolder->zeroElementsWithKey(transparentKey);
 
                 if (!faceIndexHolder->hasValidIndices()) {
                     // There are no indices left to render for this texture, so delete the <Texture, BrushIndexArray> entry from the map
-                    m_transparentFaces->erase(texture);
+                    chunk.transparentFaces->erase(texture);
                 }
             }
 
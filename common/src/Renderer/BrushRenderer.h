@@ -21,11 +21,15 @@
 #define TrenchBroom_BrushRenderer
 
 #include "Color.h"
+#include "FloatType.h"
 #include "Model/BrushGeometry.h"
 #include "Renderer/AllocationTracker.h"
 #include "Renderer/EdgeRenderer.h"
 #include "Renderer/FaceRenderer.h"
 
+#include <vecmath/bbox.h>
+
+#include <map>
 #include <memory>
 #include <tuple>
 #include <unordered_map>
@@ -118,7 +122,44 @@ namespace TrenchBroom {
         private:
             std::unique_ptr<Filter> m_filter;
 
+            using TextureToBrushIndicesMap = std::unordered_map<const Assets::Texture*, std::shared_ptr<BrushIndexArray>>;
+
+            /**
+             * The brushes are distributed over chunks according to the grid cell of size ChunkSize that contains the
+             * center of their bounds. Every chunk has its own vertex and index arrays, so that the chunks which are
+             * not within the camera frustum can be skipped when rendering.
+             */
+            struct Chunk {
+                /**
+                 * The union of the bounds of all brushes that were added to this chunk since it became empty. It is
+                 * not shrunk when brushes are removed, so it may be larger than necessary.
+                 */
+                vm::bbox3 bounds;
+                size_t brushCount;
+
+                std::shared_ptr<BrushVertexArray> vertexArray;
+                std::shared_ptr<BrushIndexArray> edgeIndices;
+                std::shared_ptr<TextureToBrushIndicesMap> transparentFaces;
+                std::shared_ptr<TextureToBrushIndicesMap> opaqueFaces;
+
+                FaceRenderer opaqueFaceRenderer;
+                FaceRenderer transparentFaceRenderer;
+                IndexedEdgeRenderer edgeRenderer;
+
+                Chunk();
+                void updateRenderers(const Color& faceColor);
+            };
+
+            using ChunkKey = std::tuple<long, long, long>;
+            static const FloatType ChunkSize;
+
+            /**
+             * The chunks are owned here because the renderers they contain are added to render batches by pointer.
+             */
+            std::map<ChunkKey, std::unique_ptr<Chunk>> m_chunks;
+
             struct BrushInfo {
+                Chunk* chunk;
                 AllocationTracker::Block* vertexHolderKey;
                 AllocationTracker::Block* edgeIndicesKey;
                 std::vector<std::pair<const Assets::Texture*, AllocationTracker::Block*>> opaqueFaceIndicesKeys;
@@ -139,17 +180,6 @@ namespace TrenchBroom {
             std::unordered_set<const Model::BrushNode*> m_allBrushes;
             std::unordered_set<const Model::BrushNode*> m_invalidBrushes;
 
-            std::shared_ptr<BrushVertexArray> m_vertexArray;
-            std::shared_ptr<BrushIndexArray> m_edgeIndices;
-
-            using TextureToBrushIndicesMap = std::unordered_map<const Assets::Texture*, std::shared_ptr<BrushIndexArray>>;
-            std::shared_ptr<TextureToBrushIndicesMap> m_transparentFaces;
-            std::shared_ptr<TextureToBrushIndicesMap> m_opaqueFaces;
-
-            FaceRenderer m_opaqueFaceRenderer;
-            FaceRenderer m_transparentFaceRenderer;
-            IndexedEdgeRenderer m_edgeRenderer;
-
             Color m_faceColor;
             bool m_showEdges;
             Color m_edgeColor;
@@ -271,9 +301,10 @@ namespace TrenchBroom {
             void renderOpaque(RenderContext& renderContext, RenderBatch& renderBatch);
             void renderTransparent(RenderContext& renderContext, RenderBatch& renderBatch);
         private:
-            void renderOpaqueFaces(RenderBatch& renderBatch);
-            void renderTransparentFaces(RenderBatch& renderBatch);
-            void renderEdges(RenderBatch& renderBatch);
+            std::vector<Chunk*> visibleChunks(const RenderContext& renderContext) const;
+            void renderOpaqueFaces(const std::vector<Chunk*>& chunks, RenderBatch& renderBatch);
+            void renderTransparentFaces(const std::vector<Chunk*>& chunks, RenderBatch& renderBatch);
+            void renderEdges(const std::vector<Chunk*>& chunks, RenderBatch& renderBatch);
 
         public:
             /**
@@ -282,6 +313,7 @@ namespace TrenchBroom {
             void validate();
         private:
             bool shouldDrawFaceInTransparentPass(const Model::BrushNode* brush, const Model::BrushFace& face) const;
+            Chunk& chunkForBrush(const Model::BrushNode* brush);
             void validateBrush(const Model::BrushNode* brush);
             void addBrush(const Model::BrushNode* brush);
             void removeBrush(const Model::BrushNode* brush);
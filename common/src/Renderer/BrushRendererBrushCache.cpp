@@ -80,7 +80,8 @@ namespace TrenchBroom {
                     // Set the vertex payload to the index, relative to the brush's first vertex being 0.
                     // This is used below when building the edge cache.
                     // NOTE: we'll overwrite the payload as we visit the same vertex several times while visiting
-                    // different faces, this is fine.
+                    // different faces, this is fine. The geometry may be shared with copies of this brush, e.g. in
+                    // undo snapshots, but they never read the vertex payloads.
                     const auto currentIndex = m_cachedVertices.size();
                     vertex->setPayload(static_cast<GLuint>(currentIndex));
 
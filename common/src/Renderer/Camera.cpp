@@ -21,6 +21,8 @@
 
 #include "Macros.h"
 
+#include <vecmath/bbox.h>
+#include <vecmath/plane.h>
 #include <vecmath/ray.h>
 #include <vecmath/distance.h>
 #include <vecmath/intersection.h>
@@ -152,6 +154,23 @@ namespace TrenchBroom {
             doComputeFrustumPlanes(top, right, bottom, left);
         }
 
+        bool Camera::intersectsFrustum(const vm::bbox3f& bounds) const {
+            vm::plane3f planes[4];
+            frustumPlanes(planes[0], planes[1], planes[2], planes[3]);
+
+            for (const auto& plane : planes) {
+                // the corner of the bounds which lies furthest in the direction opposite to the plane normal
+                vm::vec3f corner;
+                for (size_t i = 0; i < 3; ++i) {
+                    corner[i] = plane.normal[i] > 0.0f ? bounds.min[i] : bounds.max[i];
+                }
+                if (plane.point_distance(corner) > 0.0f) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
         vm::ray3f Camera::viewRay() const {
             return vm::ray3f(m_position, m_direction);
         }
@@ -108,6 +108,12 @@ namespace TrenchBroom {
             const vm::mat4x4f orthogonalBillboardMatrix() const;
             const vm::mat4x4f verticalBillboardMatrix() const;
             void frustumPlanes(vm::plane3f& topPlane, vm::plane3f& rightPlane, vm::plane3f& bottomPlane, vm::plane3f& leftPlane) const;
+            /**
+             * Checks whether the given bounds intersect the frustum of this camera, ignoring the near and far planes.
+             * This is a conservative test: it may return true for bounds that are not visible, but never returns false
+             * for bounds that are.
+             */
+            bool intersectsFrustum(const vm::bbox3f& bounds) const;
 
             vm::ray3f viewRay() const;
             vm::ray3f pickRay(int x, int y) const;
@@ -36,9 +36,12 @@
 #include "View/MapDocument.h"
 
 #include <kdl/memory_utils.h>
+#include <kdl/parallel.h>
+#include <kdl/vector_utils.h>
 
 #include <vecmath/vec.h>
 
+#include <algorithm>
 #include <cassert>
 #include <set>
 #include <vector>
@@ -49,6 +52,7 @@ namespace TrenchBroom {
         m_document(document),
         m_defaultColor(0.5f, 1.0f, 0.5f, 1.0f),
         m_selectedColor(1.0f, 0.0f, 0.0f, 1.0f),
+        m_linkGraphValid(false),
         m_valid(false) {}
 
         void EntityLinkRenderer::setDefaultColor(const Color& color) {
@@ -73,6 +77,104 @@ namespace TrenchBroom {
             m_valid = false;
         }
 
+        void EntityLinkRenderer::invalidateLinkGraph() {
+            m_linkTargets.clear();
+            m_linkSources.clear();
+            m_linkGraphValid = false;
+            invalidate();
+        }
+
+        class EntityLinkRenderer::MatchEntities {
+        public:
+            bool operator()(const Model::EntityNode*) { return true; }
+            bool operator()(const Model::Node*) { return false; }
+        };
+
+        class EntityLinkRenderer::CollectEntitiesVisitor : public Model::CollectMatchingNodesVisitor<MatchEntities, Model::UniqueNodeCollectionStrategy> {};
+
+        static std::vector<const Model::AttributableNode*> collectLinkTargets(const Model::AttributableNode* source) {
+            // only entities are rendered as link sources
+            if (dynamic_cast<const Model::EntityNode*>(source) == nullptr) {
+                return {};
+            }
+
+            std::vector<const Model::AttributableNode*> result;
+            result.reserve(source->linkTargets().size() + source->killTargets().size());
+            result.insert(std::end(result), std::begin(source->linkTargets()), std::end(source->linkTargets()));
+            result.insert(std::end(result), std::begin(source->killTargets()), std::end(source->killTargets()));
+            return result;
+        }
+
+        class EntityLinkRenderer::CollectLinkedEntitiesVisitor : public Model::NodeVisitor {
+        private:
+            bool m_recurseIntoLayers;
+            std::vector<const Model::EntityNode*> m_entities;
+        public:
+            explicit CollectLinkedEntitiesVisitor(const bool recurseIntoLayers) :
+            m_recurseIntoLayers(recurseIntoLayers) {}
+
+            const std::vector<const Model::EntityNode*>& entities() const {
+                return m_entities;
+            }
+        private:
+            void doVisit(Model::WorldNode*) override {
+                if (!m_recurseIntoLayers) {
+                    stopRecursion();
+                }
+            }
+
+            void doVisit(Model::LayerNode*) override {
+                if (!m_recurseIntoLayers) {
+                    stopRecursion();
+                }
+            }
+
+            void doVisit(Model::GroupNode*) override {}
+            void doVisit(Model::BrushNode*) override {}
+
+            void doVisit(Model::EntityNode* entity) override {
+                m_entities.push_back(entity);
+                stopRecursion();
+            }
+        };
+
+        void EntityLinkRenderer::updateLinkGraphForAddedOrRemovedNodes(const std::vector<Model::Node*>& nodes) {
+            updateLinkGraph(nodes, true);
+        }
+
+        void EntityLinkRenderer::updateLinkGraphForChangedNodes(const std::vector<Model::Node*>& nodes) {
+            updateLinkGraph(nodes, false);
+        }
+
+        void EntityLinkRenderer::updateLinkGraph(const std::vector<Model::Node*>& nodes, const bool recurseIntoLayers) {
+            invalidate();
+            if (!m_linkGraphValid) {
+                return;
+            }
+
+            CollectLinkedEntitiesVisitor collectEntities(recurseIntoLayers);
+            Model::Node::acceptAndRecurse(std::begin(nodes), std::end(nodes), collectEntities);
+
+            // Every link that was added or removed has one of the given entities as its source or its target, so it
+            // suffices to update the targets of these entities and of their previous and current sources.
+            std::vector<const Model::AttributableNode*> affectedSources;
+            for (const auto* entity : collectEntities.entities()) {
+                affectedSources.push_back(entity);
+
+                const auto previousSources = m_linkSources.find(entity);
+                if (previousSources != std::end(m_linkSources)) {
+                    kdl::vec_append(affectedSources, previousSources->second);
+                }
+                affectedSources.insert(std::end(affectedSources), std::begin(entity->linkSources()), std::end(entity->linkSources()));
+                affectedSources.insert(std::end(affectedSources), std::begin(entity->killSources()), std::end(entity->killSources()));
+            }
+            kdl::vec_sort_and_remove_duplicates(affectedSources);
+
+            for (const auto* source : affectedSources) {
+                setLinkTargets(source, collectLinkTargets(source));
+            }
+        }
+
         void EntityLinkRenderer::doPrepareVertices(VboManager& vboManager) {
             if (!m_valid) {
                 validate();
@@ -131,53 +233,132 @@ namespace TrenchBroom {
             m_valid = true;
         }
 
+        void EntityLinkRenderer::validateLinkGraph() {
+            if (m_linkGraphValid) {
+                return;
+            }
+
+            m_linkTargets.clear();
+            m_linkSources.clear();
+
+            auto document = kdl::mem_lock(m_document);
+            Model::WorldNode* world = document->world();
+            if (world != nullptr) {
+                CollectLinkedEntitiesVisitor collectEntities(true);
+                world->acceptAndRecurse(collectEntities);
+
+                for (const auto* entity : collectEntities.entities()) {
+                    setLinkTargets(entity, collectLinkTargets(entity));
+                }
+            }
+
+            m_linkGraphValid = true;
+        }
+
+        void EntityLinkRenderer::setLinkTargets(const Model::AttributableNode* source, std::vector<const Model::AttributableNode*> targets) {
+            auto previousTargets = m_linkTargets.find(source);
+            if (previousTargets != std::end(m_linkTargets)) {
+                for (const auto* target : previousTargets->second) {
+                    auto sources = m_linkSources.find(target);
+                    assert(sources != std::end(m_linkSources));
+
+                    // a source can link to the same target more than once, so only remove one occurrence
+                    auto& sourcesOfTarget = sources->second;
+                    const auto it = std::find(std::begin(sourcesOfTarget), std::end(sourcesOfTarget), source);
+                    assert(it != std::end(sourcesOfTarget));
+                    sourcesOfTarget.erase(it);
+                    if (sourcesOfTarget.empty()) {
+                        m_linkSources.erase(sources);
+                    }
+                }
+                m_linkTargets.erase(previousTargets);
+            }
+
+            if (!targets.empty()) {
+                for (const auto* target : targets) {
+                    m_linkSources[target].push_back(source);
+                }
+                m_linkTargets.emplace(source, std::move(targets));
+            }
+        }
+
         void EntityLinkRenderer::getArrows(std::vector<ArrowVertex>& arrows, const std::vector<Vertex>& links) {
             assert((links.size() % 2) == 0);
-            for (size_t i = 0; i < links.size(); i += 2) {
-                const auto& startVertex = links[i];
-                const auto& endVertex = links[i + 1];
+            const auto linkCount = links.size() / 2u;
+
+            // determine where the arrows of each link start so that the arrows can be generated in parallel
+            std::vector<size_t> offsets;
+            offsets.reserve(linkCount + 1u);
+            offsets.push_back(arrows.size());
+            for (size_t i = 0; i < linkCount; ++i) {
+                offsets.push_back(offsets.back() + 4u * arrowCount(links[2u * i], links[2u * i + 1u]));
+            }
+            arrows.resize(offsets.back());
+
+            static const size_t MinLinkCountForParallelGeneration = 256u;
+            const auto numThreads = linkCount < MinLinkCountForParallelGeneration ? 1u : kdl::parallel_thread_count();
+
+            kdl::parallel_for(linkCount, [&](const size_t i) {
+                const auto& startVertex = links[2u * i];
+                const auto& endVertex = links[2u * i + 1u];
 
                 const auto lineVec = (getVertexComponent<0>(endVertex) - getVertexComponent<0>(startVertex));
                 const auto lineLength = length(lineVec);
                 const auto lineDir = lineVec / lineLength;
                 const auto color = getVertexComponent<1>(startVertex);
 
+                auto* out = arrows.data() + offsets[i];
                 if (lineLength < 512) {
                     const auto arrowPosition = getVertexComponent<0>(startVertex) + (lineVec * 0.6f);
-                    addArrow(arrows, color, arrowPosition, lineDir);
+                    out = addArrow(out, color, arrowPosition, lineDir);
                 } else if (lineLength < 1024) {
                     const auto arrowPosition1 = getVertexComponent<0>(startVertex) + (lineVec * 0.2f);
                     const auto arrowPosition2 = getVertexComponent<0>(startVertex) + (lineVec * 0.6f);
 
-                    addArrow(arrows, color, arrowPosition1, lineDir);
-                    addArrow(arrows, color, arrowPosition2, lineDir);
+                    out = addArrow(out, color, arrowPosition1, lineDir);
+                    out = addArrow(out, color, arrowPosition2, lineDir);
                 } else {
                     const auto arrowPosition1 = getVertexComponent<0>(startVertex) + (lineVec * 0.1f);
                     const auto arrowPosition2 = getVertexComponent<0>(startVertex) + (lineVec * 0.4f);
                     const auto arrowPosition3 = getVertexComponent<0>(startVertex) + (lineVec * 0.7f);
 
-                    addArrow(arrows, color, arrowPosition1, lineDir);
-                    addArrow(arrows, color, arrowPosition2, lineDir);
-                    addArrow(arrows, color, arrowPosition3, lineDir);
+                    out = addArrow(out, color, arrowPosition1, lineDir);
+                    out = addArrow(out, color, arrowPosition2, lineDir);
+                    out = addArrow(out, color, arrowPosition3, lineDir);
                 }
+                assert(out == arrows.data() + offsets[i + 1u]);
+                unused(out);
+            }, numThreads);
+        }
+
+        size_t EntityLinkRenderer::arrowCount(const Vertex& startVertex, const Vertex& endVertex) {
+            const auto lineLength = length(getVertexComponent<0>(endVertex) - getVertexComponent<0>(startVertex));
+            if (lineLength < 512) {
+                return 1u;
+            } else if (lineLength < 1024) {
+                return 2u;
+            } else {
+                return 3u;
             }
         }
 
-        void EntityLinkRenderer::addArrow(std::vector<ArrowVertex>& arrows, const vm::vec4f& color, const vm::vec3f& arrowPosition, const vm::vec3f& lineDir) {
-            arrows.emplace_back(vm::vec3f{0, 3, 0}, color, arrowPosition, lineDir);
-            arrows.emplace_back(vm::vec3f{9, 0, 0}, color, arrowPosition, lineDir);
+        EntityLinkRenderer::ArrowVertex* EntityLinkRenderer::addArrow(ArrowVertex* arrows, const vm::vec4f& color, const vm::vec3f& arrowPosition, const vm::vec3f& lineDir) {
+            *arrows++ = ArrowVertex(vm::vec3f{0, 3, 0}, color, arrowPosition, lineDir);
+            *arrows++ = ArrowVertex(vm::vec3f{9, 0, 0}, color, arrowPosition, lineDir);
 
-            arrows.emplace_back(vm::vec3f{9, 0, 0}, color, arrowPosition, lineDir);
-            arrows.emplace_back(vm::vec3f{0,-3, 0}, color, arrowPosition, lineDir);
+            *arrows++ = ArrowVertex(vm::vec3f{9, 0, 0}, color, arrowPosition, lineDir);
+            *arrows++ = ArrowVertex(vm::vec3f{0,-3, 0}, color, arrowPosition, lineDir);
+            return arrows;
         }
 
-        class EntityLinkRenderer::MatchEntities {
-        public:
-            bool operator()(const Model::EntityNode*) { return true; }
-            bool operator()(const Model::Node*) { return false; }
-        };
+        void EntityLinkRenderer::addLink(std::vector<Vertex>& links, const Model::AttributableNode* source, const Model::AttributableNode* target, const Color& defaultColor, const Color& selectedColor) {
+            const auto anySelected = source->selected() || source->descendantSelected() || target->selected() || target->descendantSelected();
+            const auto& sourceColor = anySelected ? selectedColor : defaultColor;
+            const auto targetColor = anySelected ? selectedColor : defaultColor;
 
-        class EntityLinkRenderer::CollectEntitiesVisitor : public Model::CollectMatchingNodesVisitor<MatchEntities, Model::UniqueNodeCollectionStrategy> {};
+            links.emplace_back(vm::vec3f(source->linkSourceAnchor()), sourceColor);
+            links.emplace_back(vm::vec3f(target->linkTargetAnchor()), targetColor);
+        }
 
         class EntityLinkRenderer::CollectLinksVisitor : public Model::NodeVisitor {
         protected:
@@ -207,32 +388,7 @@ namespace TrenchBroom {
             virtual void visitEntity(Model::EntityNode* entity) = 0;
         protected:
             void addLink(const Model::AttributableNode* source, const Model::AttributableNode* target) {
-                const auto anySelected = source->selected() || source->descendantSelected() || target->selected() || target->descendantSelected();
-                const auto& sourceColor = anySelected ? m_selectedColor : m_defaultColor;
-                const auto targetColor = anySelected ? m_selectedColor : m_defaultColor;
-
-                m_links.emplace_back(vm::vec3f(source->linkSourceAnchor()), sourceColor);
-                m_links.emplace_back(vm::vec3f(target->linkTargetAnchor()), targetColor);
-            }
-        };
-
-        class EntityLinkRenderer::CollectAllLinksVisitor : public CollectLinksVisitor {
-        public:
-            CollectAllLinksVisitor(const Model::EditorContext& editorContext, const Color& defaultColor, const Color& selectedColor, std::vector<Vertex>& links) :
-            CollectLinksVisitor(editorContext, defaultColor, selectedColor, links) {}
-        private:
-            void visitEntity(Model::EntityNode* entity) override {
-                if (m_editorContext.visible(entity)) {
-                    addTargets(entity, entity->linkTargets());
-                    addTargets(entity, entity->killTargets());
-                }
-            }
-
-            void addTargets(Model::EntityNode* source, const std::vector<Model::AttributableNode*>& targets) {
-                for (const Model::AttributableNode* target : targets) {
-                    if (m_editorContext.visible(target))
-                        addLink(source, target);
-                }
+                EntityLinkRenderer::addLink(m_links, source, target, m_defaultColor, m_selectedColor);
             }
         };
 
@@ -303,7 +459,7 @@ namespace TrenchBroom {
             }
         };
 
-        void EntityLinkRenderer::getLinks(std::vector<Vertex>& links) const {
+        void EntityLinkRenderer::getLinks(std::vector<Vertex>& links) {
             auto document = kdl::mem_lock(m_document);
             const Model::EditorContext& editorContext = document->editorContext();
             switch (editorContext.entityLinkMode()) {
@@ -322,15 +478,21 @@ namespace TrenchBroom {
             }
         }
 
-        void EntityLinkRenderer::getAllLinks(std::vector<Vertex>& links) const {
+        void EntityLinkRenderer::getAllLinks(std::vector<Vertex>& links) {
+            validateLinkGraph();
+
             auto document = kdl::mem_lock(m_document);
             const Model::EditorContext& editorContext = document->editorContext();
 
-            CollectAllLinksVisitor collectLinks(editorContext, m_defaultColor, m_selectedColor, links);
-
-            Model::WorldNode* world = document->world();
-            if (world != nullptr)
-                world->acceptAndRecurse(collectLinks);
+            for (const auto& [source, targets] : m_linkTargets) {
+                if (editorContext.visible(source)) {
+                    for (const auto* target : targets) {
+                        if (editorContext.visible(target)) {
+                            addLink(links, source, target, m_defaultColor, m_selectedColor);
+                        }
+                    }
+                }
+            }
         }
 
         void EntityLinkRenderer::getTransitiveSelectedLinks(std::vector<Vertex>& links) const {
@@ -29,9 +29,15 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom {
+    namespace Model {
+        class AttributableNode;
+        class Node;
+    }
+
     namespace View {
         class MapDocument; // FIXME: Renderer should not depend on View
     }
@@ -59,6 +65,22 @@ namespace TrenchBroom {
 
             std::weak_ptr<View::MapDocument> m_document;
 
+            using LinkMap = std::unordered_map<const Model::AttributableNode*, std::vector<const Model::AttributableNode*>>;
+
+            /**
+             * Maps every entity that has link or kill targets to these targets. Together with `m_linkSources`, this
+             * forms a persistent copy of the document's link graph which is updated incrementally when nodes are added,
+             * removed or changed, so that rendering all links does not require traversing the entire map.
+             */
+            LinkMap m_linkTargets;
+
+            /**
+             * The inverse of `m_linkTargets`, mapping each link target to the entities that link to it.
+             */
+            LinkMap m_linkSources;
+
+            bool m_linkGraphValid;
+
             Color m_defaultColor;
             Color m_selectedColor;
 
@@ -73,7 +95,31 @@ namespace TrenchBroom {
             void setSelectedColor(const Color& color);
 
             void render(RenderContext& renderContext, RenderBatch& renderBatch);
+
+            /**
+             * Invalidates the rendered links, e.g. because the selection or the visibility of some nodes changed. The
+             * link graph is kept.
+             */
             void invalidate();
+
+            /**
+             * Invalidates the rendered links and discards the link graph, which will be rebuilt from scratch when the
+             * links are rendered again.
+             */
+            void invalidateLinkGraph();
+
+            /**
+             * Updates the link graph after the given nodes and their descendants were added to or removed from the
+             * document, and invalidates the rendered links.
+             */
+            void updateLinkGraphForAddedOrRemovedNodes(const std::vector<Model::Node*>& nodes);
+
+            /**
+             * Updates the link graph after the given nodes changed, and invalidates the rendered links. Changes to
+             * layers or the world are not propagated to their children since links only change if the attributes of
+             * the linked entities change.
+             */
+            void updateLinkGraphForChangedNodes(const std::vector<Model::Node*>& nodes);
         private:
             void doPrepareVertices(VboManager& vboManager) override;
             void doRender(RenderContext& renderContext) override;
@@ -82,19 +128,26 @@ namespace TrenchBroom {
         private:
             void validate();
 
+            class CollectLinkedEntitiesVisitor;
+
+            void updateLinkGraph(const std::vector<Model::Node*>& nodes, bool recurseIntoLayers);
+            void validateLinkGraph();
+            void setLinkTargets(const Model::AttributableNode* source, std::vector<const Model::AttributableNode*> targets);
+
             static void getArrows(std::vector<ArrowVertex>& arrows, const std::vector<Vertex>& links);
-            static void addArrow(std::vector<ArrowVertex>& arrows, const vm::vec4f& color, const vm::vec3f& arrowPosition, const vm::vec3f& lineDir);
+            static size_t arrowCount(const Vertex& startVertex, const Vertex& endVertex);
+            static ArrowVertex* addArrow(ArrowVertex* arrows, const vm::vec4f& color, const vm::vec3f& arrowPosition, const vm::vec3f& lineDir);
+            static void addLink(std::vector<Vertex>& links, const Model::AttributableNode* source, const Model::AttributableNode* target, const Color& defaultColor, const Color& selectedColor);
 
             class MatchEntities;
             class CollectEntitiesVisitor;
 
             class CollectLinksVisitor;
-            class CollectAllLinksVisitor;
             class CollectTransitiveSelectedLinksVisitor;
             class CollectDirectSelectedLinksVisitor;
 
-            void getLinks(std::vector<Vertex>& links) const;
-            void getAllLinks(std::vector<Vertex>& links) const;
+            void getLinks(std::vector<Vertex>& links);
+            void getAllLinks(std::vector<Vertex>& links);
             void getTransitiveSelectedLinks(std::vector<Vertex>& links) const;
             void getDirectSelectedLinks(std::vector<Vertex>& links) const;
             void collectSelectedLinks(CollectLinksVisitor& collectLinks) const;
@@ -30,26 +30,58 @@
 #include "Model/EditorContext.h"
 #include "Model/EntityNode.h"
 #include "Renderer/ActiveShader.h"
+#include "Renderer/Camera.h"
+#include "Renderer/GL.h"
 #include "Renderer/RenderBatch.h"
 #include "Renderer/RenderContext.h"
+#include "Renderer/RenderUtils.h"
 #include "Renderer/Shaders.h"
 #include "Renderer/ShaderManager.h"
 #include "Renderer/TexturedIndexRangeRenderer.h"
-#include "Renderer/Transformation.h"
+#include "Renderer/Vbo.h"
+#include "Renderer/VboManager.h"
 
+#include <vecmath/bbox.h>
 #include <vecmath/mat.h>
 
+#include <cassert>
+#include <string>
+#include <vector>
+
 namespace TrenchBroom {
     namespace Renderer {
+        static const std::string InstanceMatrixAttribute = "InstanceMatrix";
+
+        struct EntityModelRenderer::RenderFunc : public InstanceRenderFunc {
+            ActiveShader& shader;
+            const std::vector<vm::mat4x4f>& transformations;
+            const std::vector<size_t>& indices;
+
+            RenderFunc(ActiveShader& i_shader, const std::vector<vm::mat4x4f>& i_transformations, const std::vector<size_t>& i_indices) :
+            shader(i_shader),
+            transformations(i_transformations),
+            indices(i_indices) {}
+
+            void before(const size_t instance) override {
+                shader.setAttribute(InstanceMatrixAttribute, transformations[indices[instance]]);
+            }
+        };
+
         EntityModelRenderer::EntityModelRenderer(Logger& logger, Assets::EntityModelManager& entityModelManager, const Model::EditorContext& editorContext) :
         m_logger(logger),
         m_entityModelManager(entityModelManager),
         m_editorContext(editorContext),
         m_applyTinting(false),
-        m_showHiddenEntities(false) {}
+        m_showHiddenEntities(false),
+        m_vboManager(nullptr),
+        m_instanceVbo(nullptr) {}
 
         EntityModelRenderer::~EntityModelRenderer() {
             clear();
+            if (m_instanceVbo != nullptr) {
+                m_vboManager->destroyVbo(m_instanceVbo);
+                m_instanceVbo = nullptr;
+            }
         }
 
         void EntityModelRenderer::addEntity(Model::EntityNode* entity) {
@@ -58,8 +90,8 @@ namespace TrenchBroom {
             });
 
             auto* renderer = m_entityModelManager.renderer(modelSpec);
-            if (renderer != nullptr) {
-                m_entities.insert(std::make_pair(entity, renderer));
+            if (renderer != nullptr && m_entities.count(entity) == 0u) {
+                addInstance(entity, renderer);
             }
         }
 
@@ -76,18 +108,22 @@ namespace TrenchBroom {
             }
 
             if (it == std::end(m_entities)) {
-                m_entities.insert(std::make_pair(entity, renderer));
+                addInstance(entity, renderer);
             } else {
                 if (renderer == nullptr) {
-                    m_entities.erase(it);
-                } else if (it->second != renderer) {
-                    it->second = renderer;
+                    removeInstance(it);
+                } else if (it->second.renderer != renderer) {
+                    removeInstance(it);
+                    addInstance(entity, renderer);
+                } else {
+                    updateInstance(it->second);
                 }
             }
         }
 
         void EntityModelRenderer::clear() {
             m_entities.clear();
+            m_instances.clear();
         }
 
         bool EntityModelRenderer::applyTinting() const {
@@ -118,7 +154,52 @@ namespace TrenchBroom {
             renderBatch.add(this);
         }
 
+        void EntityModelRenderer::addInstance(Model::EntityNode* entity, TexturedRenderer* renderer) {
+            auto& instances = m_instances[renderer];
+            const auto index = instances.entities.size();
+            instances.entities.push_back(entity);
+            instances.transformations.push_back(vm::mat4x4f(entity->modelTransformation()));
+            instances.bounds.push_back(vm::bbox3f(entity->modelBounds()));
+
+            m_entities.insert(std::make_pair(entity, EntityInfo{ renderer, index }));
+        }
+
+        void EntityModelRenderer::removeInstance(EntityMap::iterator it) {
+            const auto info = it->second;
+            m_entities.erase(it);
+
+            auto instancesIt = m_instances.find(info.renderer);
+            assert(instancesIt != std::end(m_instances));
+
+            auto& instances = instancesIt->second;
+            const auto last = instances.entities.size() - 1u;
+            if (info.index != last) {
+                // move the last instance into the gap so that the instance arrays stay contiguous
+                auto* moved = instances.entities[last];
+                instances.entities[info.index] = moved;
+                instances.transformations[info.index] = instances.transformations[last];
+                instances.bounds[info.index] = instances.bounds[last];
+                m_entities[moved].index = info.index;
+            }
+
+            instances.entities.pop_back();
+            instances.transformations.pop_back();
+            instances.bounds.pop_back();
+
+            if (instances.entities.empty()) {
+                m_instances.erase(instancesIt);
+            }
+        }
+
+        void EntityModelRenderer::updateInstance(const EntityInfo& info) {
+            auto& instances = m_instances[info.renderer];
+            auto* entity = instances.entities[info.index];
+            instances.transformations[info.index] = vm::mat4x4f(entity->modelTransformation());
+            instances.bounds[info.index] = vm::bbox3f(entity->modelBounds());
+        }
+
         void EntityModelRenderer::doPrepareVertices(VboManager& vboManager) {
+            m_vboManager = &vboManager;
             m_entityModelManager.prepare(vboManager);
         }
 
@@ -142,20 +223,87 @@ namespace TrenchBroom {
             glAssert(glEnable(GL_TEXTURE_2D));
             glAssert(glActiveTexture(GL_TEXTURE0));
 
-            for (const auto& entry : m_entities) {
-                auto* entity = entry.first;
-                if (!m_showHiddenEntities && !m_editorContext.visible(entity)) {
-                    continue;
+            const auto& camera = renderContext.camera();
+
+            std::vector<VisibleInstances> visibleInstances;
+            for (const auto& entry : m_instances) {
+                const auto& instances = entry.second;
+
+                std::vector<size_t> indices;
+                for (size_t i = 0; i < instances.entities.size(); ++i) {
+                    if (!m_showHiddenEntities && !m_editorContext.visible(instances.entities[i])) {
+                        continue;
+                    }
+                    if (!camera.intersectsFrustum(instances.bounds[i])) {
+                        continue;
+                    }
+                    indices.push_back(i);
+                }
+
+                if (!indices.empty()) {
+                    visibleInstances.push_back(VisibleInstances{ entry.first, &instances, std::move(indices) });
                 }
+            }
+
+            if (glSupportsInstancedArrays()) {
+                renderInstanced(shader, visibleInstances);
+            } else {
+                renderInstancesIndividually(shader, visibleInstances);
+            }
+        }
+
+        void EntityModelRenderer::renderInstanced(ActiveShader& shader, const std::vector<VisibleInstances>& visibleInstances) {
+            std::vector<vm::mat4x4f> transformations;
+            for (const auto& visible : visibleInstances) {
+                for (const auto index : visible.indices) {
+                    transformations.push_back(visible.instances->transformations[index]);
+                }
+            }
+
+            if (transformations.empty()) {
+                return;
+            }
+
+            const auto size = transformations.size() * sizeof(vm::mat4x4f);
+            if (m_instanceVbo == nullptr || m_instanceVbo->capacity() < size) {
+                if (m_instanceVbo != nullptr) {
+                    m_vboManager->destroyVbo(m_instanceVbo);
+                }
+                // leave room for more instances so that the buffer isn't reallocated whenever the view changes a bit
+                m_instanceVbo = m_vboManager->allocateVbo(VboType::ArrayBuffer, 2u * size, VboUsage::DynamicDraw);
+            }
+            m_instanceVbo->writeBuffer(0u, transformations);
+
+            // a matrix attribute occupies one location per column
+            const auto location = static_cast<GLuint>(shader.findAttributeLocation(InstanceMatrixAttribute));
+            for (GLuint i = 0u; i < 4u; ++i) {
+                glAssert(glEnableVertexAttribArray(location + i));
+                glVertexAttribDivisorCompat(location + i, 1u);
+            }
 
-                auto* renderer = entry.second;
+            size_t offset = 0u;
+            for (const auto& visible : visibleInstances) {
+                m_instanceVbo->bind();
+                for (GLuint i = 0u; i < 4u; ++i) {
+                    const auto columnOffset = offset + i * sizeof(vm::vec4f);
+                    glAssert(glVertexAttribPointer(location + i, 4, GL_FLOAT, GL_FALSE, static_cast<GLsizei>(sizeof(vm::mat4x4f)), reinterpret_cast<GLvoid*>(columnOffset)));
+                }
+                m_instanceVbo->unbind();
 
-                const auto transformation = entity->modelTransformation();
-                MultiplyModelMatrix multMatrix(renderContext.transformation(), vm::mat4x4f(transformation));
+                visible.renderer->renderInstanced(visible.indices.size());
+                offset += visible.indices.size() * sizeof(vm::mat4x4f);
+            }
 
-                shader.set("ModelMatrix", vm::mat4x4f(transformation));
+            for (GLuint i = 0u; i < 4u; ++i) {
+                glVertexAttribDivisorCompat(location + i, 0u);
+                glAssert(glDisableVertexAttribArray(location + i));
+            }
+        }
 
-                renderer->render();
+        void EntityModelRenderer::renderInstancesIndividually(ActiveShader& shader, const std::vector<VisibleInstances>& visibleInstances) {
+            for (const auto& visible : visibleInstances) {
+                RenderFunc func(shader, visible.instances->transformations, visible.indices);
+                visible.renderer->renderInstances(visible.indices.size(), func);
             }
         }
     }
@@ -23,7 +23,11 @@
 #include "Color.h"
 #include "Renderer/Renderable.h"
 
+#include <vecmath/bbox.h>
+#include <vecmath/mat.h>
+
 #include <map>
+#include <vector>
 
 namespace TrenchBroom {
     class Logger;
@@ -38,12 +42,42 @@ namespace TrenchBroom {
     }
 
     namespace Renderer {
+        class ActiveShader;
         class RenderBatch;
         class TexturedRenderer;
+        class Vbo;
+        class VboManager;
 
         class EntityModelRenderer : public DirectRenderable {
         private:
-            using EntityMap = std::map<Model::EntityNode*, TexturedRenderer*>;
+            /**
+             * All entities that share a model renderer. The entity transformations and bounds are cached here and
+             * updated whenever an entity is updated, so that rendering doesn't have to query the entities.
+             */
+            struct Instances {
+                std::vector<Model::EntityNode*> entities;
+                std::vector<vm::mat4x4f> transformations;
+                std::vector<vm::bbox3f> bounds;
+            };
+
+            struct EntityInfo {
+                TexturedRenderer* renderer;
+                size_t index;
+            };
+
+            /**
+             * The indices of the instances of a model renderer that are visible in the current frame.
+             */
+            struct VisibleInstances {
+                TexturedRenderer* renderer;
+                const Instances* instances;
+                std::vector<size_t> indices;
+            };
+
+            using EntityMap = std::map<Model::EntityNode*, EntityInfo>;
+            using InstanceMap = std::map<TexturedRenderer*, Instances>;
+
+            struct RenderFunc;
 
             Logger& m_logger;
 
@@ -51,11 +85,19 @@ namespace TrenchBroom {
             const Model::EditorContext& m_editorContext;
 
             EntityMap m_entities;
+            InstanceMap m_instances;
 
             bool m_applyTinting;
             Color m_tintColor;
 
             bool m_showHiddenEntities;
+
+            /**
+             * Holds the model transformations of the visible instances of all models while rendering with instanced
+             * arrays.
+             */
+            VboManager* m_vboManager;
+            Vbo* m_instanceVbo;
         public:
             EntityModelRenderer(Logger& logger, Assets::EntityModelManager& entityModelManager, const Model::EditorContext& editorContext);
             ~EntityModelRenderer() override;
@@ -95,9 +137,15 @@ namespace TrenchBroom {
             void setShowHiddenEntities(bool showHiddenEntities);
 
             void render(RenderBatch& renderBatch);
+        private:
+            void addInstance(Model::EntityNode* entity, TexturedRenderer* renderer);
+            void removeInstance(EntityMap::iterator it);
+            void updateInstance(const EntityInfo& info);
         private:
             void doPrepareVertices(VboManager& vboManager) override;
             void doRender(RenderContext& renderContext) override;
+            void renderInstanced(ActiveShader& shader, const std::vector<VisibleInstances>& visibleInstances);
+            void renderInstancesIndividually(ActiveShader& shader, const std::vector<VisibleInstances>& visibleInstances);
         };
     }
 }
@@ -46,8 +46,9 @@ namespace TrenchBroom {
 
             void before(const Assets::Texture* texture) override {
                 if (texture != nullptr) {
+                    // textures that have not been uploaded yet are rendered using their average color
                     texture->activate();
-                    shader.set("ApplyTexture", applyTexture);
+                    shader.set("ApplyTexture", applyTexture && texture->isPrepared());
                     shader.set("Color", texture->averageColor());
                 } else {
                     shader.set("ApplyTexture", false);
@@ -110,4 +110,24 @@ namespace TrenchBroom {
                 return "Unknown OpenGL enum";
         }
     }
+
+    bool glSupportsInstancedArrays() {
+        return GLEW_VERSION_3_3 || (GLEW_ARB_draw_instanced && GLEW_ARB_instanced_arrays);
+    }
+
+    void glVertexAttribDivisorCompat(const GLuint index, const GLuint divisor) {
+        if (GLEW_VERSION_3_3) {
+            glAssert(glVertexAttribDivisor(index, divisor));
+        } else {
+            glAssert(glVertexAttribDivisorARB(index, divisor));
+        }
+    }
+
+    void glDrawArraysInstancedCompat(const GLenum mode, const GLint first, const GLsizei count, const GLsizei instanceCount) {
+        if (GLEW_VERSION_3_3) {
+            glAssert(glDrawArraysInstanced(mode, first, count, instanceCount));
+        } else {
+            glAssert(glDrawArraysInstancedARB(mode, first, count, instanceCount));
+        }
+    }
 }
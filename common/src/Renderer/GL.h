@@ -35,6 +35,22 @@ namespace TrenchBroom {
     GLenum glGetEnum(const std::string& name);
     std::string glGetEnumName(GLenum _enum);
 
+    /**
+     * Indicates whether instanced rendering with per instance vertex attributes is available, either in OpenGL 3.3 or
+     * through the ARB_draw_instanced and ARB_instanced_arrays extensions. Requires a current OpenGL context.
+     */
+    bool glSupportsInstancedArrays();
+
+    /**
+     * Calls glVertexAttribDivisor or its ARB equivalent, whichever is available.
+     */
+    void glVertexAttribDivisorCompat(GLuint index, GLuint divisor);
+
+    /**
+     * Calls glDrawArraysInstanced or its ARB equivalent, whichever is available.
+     */
+    void glDrawArraysInstancedCompat(GLenum mode, GLint first, GLsizei count, GLsizei instanceCount);
+
 // #define GL_DEBUG 1
 // #define GL_LOG 1
 
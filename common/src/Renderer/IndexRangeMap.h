@@ -146,6 +146,15 @@ namespace TrenchBroom {
              */
             void render(VertexArray& vertexArray) const;
 
+            /**
+             * Renders the primitives stored in this index range map the given number of times using instanced
+             * rendering. The per instance vertex attributes must be set up by the caller.
+             *
+             * @param vertexArray the vertex array to render with
+             * @param instanceCount the number of instances to render
+             */
+            void renderInstanced(VertexArray& vertexArray, size_t instanceCount) const;
+
             /**
              * Invokes the given function for each primitive stored in this map.
              *
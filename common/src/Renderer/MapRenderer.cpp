@@ -168,7 +168,7 @@ namespace TrenchBroom {
             m_defaultRenderer->clear();
             m_selectionRenderer->clear();
             m_lockedRenderer->clear();
-            m_entityLinkRenderer->invalidate();
+            m_entityLinkRenderer->invalidateLinkGraph();
         }
 
         void MapRenderer::overrideSelectionColors(const Color& color, const float mix) {
@@ -451,6 +451,7 @@ namespace TrenchBroom {
             document->selectionDidChangeNotifier.addObserver(this, &MapRenderer::selectionDidChange);
             document->textureCollectionsWillChangeNotifier.addObserver(this, &MapRenderer::textureCollectionsWillChange);
             document->entityDefinitionsDidChangeNotifier.addObserver(this, &MapRenderer::entityDefinitionsDidChange);
+            document->entityModelsWereLoadedNotifier.addObserver(this, &MapRenderer::entityModelsWereLoaded);
             document->modsDidChangeNotifier.addObserver(this, &MapRenderer::modsDidChange);
             document->editorContextDidChangeNotifier.addObserver(this, &MapRenderer::editorContextDidChange);
             document->mapViewConfigDidChangeNotifier.addObserver(this, &MapRenderer::mapViewConfigDidChange);
@@ -476,6 +477,7 @@ namespace TrenchBroom {
                 document->selectionDidChangeNotifier.removeObserver(this, &MapRenderer::selectionDidChange);
                 document->textureCollectionsWillChangeNotifier.removeObserver(this, &MapRenderer::textureCollectionsWillChange);
                 document->entityDefinitionsDidChangeNotifier.removeObserver(this, &MapRenderer::entityDefinitionsDidChange);
+                document->entityModelsWereLoadedNotifier.removeObserver(this, &MapRenderer::entityModelsWereLoaded);
                 document->modsDidChangeNotifier.removeObserver(this, &MapRenderer::modsDidChange);
                 document->editorContextDidChangeNotifier.removeObserver(this, &MapRenderer::editorContextDidChange);
                 document->mapViewConfigDidChangeNotifier.removeObserver(this, &MapRenderer::mapViewConfigDidChange);
@@ -494,17 +496,19 @@ namespace TrenchBroom {
             updateRenderers(Renderer_All);
         }
 
-        void MapRenderer::nodesWereAdded(const std::vector<Model::Node*>&) {
+        void MapRenderer::nodesWereAdded(const std::vector<Model::Node*>& nodes) {
             updateRenderers(Renderer_All);
+            m_entityLinkRenderer->updateLinkGraphForAddedOrRemovedNodes(nodes);
         }
 
-        void MapRenderer::nodesWereRemoved(const std::vector<Model::Node*>&) {
+        void MapRenderer::nodesWereRemoved(const std::vector<Model::Node*>& nodes) {
             updateRenderers(Renderer_All);
+            m_entityLinkRenderer->updateLinkGraphForAddedOrRemovedNodes(nodes);
         }
 
-        void MapRenderer::nodesDidChange(const std::vector<Model::Node*>&) {
+        void MapRenderer::nodesDidChange(const std::vector<Model::Node*>& nodes) {
             invalidateRenderers(Renderer_Selection);
-            invalidateEntityLinkRenderer();
+            m_entityLinkRenderer->updateLinkGraphForChangedNodes(nodes);
         }
 
         void MapRenderer::nodeVisibilityDidChange(const std::vector<Model::Node*>&) {
@@ -552,6 +556,12 @@ namespace TrenchBroom {
             invalidateEntityLinkRenderer();
         }
 
+        void MapRenderer::entityModelsWereLoaded() {
+            // the entities that use the loaded models have new bounds and can now be rendered with their models
+            invalidateRenderers(Renderer_All);
+            invalidateEntityLinkRenderer();
+        }
+
         void MapRenderer::modsDidChange() {
             reloadEntityModels();
             invalidateRenderers(Renderer_All);
@@ -144,6 +144,7 @@ namespace TrenchBroom {
 
             void textureCollectionsWillChange();
             void entityDefinitionsDidChange();
+            void entityModelsWereLoaded();
             void modsDidChange();
 
             void editorContextDidChange();
@@ -64,6 +64,12 @@ namespace TrenchBroom {
             void set(const std::string& name, const vm::mat3x3f& value);
             void set(const std::string& name, const vm::mat4x4f& value);
 
+            /**
+             * Sets the value of the given matrix vertex attribute that is used while no vertex array is enabled for
+             * it. A matrix attribute occupies one attribute location per column.
+             */
+            void setAttribute(const std::string& name, const vm::mat4x4f& value);
+
             GLint findAttributeLocation(const std::string& name) const;
         private:
             void link();
@@ -0,0 +1,323 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TextureThumbnailAtlas.h"
+
+#include "Assets/Texture.h"
+#include "Assets/TextureBuffer.h"
+
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        static const size_t BytesPerPixel = 4u;
+
+        TextureThumbnailAtlas::TextureThumbnailAtlas(const size_t thumbnailSize, const size_t pageSize, const size_t maxPageCount, const size_t maxThumbnailsPerFrame) :
+        m_thumbnailSize(thumbnailSize),
+        m_pageSize(pageSize),
+        m_maxPageCount(maxPageCount),
+        m_maxThumbnailsPerFrame(maxThumbnailsPerFrame),
+        m_currentFrame(0u),
+        m_generation(0u),
+        m_thumbnailsCreatedInFrame(0u),
+        m_thumbnailsDeferred(false) {
+            assert(m_thumbnailSize > 0u);
+            assert(m_maxPageCount > 0u);
+            assert(m_maxThumbnailsPerFrame > 0u);
+        }
+
+        TextureThumbnailAtlas::~TextureThumbnailAtlas() {
+            clear();
+        }
+
+        size_t TextureThumbnailAtlas::thumbnailSize() const {
+            return m_thumbnailSize;
+        }
+
+        size_t TextureThumbnailAtlas::pageCount() const {
+            return m_pages.size();
+        }
+
+        size_t TextureThumbnailAtlas::generation() const {
+            return m_generation;
+        }
+
+        void TextureThumbnailAtlas::beginFrame() {
+            ++m_currentFrame;
+            m_thumbnailsCreatedInFrame = 0u;
+            m_thumbnailsDeferred = false;
+        }
+
+        const TextureThumbnailAtlas::Thumbnail* TextureThumbnailAtlas::thumbnail(const Assets::Texture* texture) {
+            auto it = m_entries.find(texture);
+            if (it != std::end(m_entries)) {
+                m_slots[it->second.slot].lastUsedFrame = m_currentFrame;
+                return &it->second.thumbnail;
+            }
+
+            if (!texture->isPrepared() || texture->width() == 0u || texture->height() == 0u) {
+                return nullptr;
+            }
+
+            if (m_thumbnailsCreatedInFrame >= m_maxThumbnailsPerFrame) {
+                m_thumbnailsDeferred = true;
+                return nullptr;
+            }
+
+            size_t slot;
+            if (!allocateSlot(slot)) {
+                return nullptr;
+            }
+
+            const auto thumbnail = createThumbnail(texture, slot);
+            m_slots[slot] = Slot{ texture, m_currentFrame };
+            ++m_generation;
+            ++m_thumbnailsCreatedInFrame;
+
+            it = m_entries.emplace(texture, Entry{ slot, thumbnail }).first;
+            return &it->second.thumbnail;
+        }
+
+        bool TextureThumbnailAtlas::thumbnailsDeferred() const {
+            return m_thumbnailsDeferred;
+        }
+
+        void TextureThumbnailAtlas::clear() {
+            if (!m_pages.empty()) {
+                glAssert(glDeleteTextures(static_cast<GLsizei>(m_pages.size()), m_pages.data()));
+            }
+            m_pages.clear();
+            m_slots.clear();
+            m_freeSlots.clear();
+            m_entries.clear();
+            ++m_generation;
+        }
+
+        void TextureThumbnailAtlas::activatePage(const size_t page) const {
+            assert(page < m_pages.size());
+            glAssert(glBindTexture(GL_TEXTURE_2D, m_pages[page]));
+        }
+
+        void TextureThumbnailAtlas::deactivate() const {
+            glAssert(glBindTexture(GL_TEXTURE_2D, 0));
+        }
+
+        size_t TextureThumbnailAtlas::slotsPerRow() const {
+            return m_pageSize / slotStride();
+        }
+
+        size_t TextureThumbnailAtlas::slotsPerPage() const {
+            return slotsPerRow() * slotsPerRow();
+        }
+
+        size_t TextureThumbnailAtlas::slotStride() const {
+            // every thumbnail is surrounded by a one texel border to avoid bleeding between neighbouring thumbnails
+            return m_thumbnailSize + 2u;
+        }
+
+        bool TextureThumbnailAtlas::allocateSlot(size_t& slot) {
+            if (m_freeSlots.empty()) {
+                if (m_pages.size() < m_maxPageCount) {
+                    addPage();
+                } else {
+                    // evict the least recently used thumbnail unless it was used in the current frame
+                    auto lru = std::min_element(std::begin(m_slots), std::end(m_slots), [](const Slot& lhs, const Slot& rhs) {
+                        return lhs.lastUsedFrame < rhs.lastUsedFrame;
+                    });
+                    if (lru == std::end(m_slots) || lru->lastUsedFrame == m_currentFrame) {
+                        return false;
+                    }
+
+                    m_entries.erase(lru->texture);
+                    lru->texture = nullptr;
+                    m_freeSlots.push_back(static_cast<size_t>(std::distance(std::begin(m_slots), lru)));
+                    ++m_generation;
+                }
+            }
+
+            if (m_freeSlots.empty()) {
+                return false;
+            }
+
+            slot = m_freeSlots.back();
+            m_freeSlots.pop_back();
+            return true;
+        }
+
+        void TextureThumbnailAtlas::addPage() {
+            if (m_pages.empty()) {
+                GLint maxTextureSize = 0;
+                glAssert(glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize));
+                if (maxTextureSize > 0) {
+                    m_pageSize = std::min(m_pageSize, static_cast<size_t>(maxTextureSize));
+                }
+                m_pageSize = std::max(m_pageSize, slotStride());
+            }
+
+            GLuint textureId = 0;
+            glAssert(glGenTextures(1, &textureId));
+            glAssert(glBindTexture(GL_TEXTURE_2D, textureId));
+            glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
+            glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+            glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+            glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+            glAssert(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA,
+                                  static_cast<GLsizei>(m_pageSize),
+                                  static_cast<GLsizei>(m_pageSize),
+                                  0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+            glAssert(glBindTexture(GL_TEXTURE_2D, 0));
+
+            const size_t firstSlot = m_slots.size();
+            const size_t slotCount = slotsPerPage();
+
+            m_pages.push_back(textureId);
+            m_slots.resize(firstSlot + slotCount, Slot{ nullptr, 0u });
+
+            // push in reverse so that slots are allocated in order
+            for (size_t i = 0; i < slotCount; ++i) {
+                m_freeSlots.push_back(firstSlot + slotCount - i - 1u);
+            }
+        }
+
+        TextureThumbnailAtlas::Thumbnail TextureThumbnailAtlas::createThumbnail(const Assets::Texture* texture, const size_t slot) const {
+            const auto targetSize = Renderer::thumbnailSize(texture->width(), texture->height(), m_thumbnailSize);
+
+            texture->activate();
+
+            // find the smallest mipmap level that is still at least as large as the thumbnail
+            size_t level = 0u;
+            auto levelSize = Assets::sizeAtMipLevel(texture->width(), texture->height(), 0u);
+            while (true) {
+                const auto nextSize = Assets::sizeAtMipLevel(texture->width(), texture->height(), level + 1u);
+                if (nextSize.x() < targetSize.x() || nextSize.y() < targetSize.y() || nextSize == levelSize) {
+                    break;
+                }
+
+                // the level may not be present, e.g. for masked textures
+                GLint width = 0;
+                glAssert(glGetTexLevelParameteriv(GL_TEXTURE_2D, static_cast<GLint>(level + 1u), GL_TEXTURE_WIDTH, &width));
+                if (width != static_cast<GLint>(nextSize.x())) {
+                    break;
+                }
+
+                ++level;
+                levelSize = nextSize;
+            }
+
+            std::vector<unsigned char> levelImage(BytesPerPixel * levelSize.x() * levelSize.y());
+            glAssert(glPixelStorei(GL_PACK_ALIGNMENT, 1));
+            glAssert(glGetTexImage(GL_TEXTURE_2D, static_cast<GLint>(level), GL_RGBA, GL_UNSIGNED_BYTE, levelImage.data()));
+
+            texture->deactivate();
+
+            const auto image = downscaleRGBAImage(levelImage, levelSize.x(), levelSize.y(), targetSize.x(), targetSize.y());
+
+            // copy the image into a buffer with a border of one texel that repeats the image's edges
+            const size_t borderedWidth = targetSize.x() + 2u;
+            const size_t borderedHeight = targetSize.y() + 2u;
+            std::vector<unsigned char> borderedImage(BytesPerPixel * borderedWidth * borderedHeight);
+            for (size_t y = 0; y < borderedHeight; ++y) {
+                const size_t sourceY = std::min(y > 0u ? y - 1u : 0u, targetSize.y() - 1u);
+                for (size_t x = 0; x < borderedWidth; ++x) {
+                    const size_t sourceX = std::min(x > 0u ? x - 1u : 0u, targetSize.x() - 1u);
+                    const auto* source = &image[BytesPerPixel * (sourceY * targetSize.x() + sourceX)];
+                    auto* target = &borderedImage[BytesPerPixel * (y * borderedWidth + x)];
+                    std::copy(source, source + BytesPerPixel, target);
+                }
+            }
+
+            const size_t page = slot / slotsPerPage();
+            const size_t indexInPage = slot % slotsPerPage();
+            const size_t slotX = (indexInPage % slotsPerRow()) * slotStride();
+            const size_t slotY = (indexInPage / slotsPerRow()) * slotStride();
+
+            activatePage(page);
+            glAssert(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+            glAssert(glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0));
+            glAssert(glPixelStorei(GL_UNPACK_SKIP_ROWS, 0));
+            glAssert(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+            glAssert(glTexSubImage2D(GL_TEXTURE_2D, 0,
+                                     static_cast<GLint>(slotX),
+                                     static_cast<GLint>(slotY),
+                                     static_cast<GLsizei>(borderedWidth),
+                                     static_cast<GLsizei>(borderedHeight),
+                                     GL_RGBA, GL_UNSIGNED_BYTE, borderedImage.data()));
+            deactivate();
+
+            const auto pageSize = static_cast<float>(m_pageSize);
+            return Thumbnail{
+                page,
+                vm::vec2f(static_cast<float>(slotX + 1u), static_cast<float>(slotY + 1u)) / pageSize,
+                vm::vec2f(static_cast<float>(slotX + 1u + targetSize.x()), static_cast<float>(slotY + 1u + targetSize.y())) / pageSize
+            };
+        }
+
+        vm::vec2s thumbnailSize(const size_t width, const size_t height, const size_t maxSize) {
+            const size_t largest = std::max(width, height);
+            if (largest <= maxSize) {
+                return vm::vec2s(std::max(width, size_t(1)), std::max(height, size_t(1)));
+            }
+
+            return vm::vec2s(std::max(width * maxSize / largest, size_t(1)),
+                             std::max(height * maxSize / largest, size_t(1)));
+        }
+
+        std::vector<unsigned char> downscaleRGBAImage(const std::vector<unsigned char>& source, const size_t sourceWidth, const size_t sourceHeight, const size_t targetWidth, const size_t targetHeight) {
+            assert(targetWidth > 0u && targetWidth <= sourceWidth);
+            assert(targetHeight > 0u && targetHeight <= sourceHeight);
+            assert(source.size() >= BytesPerPixel * sourceWidth * sourceHeight);
+
+            if (targetWidth == sourceWidth && targetHeight == sourceHeight) {
+                return source;
+            }
+
+            std::vector<unsigned char> target(BytesPerPixel * targetWidth * targetHeight);
+            for (size_t y = 0; y < targetHeight; ++y) {
+                const size_t y0 = y * sourceHeight / targetHeight;
+                const size_t y1 = std::max((y + 1u) * sourceHeight / targetHeight, y0 + 1u);
+                for (size_t x = 0; x < targetWidth; ++x) {
+                    const size_t x0 = x * sourceWidth / targetWidth;
+                    const size_t x1 = std::max((x + 1u) * sourceWidth / targetWidth, x0 + 1u);
+
+                    size_t sums[BytesPerPixel] = { 0u, 0u, 0u, 0u };
+                    for (size_t sy = y0; sy < y1; ++sy) {
+                        for (size_t sx = x0; sx < x1; ++sx) {
+                            const auto* pixel = &source[BytesPerPixel * (sy * sourceWidth + sx)];
+                            for (size_t c = 0; c < BytesPerPixel; ++c) {
+                                sums[c] += pixel[c];
+                            }
+                        }
+                    }
+
+                    const size_t count = (y1 - y0) * (x1 - x0);
+                    auto* pixel = &target[BytesPerPixel * (y * targetWidth + x)];
+                    for (size_t c = 0; c < BytesPerPixel; ++c) {
+                        pixel[c] = static_cast<unsigned char>(sums[c] / count);
+                    }
+                }
+            }
+
+            return target;
+        }
+    }
+}
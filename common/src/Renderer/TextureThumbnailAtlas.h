@@ -0,0 +1,159 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_TextureThumbnailAtlas
+#define TrenchBroom_TextureThumbnailAtlas
+
+#include "Renderer/GL.h"
+
+#include <vecmath/vec.h>
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Assets {
+        class Texture;
+    }
+
+    namespace Renderer {
+        /**
+         * Packs downscaled copies of textures into a small number of large atlas textures so that many textures can
+         * be rendered with only a few texture binds and draw calls.
+         *
+         * Each page of the atlas is a square texture divided into a grid of equally sized slots. Thumbnails are
+         * created lazily when they are first requested and are read back from the mipmap level of the texture that
+         * is closest to the thumbnail size. If all pages are full, the least recently used thumbnails are evicted,
+         * but thumbnails that were requested in the current frame are never evicted.
+         *
+         * Creating a thumbnail reads back an image from the GPU, so only a limited number of thumbnails are created
+         * per frame. Clients should render another frame while thumbnails were deferred, see thumbnailsDeferred.
+         *
+         * All methods except the constructor and the accessors require a current OpenGL context.
+         */
+        class TextureThumbnailAtlas {
+        public:
+            struct Thumbnail {
+                size_t page;
+                vm::vec2f texCoordsMin;
+                vm::vec2f texCoordsMax;
+            };
+        private:
+            struct Slot {
+                const Assets::Texture* texture;
+                size_t lastUsedFrame;
+            };
+
+            struct Entry {
+                size_t slot;
+                Thumbnail thumbnail;
+            };
+
+            size_t m_thumbnailSize;
+            size_t m_pageSize;
+            size_t m_maxPageCount;
+            size_t m_maxThumbnailsPerFrame;
+
+            std::vector<GLuint> m_pages;
+            std::vector<Slot> m_slots;
+            std::vector<size_t> m_freeSlots;
+            std::unordered_map<const Assets::Texture*, Entry> m_entries;
+
+            size_t m_currentFrame;
+            size_t m_generation;
+            size_t m_thumbnailsCreatedInFrame;
+            bool m_thumbnailsDeferred;
+        public:
+            /**
+             * Creates a new atlas.
+             *
+             * @param thumbnailSize the maximum width and height of a thumbnail
+             * @param pageSize the width and height of each atlas page, will be clamped to the maximum texture size
+             * @param maxPageCount the number of pages after which thumbnails are evicted instead of adding pages
+             * @param maxThumbnailsPerFrame the maximum number of thumbnails to create per frame
+             */
+            TextureThumbnailAtlas(size_t thumbnailSize, size_t pageSize, size_t maxPageCount, size_t maxThumbnailsPerFrame);
+            ~TextureThumbnailAtlas();
+
+            TextureThumbnailAtlas(const TextureThumbnailAtlas& other) = delete;
+            TextureThumbnailAtlas& operator=(const TextureThumbnailAtlas& other) = delete;
+
+            size_t thumbnailSize() const;
+            size_t pageCount() const;
+
+            /**
+             * Returns a number that changes whenever a thumbnail is added to or evicted from this atlas. Clients can
+             * use it to decide whether texture coordinates obtained earlier are still valid.
+             */
+            size_t generation() const;
+
+            /**
+             * Starts a new frame. Thumbnails requested after this call may evict thumbnails that were only requested
+             * in previous frames.
+             */
+            void beginFrame();
+
+            /**
+             * Returns the thumbnail of the given texture, creating it if necessary, and marks it as used in the current
+             * frame.
+             *
+             * Returns nullptr if the texture has not been uploaded yet, if the maximum number of thumbnails was already
+             * created in the current frame, or if the atlas is full of thumbnails that were used in the current frame.
+             */
+            const Thumbnail* thumbnail(const Assets::Texture* texture);
+
+            /**
+             * Indicates whether a thumbnail was requested in the current frame but not created because the maximum
+             * number of thumbnails per frame was reached.
+             */
+            bool thumbnailsDeferred() const;
+
+            /**
+             * Removes all thumbnails and deletes the atlas textures.
+             */
+            void clear();
+
+            void activatePage(size_t page) const;
+            void deactivate() const;
+        private:
+            size_t slotsPerRow() const;
+            size_t slotsPerPage() const;
+            size_t slotStride() const;
+
+            bool allocateSlot(size_t& slot);
+            void addPage();
+            Thumbnail createThumbnail(const Assets::Texture* texture, size_t slot) const;
+        };
+
+        /**
+         * Computes the size of a thumbnail of an image with the given size so that it fits into a square with the
+         * given maximum size while preserving the aspect ratio. Images that already fit are not enlarged.
+         */
+        vm::vec2s thumbnailSize(size_t width, size_t height, size_t maxSize);
+
+        /**
+         * Downscales the given RGBA image to the given size by averaging the source pixels covered by every target
+         * pixel. The target size must not exceed the source size.
+         */
+        std::vector<unsigned char> downscaleRGBAImage(const std::vector<unsigned char>& source, size_t sourceWidth, size_t sourceHeight, size_t targetWidth, size_t targetHeight);
+    }
+}
+
+#endif /* defined(TrenchBroom_TextureThumbnailAtlas) */
@@ -124,6 +124,34 @@ namespace TrenchBroom {
             }
         }
 
+        void TexturedIndexRangeMap::renderInstances(VertexArray& vertexArray, const size_t instanceCount, InstanceRenderFunc& func) {
+            DefaultTextureRenderFunc textureFunc;
+            for (const auto& entry : *m_data) {
+                const auto* texture = entry.first;
+                const auto& indexArray = entry.second;
+
+                textureFunc.before(texture);
+                for (size_t i = 0; i < instanceCount; ++i) {
+                    func.before(i);
+                    indexArray.render(vertexArray);
+                    func.after(i);
+                }
+                textureFunc.after(texture);
+            }
+        }
+
+        void TexturedIndexRangeMap::renderInstanced(VertexArray& vertexArray, const size_t instanceCount) {
+            DefaultTextureRenderFunc textureFunc;
+            for (const auto& entry : *m_data) {
+                const auto* texture = entry.first;
+                const auto& indexArray = entry.second;
+
+                textureFunc.before(texture);
+                indexArray.renderInstanced(vertexArray, instanceCount);
+                textureFunc.after(texture);
+            }
+        }
+
         void TexturedIndexRangeMap::forEachPrimitive(std::function<void(const Texture*, PrimType, size_t, size_t)> func) const {
             for (const auto& entry : *m_data) {
                 const auto* texture = entry.first;
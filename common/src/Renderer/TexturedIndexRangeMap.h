@@ -30,6 +30,7 @@ namespace TrenchBroom {
     }
 
     namespace Renderer {
+        class InstanceRenderFunc;
         class TextureRenderFunc;
         class VertexArray;
 
@@ -169,6 +170,28 @@ namespace TrenchBroom {
              */
             void render(VertexArray& vertexArray, TextureRenderFunc& func);
 
+            /**
+             * Renders the primitives stored in this index range map several times using the vertices in the given
+             * vertex array. Each texture is activated only once, and all instances are rendered with it before the
+             * next texture is activated. The given render function is called before and after each instance is
+             * rendered so that it can set up the per instance state such as the model matrix.
+             *
+             * @param vertexArray the vertex array to render with
+             * @param instanceCount the number of instances to render
+             * @param func the instance callbacks
+             */
+            void renderInstances(VertexArray& vertexArray, size_t instanceCount, InstanceRenderFunc& func);
+
+            /**
+             * Renders the primitives stored in this index range map the given number of times using instanced
+             * rendering. Each texture is activated only once. The per instance vertex attributes must be set up by
+             * the caller.
+             *
+             * @param vertexArray the vertex array to render with
+             * @param instanceCount the number of instances to render
+             */
+            void renderInstanced(VertexArray& vertexArray, size_t instanceCount);
+
             /**
              * Invokes the given function for each primitive stored in this map.
              *
@@ -33,6 +33,7 @@ namespace TrenchBroom {
 
     namespace Renderer {
         class VboManager;
+        class InstanceRenderFunc;
         class TextureRenderFunc;
 
         class TexturedRenderer {
@@ -44,6 +45,13 @@ namespace TrenchBroom {
             virtual void prepare(VboManager& vboManager) = 0;
             virtual void render() = 0;
             virtual void render(TextureRenderFunc& func) = 0;
+            virtual void renderInstances(size_t instanceCount, InstanceRenderFunc& func) = 0;
+
+            /**
+             * Renders the given number of instances using instanced rendering. The per instance vertex attributes
+             * must be set up by the caller. Requires that glSupportsInstancedArrays returns true.
+             */
+            virtual void renderInstanced(size_t instanceCount) = 0;
         };
 
         class TexturedIndexRangeRenderer : public TexturedRenderer {
@@ -61,6 +69,8 @@ namespace TrenchBroom {
             void prepare(VboManager& vboManager) override;
             void render() override;
             void render(TextureRenderFunc& func) override;
+            void renderInstances(size_t instanceCount, InstanceRenderFunc& func) override;
+            void renderInstanced(size_t instanceCount) override;
         };
 
         class MultiTexturedIndexRangeRenderer : public TexturedRenderer {
@@ -75,6 +85,8 @@ namespace TrenchBroom {
             void prepare(VboManager& vboManager) override;
             void render() override;
             void render(TextureRenderFunc& func) override;
+            void renderInstances(size_t instanceCount, InstanceRenderFunc& func) override;
+            void renderInstanced(size_t instanceCount) override;
         };
     }
 }
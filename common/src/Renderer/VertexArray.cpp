@@ -107,6 +107,26 @@ namespace TrenchBroom {
 
         }
 
+        void VertexArray::renderInstanced(const PrimType primType, const GLIndices& indices, const GLCounts& counts, const GLint primCount, const GLsizei instanceCount) {
+            assert(prepared());
+            // there is no instanced variant of glMultiDrawArrays, so every range is drawn separately
+            const auto drawRanges = [&]() {
+                for (GLint i = 0; i < primCount; ++i) {
+                    const auto j = static_cast<size_t>(i);
+                    glDrawArraysInstancedCompat(toGL(primType), indices[j], counts[j], instanceCount);
+                }
+            };
+
+            if (!m_setup) {
+                if (setup()) {
+                    drawRanges();
+                    cleanup();
+                }
+            } else {
+                drawRanges();
+            }
+        }
+
         void VertexArray::render(const PrimType primType, const GLIndices& indices, const GLsizei count) {
             assert(prepared());
             if (!m_setup) {
@@ -278,6 +278,19 @@ namespace TrenchBroom {
              */
             void render(PrimType primType, const GLIndices& indices, const GLCounts& counts, GLint primCount);
 
+            /**
+             * Renders the given sub ranges of this vertex array like the above method, but renders every range the
+             * given number of times using instanced rendering. The per instance vertex attributes must be set up by
+             * the caller. Requires that glSupportsInstancedArrays returns true.
+             *
+             * @param primType the primitive type to render
+             * @param indices the start indices of the ranges to render
+             * @param counts the lengths of the ranges to render
+             * @param primCount the number of ranges to render
+             * @param instanceCount the number of instances to render
+             */
+            void renderInstanced(PrimType primType, const GLIndices& indices, const GLCounts& counts, GLint primCount, GLsizei instanceCount);
+
             /**
              * Renders a number of primitives of the given type, the vertices of which are indicates by the given
              * index array.
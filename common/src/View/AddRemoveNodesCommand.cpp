@@ -21,6 +21,7 @@
 
 #include "Ensure.h"
 #include "Macros.h"
+#include "Model/ModelUtils.h"
 #include "Model/Node.h"
 #include "View/MapDocumentCommandFacade.h"
 
@@ -116,5 +117,12 @@ namespace TrenchBroom {
         bool AddRemoveNodesCommand::doCollateWith(UndoableCommand*) {
             return false;
         }
+
+        size_t AddRemoveNodesCommand::doGetMemorySize() const {
+            // the nodes to add are owned by this command, the nodes to remove are owned by the document
+            return sizeof(AddRemoveNodesCommand)
+                + Model::memorySize(m_nodesToAdd) + Model::memorySize(Model::collectChildren(m_nodesToAdd))
+                + Model::memorySize(m_nodesToRemove);
+        }
     }
 }
@@ -62,6 +62,8 @@ namespace TrenchBroom {
 
             bool doCollateWith(UndoableCommand* command) override;
 
+            size_t doGetMemorySize() const override;
+
             deleteCopyAndMove(AddRemoveNodesCommand)
         };
     }
@@ -19,9 +19,13 @@
 
 #include "Autosaver.h"
 
+#include "BufferedLogger.h"
 #include "Exceptions.h"
 #include "IO/DiskFileSystem.h"
 #include "IO/DiskIO.h"
+#include "IO/IOUtils.h"
+#include "Model/Game.h"
+#include "Model/WorldNode.h"
 #include "View/MapDocument.h"
 
 #include <kdl/memory_utils.h>
@@ -31,6 +35,7 @@
 
 #include <algorithm> // for std::sort
 #include <cassert>
+#include <cstdio>
 #include <limits>
 #include <memory>
 
@@ -69,7 +74,18 @@ namespace TrenchBroom {
         m_lastSaveTime(Clock::now()),
         m_lastModificationCount(kdl::mem_lock(m_document)->modificationCount()) {}
 
+        Autosaver::~Autosaver() {
+            if (m_pendingSave.valid()) {
+                m_pendingSave.wait();
+            }
+        }
+
         void Autosaver::triggerAutosave(Logger& logger) {
+            if (autosavePending()) {
+                return;
+            }
+            finishAutosave();
+
             if (kdl::mem_expired(m_document)) {
                 return;
             }
@@ -98,10 +114,41 @@ namespace TrenchBroom {
             autosave(logger, document);
         }
 
+        void Autosaver::finishAutosave() {
+            if (m_pendingSave.valid()) {
+                m_pendingSave.get();
+            }
+            if (m_pendingLogger != nullptr) {
+                m_pendingLogger->flush();
+                m_pendingLogger.reset();
+            }
+        }
+
+        bool Autosaver::autosavePending() const {
+            using namespace std::chrono_literals;
+            return m_pendingSave.valid() && m_pendingSave.wait_for(0s) != std::future_status::ready;
+        }
+
         void Autosaver::autosave(Logger& logger, std::shared_ptr<MapDocument> document) {
-            const auto& mapPath = document->path();
+            const auto mapPath = document->path();
             assert(IO::Disk::fileExists(IO::Disk::fixPath(mapPath)));
 
+            m_lastSaveTime = Clock::now();
+            m_lastModificationCount = document->modificationCount();
+
+            // the copy of the world is the snapshot that is written to the backup, so later changes to the document
+            // cannot affect the backup; serializing it is left to the worker
+            auto game = document->game();
+            auto world = document->cloneWorldForSaving();
+
+            m_pendingLogger = std::make_unique<BufferedLogger>(logger);
+            m_pendingSave = std::async(std::launch::async, [this, pendingLogger = m_pendingLogger.get(), mapPath, game = std::move(game), world = std::move(world)]() {
+                const auto content = game->writeMapToString(*world);
+                writeBackup(*pendingLogger, mapPath, content);
+            });
+        }
+
+        void Autosaver::writeBackup(Logger& logger, const IO::Path& mapPath, const std::string& content) const {
             const auto mapFilename = mapPath.lastComponent();
             const auto mapBasename = mapFilename.deleteExtension();
 
@@ -117,9 +164,17 @@ namespace TrenchBroom {
 
                 const auto backupFilePath = fs.makeAbsolute(makeBackupName(mapBasename, backupNo));
 
-                m_lastSaveTime = Clock::now();
-                m_lastModificationCount = document->modificationCount();
-                document->saveDocumentTo(backupFilePath);
+                auto written = false;
+                {
+                    IO::OpenFile open(backupFilePath, true);
+                    written = std::fwrite(content.data(), 1u, content.size(), open.file) == content.size();
+                }
+
+                if (!written) {
+                    // don't leave a truncated backup behind, it would be mistaken for the latest one
+                    fs.deleteFile(makeBackupName(mapBasename, backupNo));
+                    throw FileSystemException("Could not write autosave backup " + backupFilePath.asString());
+                }
 
                 logger.info() << "Created autosave backup at " << backupFilePath;
             } catch (const FileSystemException& e) {
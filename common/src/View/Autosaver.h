@@ -23,9 +23,13 @@
 #include "IO/Path.h"
 
 #include <chrono>
+#include <future>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace TrenchBroom {
+    class BufferedLogger;
     class Logger;
 
     namespace IO {
@@ -36,6 +40,14 @@ namespace TrenchBroom {
         class Command;
         class MapDocument;
 
+        /**
+         * Periodically writes backups of a document.
+         *
+         * The world is cloned on the calling thread using MapDocument::cloneWorldForSaving, which yields a copy
+         * that the document does not refer to. The clone is handed to a worker thread, which serializes it, manages
+         * the backup files and writes the backup. While a backup is being written, no further autosaves are started. The outcome of a backup is reported to the logger passed to
+         * triggerAutosave when the next autosave is triggered or when finishAutosave is called.
+         */
         class Autosaver {
         public:
             class BackupFileMatcher {
@@ -70,13 +82,32 @@ namespace TrenchBroom {
              * The modification count that was last recorded.
              */
             size_t m_lastModificationCount;
-            
+
+            /**
+             * Collects the messages of the backup that is currently being written.
+             */
+            std::unique_ptr<BufferedLogger> m_pendingLogger;
+
+            /**
+             * The backup that is currently being written, if any.
+             */
+            std::future<void> m_pendingSave;
         public:
             explicit Autosaver(std::weak_ptr<MapDocument> document, std::chrono::milliseconds saveInterval = std::chrono::milliseconds(10 * 60 * 1000), size_t maxBackups = 50);
+            ~Autosaver();
 
             void triggerAutosave(Logger& logger);
+
+            /**
+             * Waits until the backup that is currently being written, if any, is complete, and passes its messages
+             * on to the logger that was given when the autosave was triggered. This must be called before that logger
+             * is destroyed.
+             */
+            void finishAutosave();
         private:
+            bool autosavePending() const;
             void autosave(Logger& logger, std::shared_ptr<View::MapDocument> document);
+            void writeBackup(Logger& logger, const IO::Path& mapPath, const std::string& content) const;
             IO::WritableDiskFileSystem createBackupFileSystem(Logger& logger, const IO::Path& mapPath) const;
             std::vector<IO::Path> collectBackups(const IO::WritableDiskFileSystem& fs, const IO::Path& mapBasename) const;
             void thinBackups(Logger& logger, IO::WritableDiskFileSystem& fs, std::vector<IO::Path>& backups) const;
@@ -29,6 +29,7 @@
 #include <kdl/vector_utils.h>
 
 #include <algorithm>
+#include <iterator>
 
 #include <QDateTime>
 
@@ -142,6 +143,20 @@ namespace TrenchBroom {
             bool doCollateWith(UndoableCommand*) override {
                 return false;
             }
+
+            size_t doGetMemorySize() const override {
+                size_t result = 0u;
+                for (const auto& command : m_commands) {
+                    result += command->memorySize();
+                }
+                return result;
+            }
+
+            void doCompressSnapshots() override {
+                for (auto& command : m_commands) {
+                    command->compressSnapshots();
+                }
+            }
         };
 
         const Command::CommandType CommandProcessor::TransactionCommand::Type = Command::freeType();
@@ -149,6 +164,9 @@ namespace TrenchBroom {
         CommandProcessor::CommandProcessor(MapDocumentCommandFacade* document, const std::chrono::milliseconds collationInterval) :
         m_document(document),
         m_collationInterval(collationInterval),
+        m_undoMemoryUsage(0u),
+        m_undoMemoryBudget(0u),
+        m_redoMemoryUsage(0u),
         m_lastCommandTimestamp(std::chrono::time_point<std::chrono::system_clock>()) {}
 
         CommandProcessor::~CommandProcessor() = default;
@@ -205,7 +223,9 @@ namespace TrenchBroom {
             auto result = executeCommand(command.get());
             if (result->success()) {
                 m_undoStack.clear();
-                m_redoStack.clear();
+                m_undoStackMemorySizes.clear();
+                m_undoMemoryUsage = 0u;
+                clearRedoStack();
             }
             return result;
         }
@@ -280,10 +300,27 @@ namespace TrenchBroom {
 
             clearRepeatStack();
             m_undoStack.clear();
-            m_redoStack.clear();
+            m_undoStackMemorySizes.clear();
+            m_undoMemoryUsage = 0u;
+            clearRedoStack();
             m_lastCommandTimestamp = std::chrono::time_point<std::chrono::system_clock>();
         }
 
+        size_t CommandProcessor::undoMemoryUsage() const {
+            return m_undoMemoryUsage + m_redoMemoryUsage;
+        }
+
+        size_t CommandProcessor::undoMemoryBudget() const {
+            return m_undoMemoryBudget;
+        }
+
+        void CommandProcessor::setUndoMemoryBudget(const size_t budget) {
+            m_undoMemoryBudget = budget;
+            if (m_transactionStack.empty()) {
+                trimUndoStack();
+            }
+        }
+
         CommandProcessor::SubmitAndStoreResult CommandProcessor::executeAndStoreCommand(std::unique_ptr<UndoableCommand> command, const bool collate, const bool repeatable) {
             auto commandResult = executeCommand(command.get());
             if (!commandResult->success()) {
@@ -291,7 +328,7 @@ namespace TrenchBroom {
             }
 
             const auto commandStored = storeCommand(std::move(command), collate, repeatable);
-            m_redoStack.clear();
+            clearRedoStack();
             return SubmitAndStoreResult(std::move(commandResult), commandStored);
         }
 
@@ -379,6 +416,12 @@ namespace TrenchBroom {
             if (collatable(collate, timestamp)) {
                 auto& lastCommand = m_undoStack.back();
                 if (lastCommand->collateWith(command.get())) {
+                    // the collated command may have grown, so measure it again
+                    auto& lastMemorySize = m_undoStackMemorySizes.back();
+                    m_undoMemoryUsage -= lastMemorySize;
+                    lastMemorySize = lastCommand->memorySize();
+                    m_undoMemoryUsage += lastMemorySize;
+                    trimUndoStack();
                     return false;
                 }
             }
@@ -387,7 +430,12 @@ namespace TrenchBroom {
                 pushToRepeatStack(command.get());
             }
 
+            const auto memorySize = command->memorySize();
             m_undoStack.push_back(std::move(command));
+            m_undoStackMemorySizes.push_back(memorySize);
+            m_undoMemoryUsage += memorySize;
+            compressUndoStack();
+            trimUndoStack();
             return true;
         }
 
@@ -396,26 +444,76 @@ namespace TrenchBroom {
             assert(!m_undoStack.empty());
 
             auto lastCommand = kdl::vec_pop_back(m_undoStack);
+            m_undoMemoryUsage -= kdl::vec_pop_back(m_undoStackMemorySizes);
             popFromRepeatStack(lastCommand.get());
             return lastCommand;
         }
 
+        void CommandProcessor::compressUndoStack() {
+            assert(m_transactionStack.empty());
+
+            static const size_t UncompressedCommandCount = 8u;
+            if (m_undoStack.size() <= UncompressedCommandCount) {
+                return;
+            }
+
+            // every push moves exactly one command behind the most recent ones, so the older commands have already
+            // been compressed
+            const auto index = m_undoStack.size() - UncompressedCommandCount - 1u;
+            m_undoStack[index]->compressSnapshots();
+
+            auto& memorySize = m_undoStackMemorySizes[index];
+            m_undoMemoryUsage -= memorySize;
+            memorySize = m_undoStack[index]->memorySize();
+            m_undoMemoryUsage += memorySize;
+        }
+
+        void CommandProcessor::trimUndoStack() {
+            assert(m_transactionStack.empty());
+
+            if (m_undoMemoryBudget == 0u || undoMemoryUsage() <= m_undoMemoryBudget || m_undoStack.size() <= 1u) {
+                return;
+            }
+
+            size_t count = 0u;
+            while (undoMemoryUsage() > m_undoMemoryBudget && m_undoStack.size() - count > 1u) {
+                auto* command = m_undoStack[count].get();
+                m_repeatStack.erase(std::remove(std::begin(m_repeatStack), std::end(m_repeatStack), command), std::end(m_repeatStack));
+                m_undoMemoryUsage -= m_undoStackMemorySizes[count];
+                ++count;
+            }
+
+            const auto first = static_cast<std::ptrdiff_t>(count);
+            m_undoStack.erase(std::begin(m_undoStack), std::next(std::begin(m_undoStack), first));
+            m_undoStackMemorySizes.erase(std::begin(m_undoStackMemorySizes), std::next(std::begin(m_undoStackMemorySizes), first));
+        }
+
         bool CommandProcessor::collatable(const bool collate, const std::chrono::system_clock::time_point timestamp) const {
             return collate && !m_undoStack.empty() && timestamp - m_lastCommandTimestamp <= m_collationInterval;
         }
 
         void CommandProcessor::pushToRedoStack(std::unique_ptr<UndoableCommand> command) {
             assert(m_transactionStack.empty());
+            const auto memorySize = command->memorySize();
             m_redoStack.push_back(std::move(command));
+            m_redoStackMemorySizes.push_back(memorySize);
+            m_redoMemoryUsage += memorySize;
         }
 
         std::unique_ptr<UndoableCommand> CommandProcessor::popFromRedoStack() {
             assert(m_transactionStack.empty());
             assert(!m_redoStack.empty());
 
+            m_redoMemoryUsage -= kdl::vec_pop_back(m_redoStackMemorySizes);
             return kdl::vec_pop_back(m_redoStack);
         }
 
+        void CommandProcessor::clearRedoStack() {
+            m_redoStack.clear();
+            m_redoStackMemorySizes.clear();
+            m_redoMemoryUsage = 0u;
+        }
+
         void CommandProcessor::pushToRepeatStack(UndoableCommand* command) {
             if (command->isRepeatDelimiter()) {
                 return;
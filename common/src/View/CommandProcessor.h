@@ -69,12 +69,40 @@ namespace TrenchBroom {
              */
             std::vector<std::unique_ptr<UndoableCommand>> m_undoStack;
 
+            /**
+             * Holds the memory size of each command on the undo stack, measured when the command was pushed. The
+             * element at index i belongs to the command at index i of the undo stack.
+             */
+            std::vector<size_t> m_undoStackMemorySizes;
+
+            /**
+             * The sum of the memory sizes of the commands on the undo stack.
+             */
+            size_t m_undoMemoryUsage;
+
+            /**
+             * The maximum number of bytes the undo and redo stacks may use together before the oldest commands on the
+             * undo stack are discarded, or 0 if the undo stack is unlimited.
+             */
+            size_t m_undoMemoryBudget;
+
             /**
              * Holds the commands that were undone, with the most recently undone command at the beginning of
              * the vector.
              */
             std::vector<std::unique_ptr<UndoableCommand>> m_redoStack;
 
+            /**
+             * Holds the memory size of each command on the redo stack, measured when the command was pushed. The
+             * element at index i belongs to the command at index i of the redo stack.
+             */
+            std::vector<size_t> m_redoStackMemorySizes;
+
+            /**
+             * The sum of the memory sizes of the commands on the redo stack.
+             */
+            size_t m_redoMemoryUsage;
+
             /**
              * Holds the commands that can be repeated. The commands referenced here are owned by the undo or redo stack.
              * Updates to the undo or redo stacks take care to erase stale pointers from the repeat stack as needed.
@@ -293,6 +321,29 @@ namespace TrenchBroom {
              * commands are deleted as well.
              */
             void clear();
+
+            /**
+             * Returns the approximate number of bytes used by the commands on the undo and redo stacks.
+             */
+            size_t undoMemoryUsage() const;
+
+            /**
+             * Returns the maximum number of bytes the undo and redo stacks may use, or 0 if they are unlimited.
+             */
+            size_t undoMemoryBudget() const;
+
+            /**
+             * Sets the maximum number of bytes the undo and redo stacks may use together. If they exceed this budget,
+             * the oldest commands on the undo stack are discarded until they fit again, but the most recent command
+             * is always kept. The redo stack is never trimmed because it is discarded as a whole as soon as the next
+             * command is executed. Passing 0 makes the undo stack unlimited.
+             *
+             * Since the snapshots of older commands are compressed, the budget is a last resort that should only be
+             * needed for very large maps.
+             *
+             * @param budget the budget in bytes
+             */
+            void setUndoMemoryBudget(size_t budget);
         private:
             /**
              * Executes and stores the given command. The command will only be stored if it was executed successfully
@@ -394,6 +445,19 @@ namespace TrenchBroom {
              */
             std::unique_ptr<UndoableCommand> popFromUndoStack();
 
+            /**
+             * Compresses the snapshots of the command that has just fallen behind the most recent commands on the
+             * undo stack and measures its memory size again. The most recent commands are left alone because they are
+             * the most likely to be undone, and because the topmost command may still be collated with.
+             */
+            void compressUndoStack();
+
+            /**
+             * Discards the oldest commands from the undo stack until the memory usage of the undo and redo stacks does
+             * not exceed the budget anymore. The most recent command is never discarded.
+             */
+            void trimUndoStack();
+
             bool collatable(bool collate, std::chrono::system_clock::time_point timestamp) const;
 
             /**
@@ -412,6 +476,11 @@ namespace TrenchBroom {
              */
             std::unique_ptr<UndoableCommand> popFromRedoStack();
 
+            /**
+             * Discards all commands on the redo stack.
+             */
+            void clearRedoStack();
+
             /**
              * Pushes the given command onto the repeat stack unless it is a repeat delimiter.
              *
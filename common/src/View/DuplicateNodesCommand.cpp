@@ -20,6 +20,7 @@
 #include "DuplicateNodesCommand.h"
 
 #include "Model/FindLayerVisitor.h"
+#include "Model/ModelUtils.h"
 #include "Model/Node.h"
 #include "Model/NodeVisitor.h"
 #include "Model/LayerNode.h"
@@ -130,5 +131,17 @@ namespace TrenchBroom {
         bool DuplicateNodesCommand::doCollateWith(UndoableCommand*) {
             return false;
         }
+
+        size_t DuplicateNodesCommand::doGetMemorySize() const {
+            size_t result = sizeof(DuplicateNodesCommand);
+            result += (m_previouslySelectedNodes.capacity() + m_nodesToSelect.capacity()) * sizeof(Model::Node*);
+            result += Model::memorySize(m_addedNodes);
+
+            // the added nodes are owned by the document unless this command has been undone
+            if (state() == CommandState::Default) {
+                result += Model::memorySize(Model::collectChildren(m_addedNodes));
+            }
+            return result;
+        }
     }
 }
@@ -139,6 +139,7 @@ namespace TrenchBroom {
             document->documentWasLoadedNotifier.addObserver(this, &EntityBrowser::documentWasLoaded);
             document->modsDidChangeNotifier.addObserver(this, &EntityBrowser::modsDidChange);
             document->entityDefinitionsDidChangeNotifier.addObserver(this, &EntityBrowser::entityDefinitionsDidChange);
+            document->entityModelsWereLoadedNotifier.addObserver(this, &EntityBrowser::entityModelsWereLoaded);
 
             PreferenceManager& prefs = PreferenceManager::instance();
             prefs.preferenceDidChangeNotifier.addObserver(this, &EntityBrowser::preferenceDidChange);
@@ -151,6 +152,7 @@ namespace TrenchBroom {
                 document->documentWasLoadedNotifier.removeObserver(this, &EntityBrowser::documentWasLoaded);
                 document->modsDidChangeNotifier.removeObserver(this, &EntityBrowser::modsDidChange);
                 document->entityDefinitionsDidChangeNotifier.removeObserver(this, &EntityBrowser::entityDefinitionsDidChange);
+                document->entityModelsWereLoadedNotifier.removeObserver(this, &EntityBrowser::entityModelsWereLoaded);
             }
 
             PreferenceManager& prefs = PreferenceManager::instance();
@@ -173,6 +175,11 @@ namespace TrenchBroom {
             reload();
         }
 
+        void EntityBrowser::entityModelsWereLoaded() {
+            // the layout was computed using the definition bounds of the entities whose models were still loading
+            reload();
+        }
+
         void EntityBrowser::preferenceDidChange(const IO::Path& path) {
             auto document = kdl::mem_lock(m_document);
             if (document->isGamePathPreference(path)) {
@@ -65,6 +65,7 @@ namespace TrenchBroom {
 
             void modsDidChange();
             void entityDefinitionsDidChange();
+            void entityModelsWereLoaded();
             void preferenceDidChange(const IO::Path& path);
         };
     }
@@ -232,6 +232,7 @@ namespace TrenchBroom {
             const vm::mat4x4f view = vm::view_matrix(vm::vec3f::neg_x(), vm::vec3f::pos_z()) *vm::translation_matrix(vm::vec3f(256.0f, 0.0f, 0.0f));
             Renderer::Transformation transformation(projection, view);
 
+            // the models requested here are committed by a timer in MapFrame, and EntityBrowser reloads when they arrive
             renderBounds(layout, y, height);
             renderModels(layout, y, height, transformation);
             renderNames(layout, y, height, projection);
@@ -297,6 +298,7 @@ namespace TrenchBroom {
             shader.set("ApplyTinting", false);
             shader.set("Brightness", pref(Preferences::Brightness));
             shader.set("GrayScale", false);
+            shader.setAttribute("InstanceMatrix", vm::mat4x4f::identity());
 
             glAssert(glFrontFace(GL_CW));
 
@@ -20,7 +20,7 @@
 #include "IssueBrowserView.h"
 
 #include "Ensure.h"
-#include "Model/CollectMatchingIssuesVisitor.h"
+#include "Model/CollectNodesVisitor.h"
 #include "Model/Issue.h"
 #include "Model/IssueQuickFix.h"
 #include "Model/WorldNode.h"
@@ -30,6 +30,8 @@
 #include <kdl/vector_utils.h>
 #include <kdl/vector_set.h>
 
+#include <algorithm>
+#include <iterator>
 #include <vector>
 
 #include <QHBoxLayout>
@@ -45,7 +47,8 @@ namespace TrenchBroom {
         m_document(document),
         m_hiddenGenerators(0),
         m_showHiddenIssues(false),
-        m_valid(false) {
+        m_valid(false),
+        m_nextPendingNode(0u) {
             createGui();
             bindEvents();
         }
@@ -134,12 +137,58 @@ namespace TrenchBroom {
             Model::WorldNode* world = document->world();
             if (world != nullptr) {
                 const std::vector<Model::IssueGenerator*>& issueGenerators = world->registeredIssueGenerators();
-                Model::CollectMatchingIssuesVisitor<IssueVisible> visitor(issueGenerators, IssueVisible(m_hiddenGenerators, m_showHiddenIssues));
-                world->acceptAndRecurse(visitor);
+                const IssueVisible issueVisible(m_hiddenGenerators, m_showHiddenIssues);
+
+                const auto collectVisibleIssues = [&](const std::vector<Model::Node*>& nodes) {
+                    std::vector<Model::Issue*> issues;
+                    for (Model::Node* node : nodes) {
+                        for (Model::Issue* issue : node->issues(issueGenerators)) {
+                            if (issueVisible(issue)) {
+                                issues.push_back(issue);
+                            }
+                        }
+                    }
+                    return issues;
+                };
+
+                if (m_pendingNodes.empty()) {
+                    Model::CollectNodesVisitor collectNodes;
+                    world->acceptAndRecurse(collectNodes);
+
+                    std::vector<Model::Node*> validNodes;
+                    for (Model::Node* node : collectNodes.nodes()) {
+                        if (node->issuesValid()) {
+                            validNodes.push_back(node);
+                        } else {
+                            m_pendingNodes.push_back(node);
+                        }
+                    }
+                    m_nextPendingNode = 0u;
+                    m_tableModel->setIssues(collectVisibleIssues(validNodes));
+                }
+
+                // validate the nodes in batches so that the issues found so far are shown while validation continues
+                const size_t batchEnd = std::min(m_nextPendingNode + ValidationBatchSize, m_pendingNodes.size());
+                const auto batch = std::vector<Model::Node*>(std::next(std::begin(m_pendingNodes), static_cast<std::ptrdiff_t>(m_nextPendingNode)),
+                                                             std::next(std::begin(m_pendingNodes), static_cast<std::ptrdiff_t>(batchEnd)));
+                m_nextPendingNode = batchEnd;
+
+                Model::Node::validateIssues(batch, issueGenerators);
+                m_tableModel->addIssues(collectVisibleIssues(batch));
+
+                if (m_nextPendingNode < m_pendingNodes.size()) {
+                    // continue with the next batch without restarting the validation pass
+                    m_valid = false;
+                    QMetaObject::invokeMethod(this, "validate", Qt::QueuedConnection);
+                } else {
+                    // the issues are only sorted once all of them have been found
+                    m_pendingNodes.clear();
+                    m_nextPendingNode = 0u;
 
-                std::vector<Model::Issue*> issues = visitor.issues();
-                kdl::vec_sort(issues, IssueCmp());
-                m_tableModel->setIssues(std::move(issues));
+                    std::vector<Model::Issue*> issues = m_tableModel->issues();
+                    kdl::vec_sort(issues, IssueCmp());
+                    m_tableModel->setIssues(std::move(issues));
+                }
             }
         }
 
@@ -259,6 +308,9 @@ namespace TrenchBroom {
         }
 
         void IssueBrowserView::invalidate() {
+            // restart validation, the nodes of a validation pass in progress may have been removed
+            m_pendingNodes.clear();
+            m_nextPendingNode = 0u;
             m_valid = false;
 
             QMetaObject::invokeMethod(this, "validate", Qt::QueuedConnection);
@@ -284,6 +336,17 @@ namespace TrenchBroom {
             endResetModel();
         }
 
+        void IssueBrowserModel::addIssues(const std::vector<Model::Issue*>& issues) {
+            if (issues.empty()) {
+                return;
+            }
+
+            const int first = static_cast<int>(m_issues.size());
+            beginInsertRows(QModelIndex(), first, first + static_cast<int>(issues.size()) - 1);
+            m_issues.insert(std::end(m_issues), std::begin(issues), std::end(issues));
+            endInsertRows();
+        }
+
         const std::vector<Model::Issue*>& IssueBrowserModel::issues() {
             return m_issues;
         }
@@ -35,6 +35,7 @@ namespace TrenchBroom {
     namespace Model {
         class Issue;
         class IssueQuickFix;
+        class Node;
     }
 
     namespace View {
@@ -44,6 +45,8 @@ namespace TrenchBroom {
         class IssueBrowserView : public QWidget {
             Q_OBJECT
         private:
+            static const size_t ValidationBatchSize = 4096;
+
             std::weak_ptr<MapDocument> m_document;
 
             int m_hiddenGenerators;
@@ -51,6 +54,13 @@ namespace TrenchBroom {
 
             bool m_valid;
 
+            /**
+             * The nodes whose issues are validated by the current validation pass, and the index of the first node
+             * that has not been validated yet. Empty if no validation pass is in progress.
+             */
+            std::vector<Model::Node*> m_pendingNodes;
+            size_t m_nextPendingNode;
+
             QTableView* m_tableView;
             IssueBrowserModel* m_tableModel;
         public:
@@ -102,6 +112,7 @@ namespace TrenchBroom {
             explicit IssueBrowserModel(QObject* parent);
 
             void setIssues(std::vector<Model::Issue*> issues);
+            void addIssues(const std::vector<Model::Issue*>& issues);
             const std::vector<Model::Issue*>& issues();
         public: // QAbstractTableModel overrides
             int rowCount(const QModelIndex& parent) const override;
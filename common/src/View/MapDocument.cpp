@@ -28,11 +28,14 @@
 #include "Assets/EntityDefinitionManager.h"
 #include "Assets/EntityModelManager.h"
 #include "Assets/Texture.h"
+#include "Assets/TextureCollection.h"
 #include "Assets/TextureManager.h"
 #include "EL/ELExceptions.h"
 #include "IO/DiskFileSystem.h"
 #include "IO/DiskIO.h"
+#include "IO/FileCache.h"
 #include "IO/GameConfigParser.h"
+#include "IO/ImageFileSystem.h"
 #include "IO/SimpleParserStatus.h"
 #include "IO/SystemPaths.h"
 #include "Model/AttributeNameWithDoubleQuotationMarksIssueGenerator.h"
@@ -61,6 +64,7 @@
 #include "Model/EntityNode.h"
 #include "Model/FindGroupVisitor.h"
 #include "Model/FindLayerVisitor.h"
+#include "Model/LayerNode.h"
 #include "Model/LinkSourceIssueGenerator.h"
 #include "Model/LinkTargetIssueGenerator.h"
 #include "Model/LockState.h"
@@ -144,6 +148,7 @@
 #include <sstream>
 #include <string>
 #include <type_traits>
+#include <unordered_set>
 #include <vector>
 
 namespace TrenchBroom {
@@ -177,6 +182,7 @@ namespace TrenchBroom {
         m_selectionBoundsValid(true),
         m_viewEffectsService(nullptr) {
                 bindObservers();
+                updateFileCacheCapacity();
         }
 
         MapDocument::~MapDocument() {
@@ -1912,6 +1918,19 @@ namespace TrenchBroom {
             doClearRepeatableCommands();
         }
 
+        size_t MapDocument::undoMemoryUsage() const {
+            return doGetUndoMemoryUsage();
+        }
+
+        size_t MapDocument::undoMemoryBudget() const {
+            return doGetUndoMemoryBudget();
+        }
+
+        void MapDocument::updateUndoMemoryBudget() {
+            const auto budgetInMegabytes = static_cast<size_t>(std::max(0, pref(Preferences::UndoMemoryBudget)));
+            doSetUndoMemoryBudget(budgetInMegabytes * 1024u * 1024u);
+        }
+
         void MapDocument::startTransaction(const std::string& name) {
             debug("Starting transaction '" + name + "'");
             doStartTransaction(name);
@@ -1941,8 +1960,22 @@ namespace TrenchBroom {
             return doExecuteAndStore(std::move(command));
         }
 
+        void MapDocument::commitLoadedAssets() {
+            m_textureManager->commitLoadedCollections();
+            m_entityModelManager->commitLoadedModels();
+        }
+
+        bool MapDocument::hasPendingLoads() const {
+            return m_textureManager->hasPendingLoads() || m_entityModelManager->hasPendingLoads();
+        }
+
         void MapDocument::commitPendingAssets() {
             m_textureManager->commitChanges();
+            m_entityModelManager->commitLoadedModels();
+        }
+
+        bool MapDocument::hasPendingUploads() const {
+            return m_textureManager->hasPendingChanges();
         }
 
         void MapDocument::pick(const vm::ray3& pickRay, Model::PickResult& pickResult) const {
@@ -1981,6 +2014,8 @@ namespace TrenchBroom {
         void MapDocument::clearWorld() {
             m_world.reset();
             m_currentLayer = nullptr;
+            m_entitiesAwaitingModels.clear();
+            m_awaitedModelPaths.clear();
         }
 
         Assets::EntityDefinitionFileSpec MapDocument::entityDefinitionFile() const {
@@ -2114,7 +2149,7 @@ namespace TrenchBroom {
                 const Model::Brush& brush = brushNode->brush();
                 for (size_t i = 0u; i < brush.faceCount(); ++i) {
                     const Model::BrushFace& face = brush.face(i);
-                    Assets::Texture* texture = m_manager.texture(face.attributes().textureName());
+                    Assets::Texture* texture = m_manager.texture(face.attributes().internedTextureName());
                     brushNode->setFaceTexture(i, texture);
                 }
             }
@@ -2148,7 +2183,7 @@ namespace TrenchBroom {
             for (const auto& faceHandle : faceHandles) {
                 Model::BrushNode* node = faceHandle.node();
                 const Model::BrushFace& face = faceHandle.face();
-                Assets::Texture* texture = m_textureManager->texture(face.attributes().textureName());
+                Assets::Texture* texture = m_textureManager->texture(face.attributes().internedTextureName());
                 node->setFaceTexture(faceHandle.faceIndex(), texture);
             }
         }
@@ -2225,32 +2260,46 @@ namespace TrenchBroom {
 
         class MapDocument::SetEntityModels : public Model::NodeVisitor {
         private:
-            Logger& m_logger;
+            MapDocument& m_document;
             Assets::EntityModelManager& m_manager;
         public:
-            explicit SetEntityModels(Logger& logger, Assets::EntityModelManager& manager) :
-            m_logger(logger),
+            SetEntityModels(MapDocument& document, Assets::EntityModelManager& manager) :
+            m_document(document),
             m_manager(manager) {}
         private:
             void doVisit(Model::WorldNode*) override         {}
             void doVisit(Model::LayerNode*) override         {}
             void doVisit(Model::GroupNode*) override         {}
             void doVisit(Model::EntityNode* entity) override {
-                const auto modelSpec = Assets::safeGetModelSpecification(m_logger, entity->classname(), [&]() {
+                const auto modelSpec = Assets::safeGetModelSpecification(m_document, entity->classname(), [&]() {
                     return entity->modelSpecification();
                 });
                 const auto* frame = m_manager.frame(modelSpec);
                 entity->setModelFrame(frame);
+
+                m_document.removeEntityAwaitingModel(entity);
+                if (frame == nullptr && !modelSpec.path.isEmpty()) {
+                    // the model may still be loading, see entityModelsWereLoaded
+                    m_document.addEntityAwaitingModel(entity, modelSpec.path);
+                }
             }
             void doVisit(Model::BrushNode*) override         {}
         };
 
         class MapDocument::UnsetEntityModels : public Model::NodeVisitor {
+        private:
+            MapDocument& m_document;
+        public:
+            explicit UnsetEntityModels(MapDocument& document) :
+            m_document(document) {}
         private:
             void doVisit(Model::WorldNode*) override         {}
             void doVisit(Model::LayerNode*) override         {}
             void doVisit(Model::GroupNode*) override         {}
-            void doVisit(Model::EntityNode* entity) override { entity->setModelFrame(nullptr); }
+            void doVisit(Model::EntityNode* entity) override {
+                entity->setModelFrame(nullptr);
+                m_document.removeEntityAwaitingModel(entity);
+            }
             void doVisit(Model::BrushNode*) override         {}
         };
 
@@ -2265,15 +2314,62 @@ namespace TrenchBroom {
         }
 
         void MapDocument::unsetEntityModels() {
-            UnsetEntityModels visitor;
+            UnsetEntityModels visitor(*this);
             m_world->acceptAndRecurse(visitor);
         }
 
         void MapDocument::unsetEntityModels(const std::vector<Model::Node*>& nodes) {
-            UnsetEntityModels visitor;
+            UnsetEntityModels visitor(*this);
             Model::Node::acceptAndRecurse(std::begin(nodes), std::end(nodes), visitor);
         }
 
+        void MapDocument::addEntityAwaitingModel(Model::EntityNode* entity, const IO::Path& modelPath) {
+            m_entitiesAwaitingModels[modelPath].push_back(entity);
+            m_awaitedModelPaths.insert({ entity, modelPath });
+        }
+
+        void MapDocument::removeEntityAwaitingModel(Model::EntityNode* entity) {
+            auto pathIt = m_awaitedModelPaths.find(entity);
+            if (pathIt == std::end(m_awaitedModelPaths)) {
+                return;
+            }
+
+            auto entitiesIt = m_entitiesAwaitingModels.find(pathIt->second);
+            assert(entitiesIt != std::end(m_entitiesAwaitingModels));
+            kdl::vec_erase(entitiesIt->second, entity);
+            if (entitiesIt->second.empty()) {
+                m_entitiesAwaitingModels.erase(entitiesIt);
+            }
+            m_awaitedModelPaths.erase(pathIt);
+        }
+
+        std::unique_ptr<Model::WorldNode> MapDocument::cloneWorldForSaving() {
+            ensure(m_world != nullptr, "world is null");
+
+            // the copies only reference the assets briefly, so their observers need not be bothered
+            Assets::TextureCollection::SuppressUsageCountNotifications suppressNotifications;
+
+            auto world = std::unique_ptr<Model::WorldNode>(static_cast<Model::WorldNode*>(m_world->cloneRecursively(m_worldBounds)));
+
+            // cloning does not copy the attributes of the world and its layers
+            world->setAttributes(m_world->attributes());
+            const auto layers = m_world->allLayers();
+            const auto layerClones = world->allLayers();
+            assert(layers.size() == layerClones.size());
+            for (size_t i = 0u; i < layers.size(); ++i) {
+                layerClones[i]->setAttributes(layers[i]->attributes());
+            }
+
+            UnsetTextures unsetTextures;
+            UnsetEntityDefinitions unsetEntityDefinitions;
+            UnsetEntityModels unsetEntityModels(*this);
+            world->acceptAndRecurse(unsetTextures);
+            world->acceptAndRecurse(unsetEntityDefinitions);
+            world->acceptAndRecurse(unsetEntityModels);
+
+            return world;
+        }
+
         std::vector<IO::Path> MapDocument::externalSearchPaths() const {
             std::vector<IO::Path> searchPaths;
             if (!m_path.isEmpty() && m_path.isAbsolute()) {
@@ -2290,6 +2386,9 @@ namespace TrenchBroom {
         }
 
         void MapDocument::updateGameSearchPaths() {
+            // texture collections may still be decoded from the game file system on worker threads
+            m_textureManager->waitForPendingLoads();
+
             const std::vector<IO::Path> additionalSearchPaths = IO::Path::asPaths(mods());
             m_game->setAdditionalSearchPaths(additionalSearchPaths, logger());
         }
@@ -2508,6 +2607,11 @@ namespace TrenchBroom {
             documentModificationStateDidChangeNotifier();
         }
 
+        void MapDocument::updateFileCacheCapacity() {
+            const auto capacityInMegabytes = static_cast<size_t>(std::max(0, pref(Preferences::FileCacheCapacity)));
+            IO::ImageFileSystemBase::fileCache().setCapacity(capacityInMegabytes * 1024u * 1024u);
+        }
+
         void MapDocument::bindObservers() {
             PreferenceManager& prefs = PreferenceManager::instance();
             prefs.preferenceDidChangeNotifier.addObserver(this, &MapDocument::preferenceDidChange);
@@ -2525,6 +2629,9 @@ namespace TrenchBroom {
             brushFacesDidChangeNotifier.addObserver(this, &MapDocument::updateFaceTags);
             modsDidChangeNotifier.addObserver(this, &MapDocument::updateAllFaceTags);
             textureCollectionsDidChangeNotifier.addObserver(this, &MapDocument::updateAllFaceTags);
+
+            m_entityModelManager->modelsWereLoadedNotifier.addObserver(this, &MapDocument::entityModelsWereLoaded);
+            m_textureManager->collectionsWereLoadedNotifier.addObserver(this, &MapDocument::textureCollectionsWereLoaded);
         }
 
         void MapDocument::unbindObservers() {
@@ -2544,24 +2651,91 @@ namespace TrenchBroom {
             brushFacesDidChangeNotifier.removeObserver(this, &MapDocument::updateFaceTags);
             modsDidChangeNotifier.removeObserver(this, &MapDocument::updateAllFaceTags);
             textureCollectionsDidChangeNotifier.removeObserver(this, &MapDocument::updateAllFaceTags);
+
+            m_entityModelManager->modelsWereLoadedNotifier.removeObserver(this, &MapDocument::entityModelsWereLoaded);
+            m_textureManager->collectionsWereLoadedNotifier.removeObserver(this, &MapDocument::textureCollectionsWereLoaded);
         }
 
         void MapDocument::preferenceDidChange(const IO::Path& path) {
             if (isGamePathPreference(path)) {
                 const Model::GameFactory& gameFactory = Model::GameFactory::instance();
                 const IO::Path newGamePath = gameFactory.gamePath(m_game->gameName());
-                m_game->setGamePath(newGamePath, logger());
 
+                // entity models and texture collections may still be loaded from the game file system on worker threads
                 clearEntityModels();
+                unloadTextures();
+                m_game->setGamePath(newGamePath, logger());
                 setEntityModels();
 
-                reloadTextures();
+                m_game->reloadShaders();
+                loadTextures();
                 setTextures();
             } else if (path == Preferences::TextureMinFilter.path() ||
                        path == Preferences::TextureMagFilter.path()) {
                 m_entityModelManager->setTextureMode(pref(Preferences::TextureMinFilter), pref(Preferences::TextureMagFilter));
                 m_textureManager->setTextureMode(pref(Preferences::TextureMinFilter), pref(Preferences::TextureMagFilter));
+            } else if (path == Preferences::UndoMemoryBudget.path()) {
+                updateUndoMemoryBudget();
+            } else if (path == Preferences::FileCacheCapacity.path()) {
+                updateFileCacheCapacity();
+            }
+        }
+
+        void MapDocument::entityModelsWereLoaded(const std::vector<IO::Path>& paths) {
+            // entities whose models were still loading use their definition bounds until now
+            std::vector<Model::Node*> nodes;
+            for (const auto& path : paths) {
+                auto it = m_entitiesAwaitingModels.find(path);
+                if (it != std::end(m_entitiesAwaitingModels)) {
+                    nodes.insert(std::end(nodes), std::begin(it->second), std::end(it->second));
+                }
+            }
+
+            if (!nodes.empty()) {
+                const std::vector<Model::Node*> parents = collectParents(nodes);
+
+                Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
+                Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+
+                setEntityModels(nodes);
+                invalidateSelectionBounds();
+            }
+
+            entityModelsWereLoadedNotifier();
+        }
+
+        void MapDocument::textureCollectionsWereLoaded(const std::vector<Assets::TextureCollection*>& collections) {
+            Notifier<>::NotifyBeforeAndAfter notifyTextureCollections(textureCollectionsWillChangeNotifier, textureCollectionsDidChangeNotifier);
+            if (m_world == nullptr) {
+                return;
             }
+
+            // only the faces whose textures were still being decoded have no textures until now
+            auto loadedTextures = std::unordered_set<const Assets::Texture*>();
+            for (const auto* collection : collections) {
+                const auto& textures = collection->textures();
+                loadedTextures.insert(std::begin(textures), std::end(textures));
+            }
+
+            const auto usesLoadedTexture = [&](const Model::BrushNode* /* brushNode */, const Model::BrushFace& face) {
+                return loadedTextures.count(m_textureManager->texture(face.attributes().internedTextureName())) > 0u;
+            };
+
+            Model::CollectMatchingBrushFacesVisitor<decltype(usesLoadedTexture)> visitor(usesLoadedTexture);
+            m_world->acceptAndRecurse(visitor);
+
+            const auto& faceHandles = visitor.faces();
+            if (faceHandles.empty()) {
+                return;
+            }
+
+            auto brushNodes = Model::toNodes(faceHandles);
+            kdl::vec_sort_and_remove_duplicates(brushNodes);
+
+            const auto nodes = kdl::vec_element_cast<Model::Node*>(brushNodes);
+            Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+
+            setTextures(faceHandles);
         }
 
         void MapDocument::commandDone(Command* command) {
@@ -48,6 +48,7 @@ namespace TrenchBroom {
         class EntityDefinitionManager;
         class EntityModelManager;
         class Texture;
+        class TextureCollection;
         class TextureManager;
     }
 
@@ -56,6 +57,7 @@ namespace TrenchBroom {
         class BrushFaceHandle;
         class BrushFaceAttributes;
         class EditorContext;
+        class EntityNode;
         enum class ExportFormat;
         class Game;
         class Issue;
@@ -122,6 +124,13 @@ namespace TrenchBroom {
             mutable vm::bbox3 m_selectionBounds;
             mutable bool m_selectionBoundsValid;
 
+            /**
+             * The entities whose models were still loading when their model frames were set, indexed by the model
+             * path, and the reverse mapping so that entities can be removed from the index.
+             */
+            std::map<IO::Path, std::vector<Model::EntityNode*>> m_entitiesAwaitingModels;
+            std::map<Model::EntityNode*, IO::Path> m_awaitedModelPaths;
+
             ViewEffectsService* m_viewEffectsService;
         public: // notification
             Notifier<Command*> commandDoNotifier;
@@ -166,6 +175,7 @@ namespace TrenchBroom {
             Notifier<> textureCollectionsDidChangeNotifier;
 
             Notifier<> entityDefinitionsDidChangeNotifier;
+            Notifier<> entityModelsWereLoadedNotifier;
             Notifier<> modsDidChangeNotifier;
 
             Notifier<> pointFileWasLoadedNotifier;
@@ -247,6 +257,11 @@ namespace TrenchBroom {
             void saveDocument();
             void saveDocumentAs(const IO::Path& path);
             void saveDocumentTo(const IO::Path& path);
+            /**
+             * Returns a copy of the world that does not reference any textures, entity definitions or entity models of
+             * this document. The copy can be saved and destroyed on another thread while this document changes.
+             */
+            std::unique_ptr<Model::WorldNode> cloneWorldForSaving();
             void exportDocumentAs(Model::ExportFormat format, const IO::Path& path);
         private:
             void doSaveDocument(const IO::Path& path);
@@ -439,6 +454,10 @@ namespace TrenchBroom {
             bool canRepeatCommands() const;
             std::unique_ptr<CommandResult> repeatCommands();
             void clearRepeatableCommands();
+            size_t undoMemoryUsage() const;
+            size_t undoMemoryBudget() const;
+        protected:
+            void updateUndoMemoryBudget();
         public: // transactions
             void startTransaction(const std::string& name = "");
             void rollbackTransaction();
@@ -457,6 +476,9 @@ namespace TrenchBroom {
             virtual bool doCanRepeatCommands() const = 0;
             virtual std::unique_ptr<CommandResult> doRepeatCommands() = 0;
             virtual void doClearRepeatableCommands() = 0;
+            virtual size_t doGetUndoMemoryUsage() const = 0;
+            virtual size_t doGetUndoMemoryBudget() const = 0;
+            virtual void doSetUndoMemoryBudget(size_t budget) = 0;
 
             virtual void doStartTransaction(const std::string& name) = 0;
             virtual void doCommitTransaction() = 0;
@@ -465,7 +487,29 @@ namespace TrenchBroom {
             virtual std::unique_ptr<CommandResult> doExecute(std::unique_ptr<Command>&& command) = 0;
             virtual std::unique_ptr<CommandResult> doExecuteAndStore(std::unique_ptr<UndoableCommand>&& command) = 0;
         public: // asset state management
+            /**
+             * Hands the texture collections and entity models that have been loaded on worker threads over to the
+             * document. This doesn't require an OpenGL context.
+             */
+            void commitLoadedAssets();
+
+            /**
+             * Indicates whether any texture collections or entity models are still being loaded on worker threads,
+             * i.e., whether commitLoadedAssets should be called again.
+             */
+            bool hasPendingLoads() const;
+
+            /**
+             * Commits the loaded assets and uploads pending textures within the upload budget. This requires an
+             * OpenGL context.
+             */
             void commitPendingAssets();
+
+            /**
+             * Indicates whether there are textures left to upload, i.e., whether commitPendingAssets should be called
+             * again.
+             */
+            bool hasPendingUploads() const;
         public: // picking
             void pick(const vm::ray3& pickRay, Model::PickResult& pickResult) const;
             std::vector<Model::Node*> findNodesContaining(const vm::vec3& point) const;
@@ -525,6 +569,8 @@ namespace TrenchBroom {
             void setEntityModels(const std::vector<Model::Node*>& nodes);
             void unsetEntityModels();
             void unsetEntityModels(const std::vector<Model::Node*>& nodes);
+            void addEntityAwaitingModel(Model::EntityNode* entity, const IO::Path& modelPath);
+            void removeEntityAwaitingModel(Model::EntityNode* entity);
         protected: // search paths and mods
             std::vector<IO::Path> externalSearchPaths() const;
             void updateGameSearchPaths();
@@ -571,10 +617,13 @@ namespace TrenchBroom {
         private:
             void setLastSaveModificationCount();
             void clearModificationCount();
+            void updateFileCacheCapacity();
         private: // observers
             void bindObservers();
             void unbindObservers();
             void preferenceDidChange(const IO::Path& path);
+            void entityModelsWereLoaded(const std::vector<IO::Path>& paths);
+            void textureCollectionsWereLoaded(const std::vector<Assets::TextureCollection*>& collections);
             void commandDone(Command* command);
             void commandUndone(UndoableCommand* command);
         };
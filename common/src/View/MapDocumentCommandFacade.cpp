@@ -44,6 +44,7 @@
 #include "Model/NodeVisitor.h"
 #include "View/CommandProcessor.h"
 #include "View/UndoableCommand.h"
+#include "View/VertexCommand.h"
 #include "View/Selection.h"
 
 #include <kdl/map_utils.h>
@@ -59,6 +60,7 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -72,6 +74,7 @@ namespace TrenchBroom {
         MapDocumentCommandFacade::MapDocumentCommandFacade() :
         m_commandProcessor(std::make_unique<CommandProcessor>(this)) {
             bindObservers();
+            updateUndoMemoryBudget();
         }
 
         MapDocumentCommandFacade::~MapDocumentCommandFacade() = default;
@@ -757,6 +760,27 @@ namespace TrenchBroom {
             return true;
         }
 
+        /**
+         * Applies the given operation to each brush in the given map and its handles, and returns the results in the
+         * order of the map. Large numbers of brushes are processed in parallel, see
+         * VertexCommand::parallelForEachBrush. The resulting brushes can then be committed together.
+         */
+        template <typename H, typename O>
+        static std::vector<kdl::result<Model::Brush, Model::BrushError>> transformBrushes(const std::map<Model::BrushNode*, std::vector<H>>& brushToHandles, const O& operation) {
+            // the result type is not default constructible, so we collect the results in optionals first
+            std::vector<std::optional<kdl::result<Model::Brush, Model::BrushError>>> results(brushToHandles.size());
+            VertexCommand::parallelForEachBrush(brushToHandles, [&](const size_t index, const Model::Brush& brush, const std::vector<H>& handles) {
+                results[index] = operation(brush, handles);
+            });
+
+            std::vector<kdl::result<Model::Brush, Model::BrushError>> result;
+            result.reserve(results.size());
+            for (auto& brushResult : results) {
+                result.push_back(std::move(*brushResult));
+            }
+            return result;
+        }
+
         std::vector<vm::vec3> MapDocumentCommandFacade::performMoveVertices(const std::map<Model::BrushNode*, std::vector<vm::vec3>>& vertices, const vm::vec3& delta) {
             const std::vector<Model::Node*>& nodes = m_selectedNodes.nodes();
             const std::vector<Model::Node*> parents = collectParents(nodes);
@@ -764,12 +788,18 @@ namespace TrenchBroom {
             Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
             Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
 
+            const bool uvLock = pref(Preferences::UVLock);
+            auto newBrushes = transformBrushes(vertices, [&](const Model::Brush& brush, const std::vector<vm::vec3>& oldPositions) {
+                return brush.moveVertices(m_worldBounds, oldPositions, delta, uvLock);
+            });
+
             std::vector<vm::vec3> newVertexPositions;
+            auto newBrushIt = std::begin(newBrushes);
             for (const auto& entry : vertices) {
                 Model::BrushNode* brushNode = entry.first;
                 const std::vector<vm::vec3>& oldPositions = entry.second;
-                
-                brushNode->brush().moveVertices(m_worldBounds, oldPositions, delta, pref(Preferences::UVLock))
+
+                std::move(*newBrushIt++)
                     .visit(kdl::overload{
                         [&](Model::Brush&& brush) {
                             const auto newPositions = brush.findClosestVertexPositions(oldPositions + delta);
@@ -795,11 +825,17 @@ namespace TrenchBroom {
             Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
             Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
 
+            const bool uvLock = pref(Preferences::UVLock);
+            auto newBrushes = transformBrushes(edges, [&](const Model::Brush& brush, const std::vector<vm::segment3>& oldPositions) {
+                return brush.moveEdges(m_worldBounds, oldPositions, delta, uvLock);
+            });
+
             std::vector<vm::segment3> newEdgePositions;
+            auto newBrushIt = std::begin(newBrushes);
             for (const auto& entry : edges) {
                 Model::BrushNode* brushNode = entry.first;
                 const std::vector<vm::segment3>& oldPositions = entry.second;
-                brushNode->brush().moveEdges(m_worldBounds, oldPositions, delta, pref(Preferences::UVLock))
+                std::move(*newBrushIt++)
                     .visit(kdl::overload {
                         [&](Model::Brush&& brush) {
                             const auto newPositions = brush.findClosestEdgePositions(kdl::vec_transform(oldPositions, [&](const auto& s) {
@@ -827,12 +863,18 @@ namespace TrenchBroom {
             Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
             Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
 
+            const bool uvLock = pref(Preferences::UVLock);
+            auto newBrushes = transformBrushes(faces, [&](const Model::Brush& brush, const std::vector<vm::polygon3>& oldPositions) {
+                return brush.moveFaces(m_worldBounds, oldPositions, delta, uvLock);
+            });
+
             std::vector<vm::polygon3> newFacePositions;
+            auto newBrushIt = std::begin(newBrushes);
             for (const auto& entry : faces) {
                 Model::BrushNode* brushNode = entry.first;
                 const std::vector<vm::polygon3>& oldPositions = entry.second;
-                
-                brushNode->brush().moveFaces(m_worldBounds, oldPositions, delta, pref(Preferences::UVLock))
+
+                std::move(*newBrushIt++)
                     .visit(kdl::overload {
                         [&](Model::Brush&& brush) {
                             const auto newPositions = brush.findClosestFacePositions(kdl::vec_transform(oldPositions, [&](const auto& f) {
@@ -1066,6 +1108,18 @@ namespace TrenchBroom {
             m_commandProcessor->clearRepeatStack();
         }
 
+        size_t MapDocumentCommandFacade::doGetUndoMemoryUsage() const {
+            return m_commandProcessor->undoMemoryUsage();
+        }
+
+        size_t MapDocumentCommandFacade::doGetUndoMemoryBudget() const {
+            return m_commandProcessor->undoMemoryBudget();
+        }
+
+        void MapDocumentCommandFacade::doSetUndoMemoryBudget(const size_t budget) {
+            m_commandProcessor->setUndoMemoryBudget(budget);
+        }
+
         void MapDocumentCommandFacade::doStartTransaction(const std::string& name) {
             m_commandProcessor->startTransaction(name);
         }
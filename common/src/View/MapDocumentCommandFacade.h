@@ -161,6 +161,9 @@ namespace TrenchBroom {
             bool doCanRepeatCommands() const override;
             std::unique_ptr<CommandResult> doRepeatCommands() override;
             void doClearRepeatableCommands() override;
+            size_t doGetUndoMemoryUsage() const override;
+            size_t doGetUndoMemoryBudget() const override;
+            void doSetUndoMemoryBudget(size_t budget) override;
 
             void doStartTransaction(const std::string& name) override;
             void doCommitTransaction() override;
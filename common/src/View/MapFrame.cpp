@@ -107,6 +107,7 @@ namespace TrenchBroom {
         m_lastInputTime(std::chrono::system_clock::now()),
         m_autosaver(std::make_unique<Autosaver>(m_document)),
         m_autosaveTimer(nullptr),
+        m_assetLoadTimer(nullptr),
         m_toolBar(nullptr),
         m_hSplitter(nullptr),
         m_vSplitter(nullptr),
@@ -118,6 +119,7 @@ namespace TrenchBroom {
         m_inspector(nullptr),
         m_gridChoice(nullptr),
         m_statusBarLabel(nullptr),
+        m_undoMemoryLabel(nullptr),
         m_compilationDialog(nullptr),
         m_recentDocumentsMenu(nullptr),
         m_undoAction(nullptr),
@@ -146,6 +148,9 @@ namespace TrenchBroom {
             m_autosaveTimer = new QTimer(this);
             m_autosaveTimer->start(1000);
 
+            m_assetLoadTimer = new QTimer(this);
+            m_assetLoadTimer->start(100);
+
             bindObservers();
             bindEvents();
 
@@ -166,6 +171,9 @@ namespace TrenchBroom {
             // so we don't try to log to a dangling pointer (#1885).
             m_document->setParentLogger(nullptr);
 
+            // A pending autosave reports to m_console, which is about to be destroyed.
+            m_autosaver->finishAutosave();
+
             m_mapView->deactivateTool();
 
             unbindObservers();
@@ -182,6 +190,7 @@ namespace TrenchBroom {
             // let's trigger a final autosave before releasing the document
             NullLogger logger;
             m_autosaver->triggerAutosave(logger);
+            m_autosaver->finishAutosave();
 
             m_document->setViewEffectsService(nullptr);
             m_document.reset();
@@ -270,6 +279,16 @@ namespace TrenchBroom {
                     m_redoAction->setEnabled(false);
                 }
             }
+            if (m_undoMemoryLabel != nullptr) {
+                const auto toMegabytes = [](const size_t bytes) { return static_cast<double>(bytes) / (1024.0 * 1024.0); };
+                const auto usage = toMegabytes(document->undoMemoryUsage());
+                const auto budget = document->undoMemoryBudget();
+                if (budget > 0u) {
+                    m_undoMemoryLabel->setText(tr("Undo history: %1 / %2 MB").arg(usage, 0, 'f', 1).arg(toMegabytes(budget), 0, 'f', 0));
+                } else {
+                    m_undoMemoryLabel->setText(tr("Undo history: %1 MB").arg(usage, 0, 'f', 1));
+                }
+            }
         }
 
         void MapFrame::addRecentDocumentsMenu() {
@@ -411,6 +430,9 @@ namespace TrenchBroom {
         void MapFrame::createStatusBar() {
             m_statusBarLabel = new QLabel();
             statusBar()->addWidget(m_statusBarLabel);
+
+            m_undoMemoryLabel = new QLabel();
+            statusBar()->addPermanentWidget(m_undoMemoryLabel);
         }
 
         static Model::AttributableNode* commonEntityForBrushList(const std::vector<Model::BrushNode*>& list) {
@@ -740,6 +762,7 @@ namespace TrenchBroom {
 
         void MapFrame::bindEvents() {
             connect(m_autosaveTimer, &QTimer::timeout, this, &MapFrame::triggerAutosave);
+            connect(m_assetLoadTimer, &QTimer::timeout, this, &MapFrame::commitLoadedAssets);
             connect(qApp, &QApplication::focusChanged, this, &MapFrame::focusChange);
             connect(m_gridChoice, QOverload<int>::of(&QComboBox::activated), this, [this](const int index) { setGridSize(index + Grid::MinSize); });
             connect(QApplication::clipboard(), &QClipboard::dataChanged, this, [this]() {
@@ -1787,6 +1810,13 @@ namespace TrenchBroom {
             }
         }
 
+        void MapFrame::commitLoadedAssets() {
+            // the document notifies the views when assets have arrived, so the views need not repaint to poll for them
+            if (m_document->hasPendingLoads()) {
+                m_document->commitLoadedAssets();
+            }
+        }
+
         // DebugPaletteWindow
 
         DebugPaletteWindow::DebugPaletteWindow(QWidget *parent)
@@ -80,6 +80,7 @@ namespace TrenchBroom {
             std::chrono::time_point<std::chrono::system_clock> m_lastInputTime;
             std::unique_ptr<Autosaver> m_autosaver;
             QTimer* m_autosaveTimer;
+            QTimer* m_assetLoadTimer;
 
             QToolBar* m_toolBar;
 
@@ -98,6 +99,7 @@ namespace TrenchBroom {
 
             QComboBox* m_gridChoice;
             QLabel* m_statusBarLabel;
+            QLabel* m_undoMemoryLabel;
 
             QPointer<QDialog> m_compilationDialog;
         private: // shortcuts
@@ -368,6 +370,7 @@ namespace TrenchBroom {
             bool eventFilter(QObject* target, QEvent* event) override;
         private:
             void triggerAutosave();
+            void commitLoadedAssets();
         };
 
         class DebugPaletteWindow : public QDialog {
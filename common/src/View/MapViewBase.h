@@ -131,6 +131,7 @@ namespace TrenchBroom {
             void selectionDidChange(const Selection& selection);
             void textureCollectionsDidChange();
             void entityDefinitionsDidChange();
+            void entityModelsWereLoaded();
             void modsDidChange();
             void editorContextDidChange();
             void mapViewConfigDidChange();
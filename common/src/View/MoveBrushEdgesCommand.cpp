@@ -55,15 +55,9 @@ namespace TrenchBroom {
 
         bool MoveBrushEdgesCommand::doCanDoVertexOperation(const MapDocument* document) const {
             const vm::bbox3& worldBounds = document->worldBounds();
-            for (const auto& entry : m_edges) {
-                const Model::BrushNode* brushNode = entry.first;
-                const std::vector<vm::segment3>& edges = entry.second;
-                const Model::Brush& brush = brushNode->brush();
-                if (!brush.canMoveEdges(worldBounds, edges, m_delta)) {
-                    return false;
-                }
-            }
-            return true;
+            return canApplyToAllBrushes(m_edges, [&](const Model::Brush& brush, const std::vector<vm::segment3>& edges) {
+                return brush.canMoveEdges(worldBounds, edges, m_delta);
+            });
         }
 
         bool MoveBrushEdgesCommand::doVertexOperation(MapDocumentCommandFacade* document) {
@@ -54,15 +54,9 @@ namespace TrenchBroom {
 
         bool MoveBrushFacesCommand::doCanDoVertexOperation(const MapDocument* document) const {
             const vm::bbox3& worldBounds = document->worldBounds();
-            for (const auto& entry : m_faces) {
-                const Model::BrushNode* brushNode = entry.first;
-                const Model::Brush& brush = brushNode->brush();
-                const std::vector<vm::polygon3>& faces = entry.second;
-                if (!brush.canMoveFaces(worldBounds, faces, m_delta)) {
-                    return false;
-                }
-            }
-            return true;
+            return canApplyToAllBrushes(m_faces, [&](const Model::Brush& brush, const std::vector<vm::polygon3>& faces) {
+                return brush.canMoveFaces(worldBounds, faces, m_delta);
+            });
         }
 
         bool MoveBrushFacesCommand::doVertexOperation(MapDocumentCommandFacade* document) {
@@ -61,15 +61,9 @@ namespace TrenchBroom {
 
         bool MoveBrushVerticesCommand::doCanDoVertexOperation(const MapDocument* document) const {
             const vm::bbox3& worldBounds = document->worldBounds();
-            for (const auto& entry : m_vertices) {
-                const Model::BrushNode* brushNode = entry.first;
-                const Model::Brush& brush = brushNode->brush();
-                const std::vector<vm::vec3>& vertices = entry.second;
-                if (!brush.canMoveVertices(worldBounds, vertices, m_delta)) {
-                    return false;
-                }
-            }
-            return true;
+            return canApplyToAllBrushes(m_vertices, [&](const Model::Brush& brush, const std::vector<vm::vec3>& vertices) {
+                return brush.canMoveVertices(worldBounds, vertices, m_delta);
+            });
         }
 
         bool MoveBrushVerticesCommand::doVertexOperation(MapDocumentCommandFacade* document) {
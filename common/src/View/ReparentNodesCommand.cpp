@@ -54,5 +54,10 @@ namespace TrenchBroom {
         bool ReparentNodesCommand::doCollateWith(UndoableCommand*) {
             return false;
         }
+
+        size_t ReparentNodesCommand::doGetMemorySize() const {
+            // the nodes are owned by the document
+            return sizeof(ReparentNodesCommand) + Model::memorySize(m_nodesToAdd) + Model::memorySize(m_nodesToRemove);
+        }
     }
 }
@@ -51,6 +51,8 @@ namespace TrenchBroom {
 
             bool doCollateWith(UndoableCommand* command) override;
 
+            size_t doGetMemorySize() const override;
+
             deleteCopyAndMove(ReparentNodesCommand)
         };
     }
@@ -66,5 +66,15 @@ namespace TrenchBroom {
             const auto& nodes = document->selectedNodes().nodes();
             return std::make_unique<Model::Snapshot>(std::begin(nodes), std::end(nodes));
         }
+
+        size_t SnapshotCommand::doGetMemorySize() const {
+            return m_snapshot != nullptr ? m_snapshot->memorySize() : 0u;
+        }
+
+        void SnapshotCommand::doCompressSnapshots() {
+            if (m_snapshot != nullptr) {
+                m_snapshot->compress();
+            }
+        }
     }
 }
@@ -49,6 +49,9 @@ namespace TrenchBroom {
         private:
             virtual std::unique_ptr<Model::Snapshot> doTakeSnapshot(MapDocumentCommandFacade* document) const;
 
+            size_t doGetMemorySize() const override;
+            void doCompressSnapshots() override;
+
             deleteCopyAndMove(SnapshotCommand)
         };
     }
@@ -31,6 +31,7 @@
 #include "Renderer/Shaders.h"
 #include "Renderer/ShaderManager.h"
 #include "Renderer/TextureFont.h"
+#include "Renderer/TextureThumbnailAtlas.h"
 #include "Renderer/Transformation.h"
 #include "Renderer/VertexArray.h"
 #include "View/MapDocument.h"
@@ -44,7 +45,9 @@
 #include <vecmath/mat.h>
 #include <vecmath/mat_ext.h>
 
+#include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <QTextStream>
@@ -63,16 +66,24 @@ namespace TrenchBroom {
         m_group(false),
         m_hideUnused(false),
         m_sortOrder(TextureSortOrder::Name),
-        m_selectedTexture(nullptr) {
+        m_selectedTexture(nullptr),
+        m_thumbnailAtlasStale(false),
+        m_thumbnailGeneration(0u),
+        m_thumbnailVerticesValid(false) {
             auto doc = kdl::mem_lock(m_document);
             doc->textureManager().usageCountDidChange.addObserver(this, &TextureBrowserView::usageCountDidChange);
+            doc->textureCollectionsDidChangeNotifier.addObserver(this, &TextureBrowserView::textureCollectionsDidChange);
         }
 
         TextureBrowserView::~TextureBrowserView() {
             if (!kdl::mem_expired(m_document)) {
                 auto doc = kdl::mem_lock(m_document);
                 doc->textureManager().usageCountDidChange.removeObserver(this, &TextureBrowserView::usageCountDidChange);
+                doc->textureCollectionsDidChangeNotifier.removeObserver(this, &TextureBrowserView::textureCollectionsDidChange);
             }
+
+            // Deleting the thumbnail atlas and its vertex array accesses OpenGL resources, so we need to be current
+            makeCurrent();
             clear();
         }
 
@@ -136,6 +147,13 @@ namespace TrenchBroom {
             update();
         }
 
+        void TextureBrowserView::textureCollectionsDidChange() {
+            // the textures will be deleted, and their addresses may be reused by new textures
+            m_thumbnailAtlasStale = true;
+            invalidate();
+            update();
+        }
+
         void TextureBrowserView::doInitLayout(Layout& layout) {
             const float scaleFactor = pref(Preferences::TextureBrowserIconSize);
 
@@ -149,6 +167,8 @@ namespace TrenchBroom {
         }
 
         void TextureBrowserView::doReloadLayout(Layout& layout) {
+            m_thumbnailVerticesValid = false;
+
             const IO::Path& fontPath = pref(Preferences::RendererFontPath());
             int fontSize = pref(Preferences::BrowserFontSize);
             assert(fontSize > 0);
@@ -288,7 +308,13 @@ namespace TrenchBroom {
             }
         }
 
-        void TextureBrowserView::doClear() {}
+        void TextureBrowserView::doClear() {
+            m_thumbnailVertexArray = Renderer::VertexArray();
+            m_thumbnailBatches.clear();
+            m_thumbnailRows.clear();
+            m_thumbnailVerticesValid = false;
+            m_thumbnailAtlas.reset();
+        }
 
         void TextureBrowserView::doRender(Layout& layout, const float y, const float height) {
             auto doc = kdl::mem_lock(m_document);
@@ -301,14 +327,18 @@ namespace TrenchBroom {
 
             const vm::mat4x4f projection = vm::ortho_matrix(-1.0f, 1.0f, viewLeft, viewTop, viewRight, viewBottom);
             const vm::mat4x4f view = vm::view_matrix(vm::vec3f::neg_z(), vm::vec3f::pos_y()) *vm::translation_matrix(vm::vec3f(0.0f, 0.0f, 0.1f));
-            const Renderer::Transformation transformation(projection, view);
+            Renderer::Transformation transformation(projection, view);
 
             glAssert(glDisable(GL_DEPTH_TEST));
             glAssert(glFrontFace(GL_CCW));
 
             renderBounds(layout, y, height);
-            renderTextures(layout, y, height);
+            renderTextures(layout, y, height, transformation);
             renderNames(layout, y, height);
+
+            if (doc->textureManager().hasPendingChanges()) {
+                update();
+            }
         }
 
         bool TextureBrowserView::doShouldRenderFocusIndicator() const {
@@ -355,48 +385,128 @@ namespace TrenchBroom {
             return pref(Preferences::TextureBrowserDefaultColor);
         }
 
-        void TextureBrowserView::renderTextures(Layout& layout, const float y, const float height) {
-            using TextureVertex = Renderer::GLVertexTypes::P2T2::Vertex;
+        void TextureBrowserView::renderTextures(Layout& layout, const float y, const float height, Renderer::Transformation& transformation) {
+            validateThumbnailAtlas();
+            validateThumbnailVertices(layout, y, height);
 
             Renderer::ActiveShader shader(shaderManager(), Renderer::Shaders::TextureBrowserShader);
             shader.set("ApplyTinting", false);
             shader.set("Texture", 0);
             shader.set("Brightness", pref(Preferences::Brightness));
 
-            size_t num = 0;
+            // the thumbnail vertices are in layout coordinates, so we only need to move them into the visible rect
+            const Renderer::MultiplyModelMatrix translation(transformation, vm::translation_matrix(vm::vec3f(0.0f, height + y, 0.0f)));
+
+            if (m_thumbnailVertexArray.setup()) {
+                for (const auto& batch : m_thumbnailBatches) {
+                    shader.set("GrayScale", batch.grayScale);
+                    m_thumbnailAtlas->activatePage(batch.page);
+                    m_thumbnailVertexArray.render(Renderer::PrimType::Quads, batch.index, batch.count);
+                }
+                m_thumbnailAtlas->deactivate();
+                m_thumbnailVertexArray.cleanup();
+            }
+        }
+
+        void TextureBrowserView::validateThumbnailAtlas() {
+            static const size_t MinThumbnailSize = 32u;
+            static const size_t MaxThumbnailSize = 256u;
+            static const size_t AtlasPageSize = 2048u;
+            static const size_t MaxAtlasPageCount = 4u;
+            static const size_t MaxThumbnailsPerFrame = 64u;
+
+            // thumbnails are at least as large as the largest cell at the current icon size
+            const float scaleFactor = pref(Preferences::TextureBrowserIconSize);
+            const float maxCellSize = scaleFactor * 128.0f;
+            size_t thumbnailSize = MinThumbnailSize;
+            while (thumbnailSize < MaxThumbnailSize && static_cast<float>(thumbnailSize) < maxCellSize) {
+                thumbnailSize *= 2u;
+            }
+
+            if (m_thumbnailAtlas == nullptr || m_thumbnailAtlasStale || m_thumbnailAtlas->thumbnailSize() != thumbnailSize) {
+                m_thumbnailAtlas = std::make_unique<Renderer::TextureThumbnailAtlas>(thumbnailSize, AtlasPageSize, MaxAtlasPageCount, MaxThumbnailsPerFrame);
+                m_thumbnailAtlasStale = false;
+                m_thumbnailVerticesValid = false;
+            }
+        }
+
+        void TextureBrowserView::validateThumbnailVertices(Layout& layout, const float y, const float height) {
+            using TextureVertex = Renderer::GLVertexTypes::P2T2::Vertex;
 
+            std::vector<const Row*> visibleRows;
             for (size_t i = 0; i < layout.size(); ++i) {
                 const Group& group = layout[i];
                 if (group.intersectsY(y, height)) {
                     for (size_t j = 0; j < group.size(); ++j) {
                         const Row& row = group[j];
                         if (row.intersectsY(y, height)) {
-                            for (size_t k = 0; k < row.size(); ++k) {
-                                const Cell& cell = row[k];
-                                const LayoutBounds& bounds = cell.itemBounds();
-                                const Assets::Texture* texture = cellData(cell).texture;
-
-                                Renderer::VertexArray vertexArray = Renderer::VertexArray::move(std::vector<TextureVertex>({
-                                    TextureVertex(vm::vec2f(bounds.left(),  height - (bounds.top() - y)),    vm::vec2f(0.0f, 0.0f)),
-                                    TextureVertex(vm::vec2f(bounds.left(),  height - (bounds.bottom() - y)), vm::vec2f(0.0f, 1.0f)),
-                                    TextureVertex(vm::vec2f(bounds.right(), height - (bounds.bottom() - y)), vm::vec2f(1.0f, 1.0f)),
-                                    TextureVertex(vm::vec2f(bounds.right(), height - (bounds.top() - y)),    vm::vec2f(1.0f, 0.0f))
-                                }));
+                            visibleRows.push_back(&row);
+                        }
+                    }
+                }
+            }
 
-                                shader.set("GrayScale", texture->overridden());
-                                texture->activate();
+            m_thumbnailAtlas->beginFrame();
+            if (m_thumbnailVerticesValid &&
+                visibleRows == m_thumbnailRows &&
+                m_thumbnailAtlas->generation() == m_thumbnailGeneration) {
+                return;
+            }
 
-                                vertexArray.prepare(vboManager());
-                                vertexArray.render(Renderer::PrimType::Quads);
+            // group the quads by atlas page and grayscale mode so that each group can be rendered with one draw call
+            std::map<std::pair<size_t, bool>, std::vector<TextureVertex>> batchVertices;
+            bool complete = true;
+
+            for (const Row* row : visibleRows) {
+                for (size_t k = 0; k < row->size(); ++k) {
+                    const Cell& cell = (*row)[k];
+                    const LayoutBounds& bounds = cell.itemBounds();
+                    const Assets::Texture* texture = cellData(cell).texture;
+
+                    const auto* thumbnail = m_thumbnailAtlas->thumbnail(texture);
+                    if (thumbnail == nullptr) {
+                        // the texture isn't uploaded yet, the atlas is full, or the thumbnail was deferred to the next frame
+                        complete = false;
+                        continue;
+                    }
 
-                                texture->deactivate();
+                    const auto& tMin = thumbnail->texCoordsMin;
+                    const auto& tMax = thumbnail->texCoordsMax;
 
-                                ++num;
-                            }
-                        }
-                    }
+                    auto& vertices = batchVertices[std::make_pair(thumbnail->page, texture->overridden())];
+                    vertices.emplace_back(vm::vec2f(bounds.left(),  -bounds.top()),    vm::vec2f(tMin.x(), tMin.y()));
+                    vertices.emplace_back(vm::vec2f(bounds.left(),  -bounds.bottom()), vm::vec2f(tMin.x(), tMax.y()));
+                    vertices.emplace_back(vm::vec2f(bounds.right(), -bounds.bottom()), vm::vec2f(tMax.x(), tMax.y()));
+                    vertices.emplace_back(vm::vec2f(bounds.right(), -bounds.top()),    vm::vec2f(tMax.x(), tMin.y()));
                 }
             }
+
+            std::vector<TextureVertex> vertices;
+            m_thumbnailBatches.clear();
+            for (const auto& entry : batchVertices) {
+                const auto& key = entry.first;
+                const auto& batch = entry.second;
+
+                m_thumbnailBatches.push_back(ThumbnailBatch{
+                    key.first,
+                    key.second,
+                    static_cast<GLint>(vertices.size()),
+                    static_cast<GLsizei>(batch.size())
+                });
+                kdl::vec_append(vertices, batch);
+            }
+
+            m_thumbnailVertexArray = Renderer::VertexArray::move(std::move(vertices));
+            m_thumbnailVertexArray.prepare(vboManager());
+
+            m_thumbnailRows = std::move(visibleRows);
+            m_thumbnailGeneration = m_thumbnailAtlas->generation();
+            m_thumbnailVerticesValid = complete;
+
+            if (m_thumbnailAtlas->thumbnailsDeferred()) {
+                // create the remaining thumbnails in the next frame
+                update();
+            }
         }
 
         void TextureBrowserView::renderNames(Layout& layout, const float y, const float height) {
@@ -21,7 +21,9 @@
 #define TrenchBroom_TextureBrowserView
 
 #include "Renderer/FontDescriptor.h"
+#include "Renderer/GL.h"
 #include "Renderer/GLVertexType.h"
+#include "Renderer/VertexArray.h"
 #include "View/CellView.h"
 
 #include <map>
@@ -37,6 +39,11 @@ namespace TrenchBroom {
         class TextureCollection;
     }
 
+    namespace Renderer {
+        class TextureThumbnailAtlas;
+        class Transformation;
+    }
+
     namespace View {
         class GLContextManager;
         class MapDocument;
@@ -70,6 +77,30 @@ namespace TrenchBroom {
             std::string m_filterText;
 
             Assets::Texture* m_selectedTexture;
+
+            struct ThumbnailBatch {
+                size_t page;
+                bool grayScale;
+                GLint index;
+                GLsizei count;
+            };
+
+            /**
+             * Holds downscaled copies of the textures in the visible rows so that they can be rendered with one
+             * texture bind per atlas page instead of one per texture.
+             */
+            std::unique_ptr<Renderer::TextureThumbnailAtlas> m_thumbnailAtlas;
+            bool m_thumbnailAtlasStale;
+
+            /**
+             * The thumbnail quads of the visible rows in layout coordinates, grouped by atlas page. They are only
+             * rebuilt when the layout, the visible rows or the contents of the atlas change.
+             */
+            Renderer::VertexArray m_thumbnailVertexArray;
+            std::vector<ThumbnailBatch> m_thumbnailBatches;
+            std::vector<const Row*> m_thumbnailRows;
+            size_t m_thumbnailGeneration;
+            bool m_thumbnailVerticesValid;
         public:
             TextureBrowserView(QScrollBar* scrollBar,
                                GLContextManager& contextManager,
@@ -87,6 +118,7 @@ namespace TrenchBroom {
             void revealTexture(Assets::Texture* texture);
         private:
             void usageCountDidChange();
+            void textureCollectionsDidChange();
 
             void doInitLayout(Layout& layout) override;
             void doReloadLayout(Layout& layout) override;
@@ -110,7 +142,9 @@ namespace TrenchBroom {
 
             void renderBounds(Layout& layout, float y, float height);
             const Color& textureColor(const Assets::Texture& texture) const;
-            void renderTextures(Layout& layout, float y, float height);
+            void renderTextures(Layout& layout, float y, float height, Renderer::Transformation& transformation);
+            void validateThumbnailAtlas();
+            void validateThumbnailVertices(Layout& layout, float y, float height);
             void renderNames(Layout& layout, float y, float height);
             void renderGroupTitleBackgrounds(Layout& layout, float y, float height);
             void renderStrings(Layout& layout, float y, float height);
@@ -180,6 +180,10 @@ namespace TrenchBroom {
                 renderTextureAxes(renderContext, renderBatch);
 
                 renderBatch.render(renderContext);
+
+                if (document->hasPendingUploads()) {
+                    update();
+                }
             }
         }
 
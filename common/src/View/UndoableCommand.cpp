@@ -60,6 +60,14 @@ namespace TrenchBroom {
             return doCollateWith(command);
         }
 
+        size_t UndoableCommand::memorySize() const {
+            return doGetMemorySize();
+        }
+
+        void UndoableCommand::compressSnapshots() {
+            doCompressSnapshots();
+        }
+
         bool UndoableCommand::doIsRepeatDelimiter() const {
             return false;
         }
@@ -68,6 +76,12 @@ namespace TrenchBroom {
             throw CommandProcessorException("Command is not repeatable");
         }
 
+        size_t UndoableCommand::doGetMemorySize() const {
+            return 0u;
+        }
+
+        void UndoableCommand::doCompressSnapshots() {}
+
         size_t UndoableCommand::documentModificationCount() const {
             throw CommandProcessorException("Command does not modify the document");
         }
@@ -43,6 +43,17 @@ namespace TrenchBroom {
             std::unique_ptr<UndoableCommand> repeat(MapDocumentCommandFacade* document) const;
 
             virtual bool collateWith(UndoableCommand* command);
+
+            /**
+             * Returns an estimate of the number of bytes of memory held by this command in order to undo it.
+             */
+            size_t memorySize() const;
+
+            /**
+             * Compresses the snapshots held by this command in order to reduce its memory size. The command can still
+             * be undone afterwards, but doing so takes longer.
+             */
+            void compressSnapshots();
         private:
             virtual std::unique_ptr<CommandResult> doPerformUndo(MapDocumentCommandFacade* document) = 0;
 
@@ -51,6 +62,9 @@ namespace TrenchBroom {
             virtual std::unique_ptr<UndoableCommand> doRepeat(MapDocumentCommandFacade* document) const;
 
             virtual bool doCollateWith(UndoableCommand* command) = 0;
+
+            virtual size_t doGetMemorySize() const;
+            virtual void doCompressSnapshots();
         public: // this method is just a service for DocumentCommand and should never be called from anywhere else
             virtual size_t documentModificationCount() const;
 
@@ -54,6 +54,12 @@ namespace TrenchBroom {
             extract(faces, brushes, brushFaces, facePositions);
         }
 
+        size_t VertexCommand::parallelThreadCount(const size_t brushCount) {
+            // spawning worker threads isn't worth it when only a few brushes are affected
+            static const size_t MinBrushCountForParallelOperation = 16u;
+            return brushCount < MinBrushCountForParallelOperation ? 1u : kdl::parallel_thread_count();
+        }
+
         VertexCommand::BrushVerticesMap VertexCommand::brushVertexMap(const BrushEdgesMap& edges) {
             BrushVerticesMap result;
             for (const auto& entry : edges) {
@@ -115,6 +121,16 @@ namespace TrenchBroom {
             return false;
         }
 
+        size_t VertexCommand::doGetMemorySize() const {
+            return m_snapshot != nullptr ? m_snapshot->memorySize() : 0u;
+        }
+
+        void VertexCommand::doCompressSnapshots() {
+            if (m_snapshot != nullptr) {
+                m_snapshot->compress();
+            }
+        }
+
         void VertexCommand::takeSnapshot() {
             assert(m_snapshot == nullptr);
             m_snapshot = std::make_unique<Model::Snapshot>(std::begin(m_brushes), std::end(m_brushes));
@@ -22,12 +22,18 @@
 
 #include "FloatType.h"
 #include "Macros.h"
+#include "Assets/TextureCollection.h"
+#include "Model/Brush.h"
 #include "Model/BrushGeometry.h"
+#include "Model/BrushNode.h"
 #include "View/DocumentCommand.h"
 
+#include <kdl/parallel.h>
+
 #include <vecmath/forward.h>
 #include <vecmath/vec.h>
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <set>
@@ -84,11 +90,68 @@ namespace TrenchBroom {
 
             static BrushVerticesMap brushVertexMap(const BrushEdgesMap& edges);
             static BrushVerticesMap brushVertexMap(const BrushFacesMap& faces);
+
+            /**
+             * Checks whether the given predicate holds for every brush and its handles in the given map. Large
+             * numbers of brushes are checked in parallel, see parallelForEachBrush.
+             *
+             * @tparam H the handle type
+             * @tparam P the predicate type, must be of type `bool(const Model::Brush&, const std::vector<H>&)`
+             * @param brushToHandles the brushes to check, mapped to their handles
+             * @param predicate the predicate to check
+             * @return true if the predicate holds for every brush and false otherwise
+             */
+            template <typename H, typename P>
+            static bool canApplyToAllBrushes(const std::map<Model::BrushNode*, std::vector<H>>& brushToHandles, const P& predicate) {
+                std::atomic<bool> result(true);
+                parallelForEachBrush(brushToHandles, [&](const size_t /* index */, const Model::Brush& brush, const std::vector<H>& handles) {
+                    // once one brush fails, the others need not be checked
+                    if (result && !predicate(brush, handles)) {
+                        result = false;
+                    }
+                });
+                return result;
+            }
+        public:
+            /**
+             * Calls the given lambda for every brush and its handles in the given map, passing the index of the
+             * entry in the map along. Large numbers of brushes are processed in parallel, so the given lambda must
+             * be safe to call concurrently for different brushes.
+             *
+             * Copying brush faces changes the usage counts of their textures, so the usage count notifications of
+             * the texture collections are suppressed while the lambda runs. Any brushes created by the lambda must be
+             * committed on the calling thread afterwards.
+             *
+             * @tparam H the handle type
+             * @tparam L the lambda type, must be of type `void(size_t, const Model::Brush&, const std::vector<H>&)`
+             * @param brushToHandles the brushes to process, mapped to their handles
+             * @param lambda the lambda to call
+             */
+            template <typename H, typename L>
+            static void parallelForEachBrush(const std::map<Model::BrushNode*, std::vector<H>>& brushToHandles, const L& lambda) {
+                std::vector<const std::pair<Model::BrushNode* const, std::vector<H>>*> entries;
+                entries.reserve(brushToHandles.size());
+                for (const auto& entry : brushToHandles) {
+                    entries.push_back(&entry);
+                }
+
+                kdl::parallel_for(entries.size(), [&](const size_t i) {
+                    Assets::TextureCollection::SuppressUsageCountNotifications suppressNotifications;
+                    lambda(i, entries[i]->first->brush(), entries[i]->second);
+                }, parallelThreadCount(entries.size()));
+            }
+        private:
+            /**
+             * Returns the number of threads to use to apply a vertex operation to the given number of brushes.
+             */
+            static size_t parallelThreadCount(size_t brushCount);
         private:
             std::unique_ptr<CommandResult> doPerformDo(MapDocumentCommandFacade* document) override;
             std::unique_ptr<CommandResult> doPerformUndo(MapDocumentCommandFacade* document) override;
             void restoreAndTakeNewSnapshot(MapDocumentCommandFacade* document);
             bool doIsRepeatable(MapDocumentCommandFacade* document) const override;
+            size_t doGetMemorySize() const override;
+            void doCompressSnapshots() override;
         private:
             void takeSnapshot();
             void deleteSnapshot();
@@ -38,28 +38,28 @@ namespace TrenchBroom {
         const Model::HitType::Type VertexHandleManager::HandleHitType = Model::HitType::freeType();
 
         void VertexHandleManager::pick(const vm::ray3& pickRay, const Renderer::Camera& camera, Model::PickResult& pickResult) const {
-            for (const auto& entry : m_handles) {
-                const auto& position = entry.first;
-                const auto distance = camera.pickPointHandle(pickRay, position, static_cast<FloatType>(pref(Preferences::HandleRadius)));
+            const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+            forEachPickCandidate(pickRay, camera, handleRadius, [&](const vm::vec3& position) {
+                const auto distance = camera.pickPointHandle(pickRay, position, handleRadius);
                 if (!vm::is_nan(distance)) {
                     const auto hitPoint = vm::point_at_distance(pickRay, distance);
                     const auto error = vm::squared_distance(pickRay, position).distance;
                     pickResult.addHit(Model::Hit::hit(HandleHitType, distance, hitPoint, position, error));
                 }
-            }
+            });
         }
 
         void VertexHandleManager::addHandles(const Model::BrushNode* brushNode) {
             const Model::Brush& brush = brushNode->brush();
             for (const Model::BrushVertex* vertex : brush.vertices()) {
-                add(vertex->position());
+                add(vertex->position(), brushNode);
             }
         }
 
         void VertexHandleManager::removeHandles(const Model::BrushNode* brushNode) {
             const Model::Brush& brush = brushNode->brush();
             for (const Model::BrushVertex* vertex : brush.vertices()) {
-                assertResult(remove(vertex->position()))
+                assertResult(remove(vertex->position(), brushNode))
             }
         }
 
@@ -72,47 +72,51 @@ namespace TrenchBroom {
             return brush.hasVertex(handle);
         }
 
+        vm::bbox3 VertexHandleManager::handleBounds(const Handle& handle) const {
+            return vm::bbox3(handle, handle);
+        }
+
         const Model::HitType::Type EdgeHandleManager::HandleHitType = Model::HitType::freeType();
 
         void EdgeHandleManager::pickGridHandle(const vm::ray3& pickRay, const Renderer::Camera& camera, const Grid& grid, Model::PickResult& pickResult) const {
-            for (const HandleEntry& entry : m_handles) {
-                const vm::segment3& position = entry.first;
-                const FloatType edgeDist = camera.pickLineSegmentHandle(pickRay, position, static_cast<FloatType>(pref(Preferences::HandleRadius)));
+            const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+            forEachPickCandidate(pickRay, camera, handleRadius, [&](const vm::segment3& position) {
+                const FloatType edgeDist = camera.pickLineSegmentHandle(pickRay, position, handleRadius);
                 if (!vm::is_nan(edgeDist)) {
                     const vm::vec3 pointHandle = grid.snap(vm::point_at_distance(pickRay, edgeDist), position);
-                    const FloatType pointDist = camera.pickPointHandle(pickRay, pointHandle, static_cast<FloatType>(pref(Preferences::HandleRadius)));
+                    const FloatType pointDist = camera.pickPointHandle(pickRay, pointHandle, handleRadius);
                     if (!vm::is_nan(pointDist)) {
                         const vm::vec3 hitPoint = vm::point_at_distance(pickRay, pointDist);
                         pickResult.addHit(Model::Hit::hit(HandleHitType, pointDist, hitPoint, HitType(position, pointHandle)));
                     }
                 }
-            }
+            });
         }
 
         void EdgeHandleManager::pickCenterHandle(const vm::ray3& pickRay, const Renderer::Camera& camera, Model::PickResult& pickResult) const {
-            for (const HandleEntry& entry : m_handles) {
-                const vm::segment3& position = entry.first;
+            const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+            forEachPickCandidate(pickRay, camera, handleRadius, [&](const vm::segment3& position) {
                 const vm::vec3 pointHandle = position.center();
 
-                const FloatType pointDist = camera.pickPointHandle(pickRay, pointHandle, static_cast<FloatType>(pref(Preferences::HandleRadius)));
+                const FloatType pointDist = camera.pickPointHandle(pickRay, pointHandle, handleRadius);
                 if (!vm::is_nan(pointDist)) {
                     const vm::vec3 hitPoint = vm::point_at_distance(pickRay, pointDist);
                     pickResult.addHit(Model::Hit::hit(HandleHitType, pointDist, hitPoint, position));
                 }
-            }
+            });
         }
 
         void EdgeHandleManager::addHandles(const Model::BrushNode* brushNode) {
             const Model::Brush& brush = brushNode->brush();
             for (const Model::BrushEdge* edge : brush.edges()) {
-                add(vm::segment3(edge->firstVertex()->position(), edge->secondVertex()->position()));
+                add(vm::segment3(edge->firstVertex()->position(), edge->secondVertex()->position()), brushNode);
             }
         }
 
         void EdgeHandleManager::removeHandles(const Model::BrushNode* brushNode) {
             const Model::Brush& brush = brushNode->brush();
             for (const Model::BrushEdge* edge : brush.edges()) {
-                assertResult(remove(vm::segment3(edge->firstVertex()->position(), edge->secondVertex()->position())))
+                assertResult(remove(vm::segment3(edge->firstVertex()->position(), edge->secondVertex()->position()), brushNode))
             }
         }
 
@@ -125,54 +129,60 @@ namespace TrenchBroom {
             return brush.hasEdge(handle);
         }
 
+        vm::bbox3 EdgeHandleManager::handleBounds(const Handle& handle) const {
+            vm::bbox3::builder bounds;
+            bounds.add(handle.start());
+            bounds.add(handle.end());
+            return bounds.bounds();
+        }
+
         const Model::HitType::Type FaceHandleManager::HandleHitType = Model::HitType::freeType();
 
         void FaceHandleManager::pickGridHandle(const vm::ray3& pickRay, const Renderer::Camera& camera, const Grid& grid, Model::PickResult& pickResult) const {
-            for (const auto& entry : m_handles) {
-                const auto& position = entry.first;
-
+            const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+            forEachPickCandidate(pickRay, camera, handleRadius, [&](const vm::polygon3& position) {
                 const auto [valid, plane] = vm::from_points(std::begin(position), std::end(position));
                 if (!valid) {
-                    continue;
+                    return;
                 }
 
                 const auto distance = vm::intersect_ray_polygon(pickRay, plane, std::begin(position), std::end(position));
                 if (!vm::is_nan(distance)) {
                     const auto pointHandle = grid.snap(vm::point_at_distance(pickRay, distance), plane);
 
-                    const auto pointDist = camera.pickPointHandle(pickRay, pointHandle, static_cast<FloatType>(pref(Preferences::HandleRadius)));
+                    const auto pointDist = camera.pickPointHandle(pickRay, pointHandle, handleRadius);
                     if (!vm::is_nan(pointDist)) {
                         const auto hitPoint = vm::point_at_distance(pickRay, pointDist);
                         pickResult.addHit(Model::Hit::hit(HandleHitType, pointDist, hitPoint, HitType(position, pointHandle)));
                     }
                 }
-            }
+            });
         }
 
         void FaceHandleManager::pickCenterHandle(const vm::ray3& pickRay, const Renderer::Camera& camera, Model::PickResult& pickResult) const {
-            for (const HandleEntry& entry : m_handles) {
-                const auto& position = entry.first;
+            const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+            forEachPickCandidate(pickRay, camera, handleRadius, [&](const vm::polygon3& position) {
                 const auto pointHandle = position.center();
 
-                const auto pointDist = camera.pickPointHandle(pickRay, pointHandle, static_cast<FloatType>(pref(Preferences::HandleRadius)));
+                const auto pointDist = camera.pickPointHandle(pickRay, pointHandle, handleRadius);
                 if (!vm::is_nan(pointDist)) {
                     const auto hitPoint = vm::point_at_distance(pickRay, pointDist);
                     pickResult.addHit(Model::Hit::hit(HandleHitType, pointDist, hitPoint, position));
                 }
-            }
+            });
         }
 
         void FaceHandleManager::addHandles(const Model::BrushNode* brushNode) {
             const Model::Brush& brush = brushNode->brush();
             for (const Model::BrushFace& face : brush.faces()) {
-                add(face.polygon());
+                add(face.polygon(), brushNode);
             }
         }
 
         void FaceHandleManager::removeHandles(const Model::BrushNode* brushNode) {
             const Model::Brush& brush = brushNode->brush();
             for (const Model::BrushFace& face : brush.faces()) {
-                assertResult(remove(face.polygon()))
+                assertResult(remove(face.polygon(), brushNode))
             }
         }
 
@@ -184,5 +194,13 @@ namespace TrenchBroom {
             const Model::Brush& brush = brushNode->brush();
             return brush.hasFace(handle);
         }
+
+        vm::bbox3 FaceHandleManager::handleBounds(const Handle& handle) const {
+            vm::bbox3::builder bounds;
+            for (const auto& vertex : handle) {
+                bounds.add(vertex);
+            }
+            return bounds.bounds();
+        }
     }
 }
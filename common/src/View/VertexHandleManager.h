@@ -20,6 +20,7 @@
 #ifndef VertexHandleManager_h
 #define VertexHandleManager_h
 
+#include "AABBTree.h"
 #include "FloatType.h"
 #include "Model/BrushNode.h"
 #include "Model/BrushFace.h"
@@ -29,10 +30,15 @@
 
 #include <kdl/vector_set.h>
 
+#include <vecmath/bbox.h>
+#include <vecmath/intersection.h>
 #include <vecmath/segment.h>
 
+#include <algorithm>
+#include <atomic>
 #include <iterator>
 #include <map>
+#include <mutex>
 #include <vector>
 
 namespace TrenchBroom {
@@ -107,6 +113,11 @@ namespace TrenchBroom {
                 size_t count;
                 bool selected;
 
+                /**
+                 * The brushes that contributed this handle, one entry per duplicate.
+                 */
+                std::vector<const Model::BrushNode*> brushes;
+
                 HandleInfo() :
                 count(0),
                 selected(false) {}
@@ -160,18 +171,30 @@ namespace TrenchBroom {
 
             using HandleMap = std::map<H, HandleInfo>;
             using HandleEntry = typename HandleMap::value_type;
+            using HandleTree = AABBTree<FloatType, 3, HandleEntry*>;
 
             /**
              * Maps a handle position to its info.
              */
             HandleMap m_handles;
 
+            /**
+             * A spatial index of the entries of m_handles, keyed by the bounds of the handles. The entries of a
+             * std::map are stable, so the tree can refer to them directly. The tree is built on the first query after
+             * it was cleared and updated incrementally afterwards. Queries may run concurrently, so the build is
+             * guarded by a mutex.
+             */
+            mutable std::mutex m_handleTreeMutex;
+            mutable HandleTree m_handleTree;
+            mutable std::atomic<bool> m_handleTreeValid;
+
             /**
              * The total number of selected handles, not counting duplicates.
              */
             size_t m_selectedHandleCount;
         public:
             VertexHandleManagerBaseT() :
+            m_handleTreeValid(false),
             m_selectedHandleCount(0) {}
 
             virtual ~VertexHandleManagerBaseT() {}
@@ -298,28 +321,47 @@ namespace TrenchBroom {
             }
         public:
             /**
-             * Adds the given handle to this manager.
+             * Adds the given handle of the given brush to this manager.
              *
              * @param handle the handle to add
+             * @param brushNode the brush to which the handle belongs
              */
-            void add(const Handle& handle) {
-                m_handles[handle].inc(); // unknown value gets value constructed, which for HandleInfo means its default constructor is called
+            void add(const Handle& handle, const Model::BrushNode* brushNode) {
+                // unknown value gets value constructed, which for HandleInfo means its default constructor is called
+                const auto [it, inserted] = m_handles.try_emplace(handle);
+
+                HandleInfo& info = it->second;
+                info.inc();
+                info.brushes.push_back(brushNode);
+
+                if (inserted && m_handleTreeValid) {
+                    m_handleTree.insert(handleBounds(it->first), &*it);
+                }
             }
 
             /**
-             * Removes the given handle from this manager.
+             * Removes the given handle of the given brush from this manager.
              *
              * @param handle the handle to remove
+             * @param brushNode the brush to which the handle belongs
              * @return true if the given handle was contained in this manager (and therefore removed) and false otherwise
              */
-            bool remove(const Handle& handle) {
+            bool remove(const Handle& handle, const Model::BrushNode* brushNode) {
                 const auto it = m_handles.find(handle);
                 if (it != std::end(m_handles)) {
                     HandleInfo& info = it->second;
                     info.dec();
 
+                    const auto brushIt = std::find(std::begin(info.brushes), std::end(info.brushes), brushNode);
+                    if (brushIt != std::end(info.brushes)) {
+                        info.brushes.erase(brushIt);
+                    }
+
                     if (info.count == 0) {
                         deselect(info);
+                        if (m_handleTreeValid) {
+                            m_handleTree.remove(&*it);
+                        }
                         m_handles.erase(it);
                     }
                     return true;
@@ -332,6 +374,8 @@ namespace TrenchBroom {
              * Removes all handles from this manager.
              */
             void clear() {
+                m_handleTree.clear();
+                m_handleTreeValid = false;
                 m_handles.clear();
                 m_selectedHandleCount = 0;
             }
@@ -423,11 +467,42 @@ namespace TrenchBroom {
             template <typename F>
             void forEachCloseHandle(const H& handle, F fun) {
                 static const auto epsilon = 0.001 * 0.001;
-                for (auto& entry : m_handles) {
-                    if (compare(handle, entry.first, epsilon) == 0) {
-                        fun(entry.second);
+                const auto bounds = handleBounds(handle).expand(epsilon);
+
+                std::vector<HandleEntry*> candidates;
+                handleTree().findMatching([&](const vm::bbox3& nodeBounds) {
+                    return nodeBounds.intersects(bounds);
+                }, std::back_inserter(candidates));
+
+                for (auto* entry : candidates) {
+                    if (compare(handle, entry->first, epsilon) == 0) {
+                        fun(entry->second);
+                    }
+                }
+            }
+
+            /**
+             * Returns the spatial index of the handles, and builds it if necessary.
+             */
+            const HandleTree& handleTree() const {
+                if (m_handleTreeValid.load(std::memory_order_acquire)) {
+                    return m_handleTree;
+                }
+
+                std::lock_guard<std::mutex> lock(m_handleTreeMutex);
+                if (!m_handleTreeValid.load(std::memory_order_relaxed)) {
+                    std::vector<HandleEntry*> entries;
+                    entries.reserve(m_handles.size());
+                    for (auto& entry : const_cast<HandleMap&>(m_handles)) {
+                        entries.push_back(&entry);
                     }
+
+                    m_handleTree.clearAndBuild(entries, [&](const HandleEntry* entry) {
+                        return handleBounds(entry->first);
+                    });
+                    m_handleTreeValid.store(true, std::memory_order_release);
                 }
+                return m_handleTree;
             }
 
             void select(HandleInfo& info) {
@@ -471,6 +546,48 @@ namespace TrenchBroom {
                     }
                 }
             }
+        protected:
+            /**
+             * Calls the given function for every handle that could be hit by the given picking ray, i.e., for every
+             * handle whose bounds are closer to the given ray than the picking radius of a handle at that position.
+             * Handles that are not passed to the given function cannot be hit.
+             *
+             * @tparam F the type of the function, must be of type `void(const Handle&)`
+             * @param pickRay the picking ray
+             * @param camera the camera, which determines the picking radius
+             * @param handleRadius the handle radius
+             * @param fun the function to call
+             */
+            template <typename F>
+            void forEachPickCandidate(const vm::ray3& pickRay, const Renderer::Camera& camera, const FloatType handleRadius, F fun) const {
+                std::vector<HandleEntry*> candidates;
+                handleTree().findMatching([&](const vm::bbox3& bounds) {
+                    return mayHit(pickRay, camera, handleRadius, bounds);
+                }, std::back_inserter(candidates));
+
+                for (const auto* entry : candidates) {
+                    fun(entry->first);
+                }
+            }
+        private:
+            /**
+             * Indicates whether the given picking ray can hit a handle within the given bounds. The picking radius of a
+             * handle scales linearly with its distance from the camera, so the largest picking radius of any point in
+             * the given bounds is attained at one of its corners.
+             */
+            static bool mayHit(const vm::ray3& pickRay, const Renderer::Camera& camera, const FloatType handleRadius, const vm::bbox3& bounds) {
+                auto scaling = static_cast<FloatType>(0.0);
+                for (size_t i = 0; i < 8; ++i) {
+                    const auto corner = vm::vec3(
+                        (i & 1u) ? bounds.max.x() : bounds.min.x(),
+                        (i & 2u) ? bounds.max.y() : bounds.min.y(),
+                        (i & 4u) ? bounds.max.z() : bounds.min.z());
+                    scaling = vm::max(scaling, vm::abs(static_cast<FloatType>(camera.perspectiveScalingFactor(vm::vec3f(corner)))));
+                }
+
+                const auto expanded = bounds.expand(static_cast<FloatType>(2.0) * handleRadius * scaling);
+                return expanded.contains(pickRay.origin) || !vm::is_nan(vm::intersect_ray_bbox(pickRay, expanded));
+            }
         public:
             /**
              * Finds and returns all brushes in the given range which are incident to the given handle.
@@ -501,10 +618,23 @@ namespace TrenchBroom {
              */
             template <typename I1, typename I2>
             std::vector<Model::BrushNode*> findIncidentBrushes(I1 hBegin, I1 hEnd, I2 bBegin, I2 bEnd) const {
+                auto brushes = std::vector<Model::BrushNode*>(bBegin, bEnd);
+                std::sort(std::begin(brushes), std::end(brushes));
+
                 kdl::vector_set<Model::BrushNode*> result;
                 auto out = std::inserter(result, std::end(result));
                 for (auto hCur = hBegin; hCur != hEnd; ++hCur) {
-                    findIncidentBrushes(*hCur, bBegin, bEnd, out);
+                    const auto it = m_handles.find(*hCur);
+                    if (it != std::end(m_handles)) {
+                        for (const auto* brushNode : it->second.brushes) {
+                            const auto bIt = std::lower_bound(std::begin(brushes), std::end(brushes), brushNode);
+                            if (bIt != std::end(brushes) && *bIt == brushNode) {
+                                out++ = *bIt;
+                            }
+                        }
+                    } else {
+                        findIncidentBrushes(*hCur, std::begin(brushes), std::end(brushes), out);
+                    }
                 }
                 return result.release_data();
             }
@@ -512,6 +642,10 @@ namespace TrenchBroom {
             /**
              * Finds all brushes in the given range which are incident to the given handle.
              *
+             * If the given handle is contained in this manager, the brushes that contributed it are looked up, so
+             * only brushes whose handles were added to this manager are found. Otherwise, every brush in the given
+             * range is checked.
+             *
              * @tparam I the type of the range iterators
              * @tparam O an output iterator to append the resulting brushes to
              * @param handle the handle
@@ -521,13 +655,31 @@ namespace TrenchBroom {
              */
             template <typename I, typename O>
             void findIncidentBrushes(const Handle& handle, I begin, I end, O out) const {
-                for (auto cur = begin; cur != end; ++cur) {
-                    if (isIncident(handle, *cur)) {
-                        out++ = *cur;
+                const auto it = m_handles.find(handle);
+                if (it != std::end(m_handles)) {
+                    const auto& brushes = it->second.brushes;
+                    for (auto cur = begin; cur != end; ++cur) {
+                        if (std::find(std::begin(brushes), std::end(brushes), *cur) != std::end(brushes)) {
+                            out++ = *cur;
+                        }
+                    }
+                } else {
+                    for (auto cur = begin; cur != end; ++cur) {
+                        if (isIncident(handle, *cur)) {
+                            out++ = *cur;
+                        }
                     }
                 }
             }
         private:
+            /**
+             * Returns the bounds of the given handle.
+             *
+             * @param handle the handle
+             * @return the bounds of the handle
+             */
+            virtual vm::bbox3 handleBounds(const Handle& handle) const = 0;
+
             /**
              * Checks whether the given brush is incident to the given handle.
              *
@@ -564,6 +716,7 @@ namespace TrenchBroom {
             Model::HitType::Type hitType() const override;
         private:
             bool isIncident(const Handle& handle, const Model::BrushNode* brushNode) const override;
+            vm::bbox3 handleBounds(const Handle& handle) const override;
         };
 
         /**
@@ -609,6 +762,7 @@ namespace TrenchBroom {
             Model::HitType::Type hitType() const override;
         private:
             bool isIncident(const Handle& handle, const Model::BrushNode* brushNode) const override;
+            vm::bbox3 handleBounds(const Handle& handle) const override;
         };
 
         /**
@@ -655,6 +809,7 @@ namespace TrenchBroom {
             Model::HitType::Type hitType() const override;
         private:
             bool isIncident(const Handle& handle, const Model::BrushNode* brushNode) const override;
+            vm::bbox3 handleBounds(const Handle& handle) const override;
         };
     }
 }
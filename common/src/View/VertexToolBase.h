@@ -138,16 +138,7 @@ namespace TrenchBroom {
             template <typename M, typename I>
             std::vector<Model::BrushNode*> findIncidentBrushes(const M& manager, I cur, I end) const {
                 const std::vector<Model::BrushNode*>& brushes = selectedBrushes();
-                kdl::vector_set<Model::BrushNode*> result;
-                auto out = std::inserter(result, std::end(result));
-
-                while (cur != end) {
-                    const auto& handle = *cur;
-                    manager.findIncidentBrushes(handle, std::begin(brushes), std::end(brushes), out);
-                    ++cur;
-                }
-
-                return result.release_data();
+                return manager.findIncidentBrushes(cur, end, std::begin(brushes), std::end(brushes));
             }
 
             virtual void pick(const vm::ray3& pickRay, const Renderer::Camera& camera, Model::PickResult& pickResult) const = 0;
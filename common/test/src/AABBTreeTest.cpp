@@ -27,6 +27,7 @@
 
 #include <set>
 #include <sstream>
+#include <vector>
 
 namespace TrenchBroom {
     using AABB = AABBTree<double, 3, size_t>;
@@ -489,6 +490,124 @@ L [ ( -1 -1 -1 ) ( 1 1 1 ) ]: 1
         assertIntersectors(tree, RAY(VEC(0.0,  0.0,  0.0), VEC::pos_x()), { 2u });
     }
 
+    TEST_CASE("AABBTreeTest.clearAndBuild", "[AABBTreeTest]") {
+        std::vector<BOX> boxes;
+        for (size_t i = 0u; i < 100u; ++i) {
+            const auto x = static_cast<double>(i % 10u) * 3.0;
+            const auto y = static_cast<double>(i / 10u) * 3.0;
+            boxes.push_back(BOX(VEC(x, y, 0.0), VEC(x + 1.0, y + 1.0, 1.0)));
+        }
+
+        std::vector<size_t> indices;
+        for (size_t i = 0u; i < boxes.size(); ++i) {
+            indices.push_back(i);
+        }
+
+        AABB tree;
+        tree.clearAndBuild(indices, [&](const size_t i) { return boxes[i]; });
+
+        ASSERT_FALSE(tree.empty());
+        ASSERT_EQ(BOX(VEC(0.0, 0.0, 0.0), VEC(28.0, 28.0, 1.0)), tree.bounds());
+        // a balanced tree with 100 leafs has a height of 8, allow for some slack
+        ASSERT_LE(tree.height(), 10u);
+
+        for (size_t i = 0u; i < boxes.size(); ++i) {
+            assertTreeContains(tree, boxes[i], i);
+        }
+
+        assertIntersectors(tree, RAY(VEC(-1.0, 0.5, 0.5), VEC::pos_x()), { 0u, 1u, 2u, 3u, 4u, 5u, 6u, 7u, 8u, 9u });
+        assertIntersectors(tree, RAY(VEC(0.5, -1.0, 0.5), VEC::pos_y()), { 0u, 10u, 20u, 30u, 40u, 50u, 60u, 70u, 80u, 90u });
+        assertIntersectors(tree, RAY(VEC(1.5, -1.0, 0.5), VEC::pos_y()), {});
+
+        // incremental changes still work on the built tree
+        const auto newBox = BOX(VEC(1.5, 1.5, 0.0), VEC(2.5, 2.5, 1.0));
+        tree.insert(newBox, 100u);
+        assertTreeContains(tree, newBox, 100u);
+
+        ASSERT_TRUE(tree.remove(0u));
+        assertTreeDoesNotContain(tree, boxes[0], 0u);
+
+        tree.update(boxes[0], 1u);
+        assertTreeContains(tree, boxes[0], 1u);
+
+        // rebuilding the tree discards the changes
+        tree.clearAndBuild(indices, [&](const size_t i) { return boxes[i]; });
+        for (size_t i = 0u; i < boxes.size(); ++i) {
+            assertTreeContains(tree, boxes[i], i);
+        }
+        assertTreeDoesNotContain(tree, newBox, 100u);
+    }
+
+    TEST_CASE("AABBTreeTest.clearAndBuildWithIdenticalBounds", "[AABBTreeTest]") {
+        const auto box = BOX(VEC(0.0, 0.0, 0.0), VEC(1.0, 1.0, 1.0));
+        const auto indices = std::vector<size_t>({ 0u, 1u, 2u, 3u, 4u, 5u, 6u, 7u });
+
+        AABB tree;
+        tree.clearAndBuild(indices, [&](const size_t) { return box; });
+
+        ASSERT_EQ(4u, tree.height());
+        for (const auto i : indices) {
+            assertTreeContains(tree, box, i);
+        }
+    }
+
+    TEST_CASE("AABBTreeTest.clearAndBuildWithDuplicates", "[AABBTreeTest]") {
+        const auto box = BOX(VEC(0.0, 0.0, 0.0), VEC(1.0, 1.0, 1.0));
+
+        AABB tree;
+        ASSERT_THROW(tree.clearAndBuild(std::vector<size_t>({ 0u, 1u, 0u }), [&](const size_t) { return box; }), NodeTreeException);
+        ASSERT_TRUE(tree.empty());
+        ASSERT_FALSE(tree.contains(0u));
+    }
+
+    TEST_CASE("AABBTreeTest.queriesBeforeAndAfterFlattening", "[AABBTreeTest]") {
+        // the tree is flattened after some queries; all queries must return the same results
+        AABB tree;
+        for (size_t i = 0u; i < 50u; ++i) {
+            const auto x = static_cast<double>(i % 7u) * 2.0;
+            const auto y = static_cast<double>(i % 5u) * 3.0;
+            const auto z = static_cast<double>(i % 3u) * 4.0;
+            tree.insert(BOX(VEC(x, y, z), VEC(x + 2.5, y + 1.0, z + 3.0)), i);
+        }
+
+        const auto ray = RAY(VEC(-1.0, 0.5, 1.0), vm::normalize(VEC(1.0, 0.2, 0.1)));
+        const auto point = VEC(2.5, 0.5, 2.0);
+
+        std::set<AABB::DataType> expectedIntersectors;
+        tree.findIntersectors(ray, std::inserter(expectedIntersectors, std::end(expectedIntersectors)));
+        ASSERT_FALSE(expectedIntersectors.empty());
+
+        std::set<AABB::DataType> expectedContainers;
+        tree.findContainers(point, std::inserter(expectedContainers, std::end(expectedContainers)));
+        ASSERT_FALSE(expectedContainers.empty());
+
+        for (size_t i = 0u; i < 10u; ++i) {
+            std::set<AABB::DataType> intersectors;
+            tree.findIntersectors(ray, std::inserter(intersectors, std::end(intersectors)));
+            ASSERT_EQ(expectedIntersectors, intersectors);
+
+            std::set<AABB::DataType> containers;
+            tree.findContainers(point, std::inserter(containers, std::end(containers)));
+            ASSERT_EQ(expectedContainers, containers);
+        }
+
+        // modifying the tree invalidates the flattened tree
+        const auto removed = *expectedContainers.begin();
+        ASSERT_TRUE(tree.remove(removed));
+        expectedContainers.erase(removed);
+        expectedIntersectors.erase(removed);
+
+        for (size_t i = 0u; i < 10u; ++i) {
+            std::set<AABB::DataType> intersectors;
+            tree.findIntersectors(ray, std::inserter(intersectors, std::end(intersectors)));
+            ASSERT_EQ(expectedIntersectors, intersectors);
+
+            std::set<AABB::DataType> containers;
+            tree.findContainers(point, std::inserter(containers, std::end(containers)));
+            ASSERT_EQ(expectedContainers, containers);
+        }
+    }
+
     void assertTree(const std::string& exp, const AABB& actual) {
         std::stringstream str;
         actual.print(str);
@@ -0,0 +1,94 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include "GTestCompat.h"
+
+#include "Allocator.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace TrenchBroom {
+    struct AllocatorTestObject : public Allocator<AllocatorTestObject, 16> {
+        size_t value;
+        double padding[3];
+
+        explicit AllocatorTestObject(const size_t i_value) :
+        value(i_value),
+        padding{} {}
+    };
+
+    TEST_CASE("AllocatorTest.allocateAndFree", "[AllocatorTest]") {
+        std::vector<AllocatorTestObject*> objects;
+        for (size_t i = 0u; i < 100u; ++i) {
+            objects.push_back(new AllocatorTestObject(i));
+        }
+
+        std::vector<AllocatorTestObject*> sorted = objects;
+        std::sort(std::begin(sorted), std::end(sorted));
+        ASSERT_TRUE(std::adjacent_find(std::begin(sorted), std::end(sorted)) == std::end(sorted));
+
+        for (size_t i = 0u; i < objects.size(); ++i) {
+            ASSERT_EQ(i, objects[i]->value);
+        }
+
+        for (auto* object : objects) {
+            delete object;
+        }
+    }
+
+    TEST_CASE("AllocatorTest.freeOnOtherThread", "[AllocatorTest]") {
+        std::vector<std::vector<AllocatorTestObject*>> objects(4u);
+
+        std::vector<std::thread> threads;
+        for (size_t t = 0u; t < objects.size(); ++t) {
+            threads.emplace_back([&, t]() {
+                for (size_t i = 0u; i < 1000u; ++i) {
+                    objects[t].push_back(new AllocatorTestObject(t * 1000u + i));
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        threads.clear();
+
+        for (size_t t = 0u; t < objects.size(); ++t) {
+            for (size_t i = 0u; i < objects[t].size(); ++i) {
+                ASSERT_EQ(t * 1000u + i, objects[t][i]->value);
+            }
+        }
+
+        // free every thread's objects on another thread while new objects are being allocated
+        for (size_t t = 0u; t < objects.size(); ++t) {
+            threads.emplace_back([&, t]() {
+                for (auto* object : objects[(t + 1u) % objects.size()]) {
+                    delete object;
+                    delete new AllocatorTestObject(t);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+}
@@ -0,0 +1,164 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include "GTestCompat.h"
+
+#include "Exceptions.h"
+#include "Logger.h"
+#include "Assets/EntityModel.h"
+#include "Assets/EntityModelManager.h"
+#include "Assets/ModelDefinition.h"
+#include "IO/EntityModelLoader.h"
+#include "IO/Path.h"
+
+#include <vecmath/bbox.h>
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Assets {
+        class CountingEntityModelLoader : public IO::EntityModelLoader {
+        public:
+            mutable std::atomic<size_t> initializeCount;
+
+            CountingEntityModelLoader() :
+            initializeCount(0u) {}
+        private:
+            std::unique_ptr<EntityModel> doInitializeModel(const IO::Path& path, Logger& /* logger */) const override {
+                ++initializeCount;
+                if (path == IO::Path("missing.mdl")) {
+                    throw GameException("Could not load model " + path.asString());
+                }
+                if (path == IO::Path("malformed.mdl")) {
+                    throw std::length_error("malformed model header");
+                }
+
+                auto model = std::make_unique<EntityModel>(path.asString(), PitchType::Normal);
+                model->addFrames(2);
+                return model;
+            }
+
+            void doLoadFrame(const IO::Path& /* path */, const size_t frameIndex, EntityModel& model, Logger& /* logger */) const override {
+                model.loadFrame(frameIndex, "frame", vm::bbox3f(16.0f));
+            }
+        };
+
+        class LoadedModelsObserver {
+        public:
+            std::vector<IO::Path> paths;
+
+            void modelsWereLoaded(const std::vector<IO::Path>& loadedPaths) {
+                paths.insert(std::end(paths), std::begin(loadedPaths), std::end(loadedPaths));
+            }
+        };
+
+        static void waitForLoads(EntityModelManager& manager) {
+            while (manager.hasPendingLoads()) {
+                std::this_thread::yield();
+                manager.commitLoadedModels();
+            }
+        }
+
+        TEST_CASE("EntityModelManagerTest.loadModelAsynchronously", "[EntityModelManagerTest]") {
+            NullLogger logger;
+            CountingEntityModelLoader loader;
+            LoadedModelsObserver observer;
+
+            EntityModelManager manager(0, 0, logger);
+            manager.setLoader(&loader);
+            manager.modelsWereLoadedNotifier.addObserver(&observer, &LoadedModelsObserver::modelsWereLoaded);
+
+            const auto spec = ModelSpecification(IO::Path("model.mdl"));
+            ASSERT_EQ(nullptr, manager.frame(spec));
+            ASSERT_EQ(nullptr, manager.frame(spec));
+            ASSERT_TRUE(manager.hasPendingLoads());
+
+            waitForLoads(manager);
+
+            ASSERT_EQ(1u, loader.initializeCount.load());
+            ASSERT_EQ(std::vector<IO::Path>({ IO::Path("model.mdl") }), observer.paths);
+
+            const auto* frame = manager.frame(spec);
+            ASSERT_NE(nullptr, frame);
+            ASSERT_TRUE(frame->loaded());
+            ASSERT_EQ(vm::bbox3f(16.0f), frame->bounds());
+
+            // frames that were not requested before the model was loaded are loaded on demand
+            const auto* otherFrame = manager.frame(ModelSpecification(IO::Path("model.mdl"), 0, 1));
+            ASSERT_NE(nullptr, otherFrame);
+            ASSERT_TRUE(otherFrame->loaded());
+            ASSERT_EQ(1u, loader.initializeCount.load());
+        }
+
+        TEST_CASE("EntityModelManagerTest.loadMissingModelOnce", "[EntityModelManagerTest]") {
+            NullLogger logger;
+            CountingEntityModelLoader loader;
+
+            EntityModelManager manager(0, 0, logger);
+            manager.setLoader(&loader);
+
+            const auto spec = ModelSpecification(IO::Path("missing.mdl"));
+            ASSERT_EQ(nullptr, manager.frame(spec));
+            waitForLoads(manager);
+
+            ASSERT_EQ(nullptr, manager.frame(spec));
+            ASSERT_FALSE(manager.hasPendingLoads());
+            ASSERT_EQ(1u, loader.initializeCount.load());
+        }
+
+        TEST_CASE("EntityModelManagerTest.loadMalformedModel", "[EntityModelManagerTest]") {
+            NullLogger logger;
+            CountingEntityModelLoader loader;
+
+            EntityModelManager manager(0, 0, logger);
+            manager.setLoader(&loader);
+
+            // exceptions that are not derived from Exception must not escape the load workers
+            const auto spec = ModelSpecification(IO::Path("malformed.mdl"));
+            ASSERT_EQ(nullptr, manager.frame(spec));
+            waitForLoads(manager);
+
+            ASSERT_EQ(nullptr, manager.frame(spec));
+            ASSERT_FALSE(manager.hasPendingLoads());
+            ASSERT_EQ(1u, loader.initializeCount.load());
+        }
+
+        TEST_CASE("EntityModelManagerTest.clearCancelsLoads", "[EntityModelManagerTest]") {
+            NullLogger logger;
+            CountingEntityModelLoader loader;
+
+            EntityModelManager manager(0, 0, logger);
+            manager.setLoader(&loader);
+
+            for (size_t i = 0u; i < 100u; ++i) {
+                manager.frame(ModelSpecification(IO::Path("model" + std::to_string(i) + ".mdl")));
+            }
+
+            manager.clear();
+            ASSERT_FALSE(manager.hasPendingLoads());
+        }
+    }
+}
@@ -31,6 +31,7 @@
 #include "IO/ELParser.h"
 
 #include <string>
+#include <vector>
 
 namespace TrenchBroom {
     namespace EL {
@@ -331,6 +332,13 @@ namespace TrenchBroom {
             evaluateAndAssert("2 + 3 < 2 + 4 -> 6 % 5", 1);
         }
 
+        TEST_CASE("ExpressionTest.testVariableNames", "[ExpressionTest]") {
+            ASSERT_EQ(std::vector<std::string>{}, IO::ELParser::parseStrict("1 + 2").variableNames());
+            ASSERT_EQ(std::vector<std::string>{ "x" }, IO::ELParser::parseStrict("x + x").variableNames());
+            ASSERT_EQ(std::vector<std::string>({ "model", "skin" }), IO::ELParser::parseStrict("{ 'path': model, 'skin': skin + 1 }").variableNames());
+            ASSERT_EQ(std::vector<std::string>({ "a", "b", "c", "d" }), IO::ELParser::parseStrict("{{ d == 1 -> [a, -b], c[0] }}").variableNames());
+        }
+
         void evalutateComparisonAndAssert(const std::string& op, bool result) {
             const std::string expression = "4 " + op + " 5";
             evaluateAndAssert(expression, result);
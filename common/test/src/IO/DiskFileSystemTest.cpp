@@ -142,6 +142,25 @@ namespace TrenchBroom {
             ASSERT_TRUE(Disk::openFile(env.dir() + Path("anotherDir/subDirTest/test2.map")) != nullptr);
         }
 
+        TEST_CASE("DiskTest.openMappedFile", "[DiskTest]") {
+            FSTestEnvironment env;
+
+            const auto file = Disk::openFile(env.dir() + Path("test.txt"));
+            ASSERT_EQ(12u, file->size());
+
+            auto reader = file->reader().buffer();
+            ASSERT_EQ(std::string("some content"), reader.readString(reader.size()));
+
+            const auto view = FileView(Path("view.txt"), file, 5u, 7u);
+            auto viewReader = view.reader().buffer();
+            ASSERT_EQ(std::string("content"), viewReader.readString(viewReader.size()));
+
+            env.createFile(Path("empty.txt"), "");
+            const auto emptyFile = Disk::openFile(env.dir() + Path("empty.txt"));
+            ASSERT_EQ(0u, emptyFile->size());
+            ASSERT_EQ(0u, emptyFile->reader().size());
+        }
+
         TEST_CASE("DiskTest.resolvePath", "[DiskTest]") {
             FSTestEnvironment env;
 
@@ -0,0 +1,134 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include "GTestCompat.h"
+
+#include "IO/File.h"
+#include "IO/FileCache.h"
+#include "IO/Path.h"
+
+#include <memory>
+#include <string>
+
+namespace TrenchBroom {
+    namespace IO {
+        static std::shared_ptr<File> makeFile(const std::string& path, const size_t size) {
+            return std::make_shared<OwningBufferFile>(Path(path), std::make_unique<char[]>(size), size);
+        }
+
+        TEST_CASE("FileCacheTest.getAndPut", "[FileCacheTest]") {
+            FileCache cache(100u);
+
+            ASSERT_EQ(nullptr, cache.get(Path("/image.pak"), Path("a.txt")));
+
+            const auto file = makeFile("a.txt", 10u);
+            cache.put(Path("/image.pak"), Path("a.txt"), file);
+            ASSERT_TRUE(cache.contains(Path("/image.pak"), Path("a.txt")));
+            ASSERT_FALSE(cache.contains(Path("/other.pak"), Path("a.txt")));
+            ASSERT_EQ(file, cache.get(Path("/image.pak"), Path("a.txt")));
+
+            const auto statistics = cache.statistics();
+            ASSERT_EQ(1u, statistics.hits);
+            ASSERT_EQ(1u, statistics.misses);
+            ASSERT_EQ(0u, statistics.evictions);
+            ASSERT_EQ(1u, statistics.entries);
+            ASSERT_EQ(10u, statistics.size);
+            ASSERT_EQ(100u, statistics.capacity);
+
+            cache.resetStatistics();
+            ASSERT_EQ(0u, cache.statistics().hits);
+            ASSERT_EQ(0u, cache.statistics().misses);
+            ASSERT_EQ(10u, cache.statistics().size);
+        }
+
+        TEST_CASE("FileCacheTest.replace", "[FileCacheTest]") {
+            FileCache cache(100u);
+
+            cache.put(Path("/image.pak"), Path("a.txt"), makeFile("a.txt", 10u));
+
+            const auto file = makeFile("a.txt", 20u);
+            cache.put(Path("/image.pak"), Path("a.txt"), file);
+            ASSERT_EQ(file, cache.get(Path("/image.pak"), Path("a.txt")));
+            ASSERT_EQ(1u, cache.statistics().entries);
+            ASSERT_EQ(20u, cache.statistics().size);
+        }
+
+        TEST_CASE("FileCacheTest.evictLeastRecentlyUsed", "[FileCacheTest]") {
+            FileCache cache(30u);
+
+            cache.put(Path("/image.pak"), Path("a.txt"), makeFile("a.txt", 10u));
+            cache.put(Path("/image.pak"), Path("b.txt"), makeFile("b.txt", 10u));
+            cache.put(Path("/image.pak"), Path("c.txt"), makeFile("c.txt", 10u));
+
+            // a.txt becomes the most recently used file
+            ASSERT_NE(nullptr, cache.get(Path("/image.pak"), Path("a.txt")));
+
+            cache.put(Path("/image.pak"), Path("d.txt"), makeFile("d.txt", 15u));
+            ASSERT_TRUE(cache.contains(Path("/image.pak"), Path("a.txt")));
+            ASSERT_FALSE(cache.contains(Path("/image.pak"), Path("b.txt")));
+            ASSERT_FALSE(cache.contains(Path("/image.pak"), Path("c.txt")));
+            ASSERT_TRUE(cache.contains(Path("/image.pak"), Path("d.txt")));
+            ASSERT_EQ(2u, cache.statistics().evictions);
+            ASSERT_EQ(25u, cache.statistics().size);
+
+            // files that exceed the capacity are not cached
+            cache.put(Path("/image.pak"), Path("e.txt"), makeFile("e.txt", 31u));
+            ASSERT_FALSE(cache.contains(Path("/image.pak"), Path("e.txt")));
+            ASSERT_EQ(2u, cache.statistics().entries);
+
+            cache.setCapacity(10u);
+            ASSERT_FALSE(cache.contains(Path("/image.pak"), Path("a.txt")));
+            ASSERT_FALSE(cache.contains(Path("/image.pak"), Path("d.txt")));
+            ASSERT_EQ(0u, cache.statistics().size);
+        }
+
+        TEST_CASE("FileCacheTest.unlimitedCapacity", "[FileCacheTest]") {
+            FileCache cache(10u);
+
+            cache.put(Path("/image.pak"), Path("a.txt"), makeFile("a.txt", 10u));
+            cache.setCapacity(0u);
+
+            cache.put(Path("/image.pak"), Path("b.txt"), makeFile("b.txt", 20u));
+            ASSERT_TRUE(cache.contains(Path("/image.pak"), Path("a.txt")));
+            ASSERT_TRUE(cache.contains(Path("/image.pak"), Path("b.txt")));
+            ASSERT_EQ(0u, cache.statistics().evictions);
+            ASSERT_EQ(30u, cache.statistics().size);
+        }
+
+        TEST_CASE("FileCacheTest.evictImage", "[FileCacheTest]") {
+            FileCache cache(100u);
+
+            cache.put(Path("/image.pak"), Path("a.txt"), makeFile("a.txt", 10u));
+            cache.put(Path("/image.pak"), Path("dir/b.txt"), makeFile("dir/b.txt", 10u));
+            cache.put(Path("/other.pak"), Path("a.txt"), makeFile("a.txt", 10u));
+
+            cache.evict(Path("/image.pak"));
+            ASSERT_FALSE(cache.contains(Path("/image.pak"), Path("a.txt")));
+            ASSERT_FALSE(cache.contains(Path("/image.pak"), Path("dir/b.txt")));
+            ASSERT_TRUE(cache.contains(Path("/other.pak"), Path("a.txt")));
+            ASSERT_EQ(10u, cache.statistics().size);
+
+            cache.clear();
+            ASSERT_FALSE(cache.contains(Path("/other.pak"), Path("a.txt")));
+            ASSERT_EQ(0u, cache.statistics().entries);
+        }
+    }
+}
@@ -27,6 +27,7 @@
 #include "Model/BrushBuilder.h"
 #include "Model/BrushFace.h"
 #include "Model/BrushFaceAttributes.h"
+#include "Model/EntityNode.h"
 #include "Model/GroupNode.h"
 #include "Model/LayerNode.h"
 #include "Model/LockState.h"
@@ -37,6 +38,7 @@
 #include <kdl/result.h>
 #include <kdl/string_compare.h>
 
+#include <cstdio>
 #include <iostream>
 #include <sstream>
 #include <vector>
@@ -665,5 +667,48 @@ R"(( -32 -32 -32 ) ( -32 -31 -32 ) ( -32 -32 -31 ) none 0 0 0 1 1
                          "\"message3\" \"holy damn\\\\\"\n"
                          "}\n", result.c_str());
         }
+
+        TEST_CASE("NodeWriterTest.writeMapToFile", "[NodeWriterTest]") {
+            const vm::bbox3 worldBounds(8192.0);
+
+            Model::WorldNode map(Model::MapFormat::Standard);
+            map.addOrUpdateAttribute("classname", "worldspawn");
+
+            Model::BrushBuilder builder(&map, worldBounds);
+            for (size_t i = 0; i < 100; ++i) {
+                const auto min = vm::vec3(static_cast<FloatType>(i) * 64.0, 0.0, 0.0);
+                Model::BrushNode* brushNode = map.createBrush(builder.createCuboid(vm::bbox3(min, min + vm::vec3(32.0, 32.0, 32.0)), "none").value());
+                map.defaultLayer()->addChild(brushNode);
+            }
+
+            Model::EntityNode* entityNode = map.createEntity();
+            entityNode->addOrUpdateAttribute("classname", "info_player_start");
+            entityNode->addOrUpdateAttribute("message", "\"quoted\"");
+            map.defaultLayer()->addChild(entityNode);
+
+            std::stringstream str;
+            NodeWriter(map, str).writeMap();
+
+            FILE* file = std::tmpfile();
+            REQUIRE(file != nullptr);
+            NodeWriter(map, file).writeMap();
+
+            std::string actual;
+            std::rewind(file);
+            char buffer[4096];
+            for (auto read = std::fread(buffer, 1, sizeof(buffer), file); read > 0; read = std::fread(buffer, 1, sizeof(buffer), file)) {
+                actual.append(buffer, read);
+            }
+            std::fclose(file);
+
+            // integer coordinates are formatted identically by both serializers
+            ASSERT_EQ(str.str(), actual);
+
+            // each brush takes a comment line, six face lines and two brace lines
+            const Model::Node* lastBrush = map.defaultLayer()->children()[99];
+            ASSERT_EQ(5u + 99u * 9u, lastBrush->lineNumber());
+            ASSERT_TRUE(lastBrush->containsLine(5u + 99u * 9u + 7u));
+            ASSERT_FALSE(lastBrush->containsLine(5u + 99u * 9u + 8u));
+        }
     }
 }
@@ -90,6 +90,13 @@ namespace TrenchBroom {
             return file.exists() && file.isFile();
         }
 
+        std::string TestEnvironment::loadFile(const Path& path) const {
+            auto file = QFile(IO::pathAsQString(m_dir + path));
+            assertResult(file.open(QIODevice::ReadOnly));
+
+            return file.readAll().toStdString();
+        }
+
         void TestEnvironment::doCreateTestEnvironment() {}
     }
 }
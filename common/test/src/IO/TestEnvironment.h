@@ -44,6 +44,8 @@ namespace TrenchBroom {
 
             bool directoryExists(const Path& path) const;
             bool fileExists(const Path& path) const;
+
+            std::string loadFile(const Path& path) const;
         private:
             virtual void doCreateTestEnvironment();
         };
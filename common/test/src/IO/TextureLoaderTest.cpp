@@ -30,6 +30,7 @@
 #include "IO/TextureLoader.h"
 #include "Model/GameConfig.h"
 
+#include <memory>
 #include <string>
 
 namespace TrenchBroom {
@@ -66,8 +67,10 @@ namespace TrenchBroom {
             auto logger = NullLogger();
             auto textureManager = Assets::TextureManager(0, 0, logger);
 
-            IO::TextureLoader textureLoader(fileSystem, fileSearchPaths, textureConfig, logger);
-            textureLoader.loadTextures(paths, textureManager);
+            auto textureLoader = std::make_unique<IO::TextureLoader>(fileSystem, fileSearchPaths, textureConfig, logger);
+            textureManager.setTextureCollections(paths, std::move(textureLoader));
+            textureManager.waitForPendingLoads();
+            textureManager.commitLoadedCollections();
 
             assertTexture("cr8_czg_1", 64, 64, textureManager);
             assertTexture("cr8_czg_2", 64, 64, textureManager);
@@ -115,8 +118,10 @@ namespace TrenchBroom {
             auto logger = NullLogger();
             auto textureManager = Assets::TextureManager(0, 0, logger);
 
-            IO::TextureLoader textureLoader(fileSystem, fileSearchPaths, textureConfig, logger);
-            textureLoader.loadTextures(paths, textureManager);
+            auto textureLoader = std::make_unique<IO::TextureLoader>(fileSystem, fileSearchPaths, textureConfig, logger);
+            textureManager.setTextureCollections(paths, std::move(textureLoader));
+            textureManager.waitForPendingLoads();
+            textureManager.commitLoadedCollections();
 
             assertTexture("cr8_czg_1", 64, 64, textureManager);
             assertTexture("cr8_czg_2", 64, 64, textureManager);
@@ -35,6 +35,7 @@
 
 #include <vecmath/vec.h>
 
+#include <sstream>
 #include <string>
 
 namespace TrenchBroom {
@@ -266,6 +267,54 @@ namespace TrenchBroom {
                                          vm::vec3(0.0, 64.0, 0.0)) != nullptr);
         }
 
+        TEST_CASE("WorldReaderTest.parseMapWithManyBrushes", "[WorldReaderTest]") {
+            // enough brushes to have their geometry built in parallel
+            const size_t brushCount = 256u;
+            const size_t invalidBrushIndex = 100u;
+
+            std::stringstream str;
+            str << "{\n\"classname\" \"worldspawn\"\n";
+            for (size_t i = 0u; i < brushCount; ++i) {
+                const auto x = 64 * static_cast<int>(i);
+                str << "{\n";
+                str << "( " << x << " -0 -16 ) ( " << x << " -0 -0 ) ( " << x + 64 << " -0 -16 ) tex1 0 0 0 1 1\n";
+                str << "( " << x << " -0 -16 ) ( " << x << " 64 -16 ) ( " << x << " -0 -0 ) tex2 0 0 0 1 1\n";
+                str << "( " << x << " -0 -16 ) ( " << x + 64 << " -0 -16 ) ( " << x << " 64 -16 ) tex3 0 0 0 1 1\n";
+                if (i != invalidBrushIndex) {
+                    str << "( " << x + 64 << " 64 -0 ) ( " << x << " 64 -0 ) ( " << x + 64 << " 64 -16 ) tex4 0 0 0 1 1\n";
+                    str << "( " << x + 64 << " 64 -0 ) ( " << x + 64 << " 64 -16 ) ( " << x + 64 << " -0 -0 ) tex5 0 0 0 1 1\n";
+                    str << "( " << x + 64 << " 64 -0 ) ( " << x + 64 << " -0 -0 ) ( " << x << " 64 -0 ) tex6 0 0 0 1 1\n";
+                }
+                str << "}\n";
+            }
+            str << "}\n";
+
+            const vm::bbox3 worldBounds(8192.0 * 4.0);
+
+            IO::TestParserStatus status;
+            WorldReader reader(str.str());
+
+            auto world = reader.read(Model::MapFormat::Standard, worldBounds, status);
+            CHECK(status.countStatus(LogLevel::Error) == 1u);
+
+            REQUIRE(world->childCount() == 1u);
+            const Model::Node* defaultLayer = world->children().front();
+            REQUIRE(defaultLayer->childCount() == brushCount - 1u);
+
+            // the brushes must be added in file order
+            size_t lastLineNumber = 0u;
+            for (size_t i = 0u; i < defaultLayer->childCount(); ++i) {
+                const auto* brushNode = dynamic_cast<const Model::BrushNode*>(defaultLayer->children()[i]);
+                REQUIRE(brushNode != nullptr);
+                CHECK(brushNode->brush().faceCount() == 6u);
+                CHECK(brushNode->lineNumber() > lastLineNumber);
+                lastLineNumber = brushNode->lineNumber();
+
+                const auto brushIndex = i < invalidBrushIndex ? i : i + 1u;
+                CHECK(brushNode->logicalBounds().min.x() == Approx(64.0 * static_cast<double>(brushIndex)));
+            }
+        }
+
         TEST_CASE("WorldReaderTest.parseMapAndCheckFaceFlags", "[WorldReaderTest]") {
             const std::string data(R"(
 {
@@ -24,6 +24,8 @@
 #include "Exceptions.h"
 #include "IO/DiskIO.h"
 #include "IO/DiskFileSystem.h"
+#include "IO/File.h"
+#include "IO/FileCache.h"
 #include "IO/FileMatcher.h"
 #include "IO/ZipFileSystem.h"
 
@@ -142,5 +144,37 @@ namespace TrenchBroom {
 
             ASSERT_TRUE(fs.openFile(Path("amnet.cfg")) != nullptr);
         }
+
+        TEST_CASE("ZipFileSystemTest.openCachedFile", "[ZipFileSystemTest]") {
+            const Path zipPath = Disk::getCurrentWorkingDir() + Path("fixture/test/IO/Zip/zip_test.zip");
+
+            const ZipFileSystem fs(zipPath);
+            auto& cache = ZipFileSystem::fileCache();
+            ASSERT_FALSE(cache.contains(zipPath, Path("amnet.cfg")));
+
+            const auto file = fs.openFile(Path("amnet.cfg"));
+            ASSERT_TRUE(cache.contains(zipPath, Path("amnet.cfg")));
+            ASSERT_EQ(file, fs.openFile(Path("AMNET.CFG")));
+        }
+
+        TEST_CASE("ZipFileSystemTest.prefetch", "[ZipFileSystemTest]") {
+            const Path zipPath = Disk::getCurrentWorkingDir() + Path("fixture/test/IO/Zip/zip_test.zip");
+
+            const ZipFileSystem fs(zipPath);
+            auto& cache = ZipFileSystem::fileCache();
+
+            const auto paths = fs.findItemsRecursively(Path(""), FileExtensionMatcher("wal"));
+            fs.prefetch(paths);
+            fs.prefetch({ Path("does_not_exist.wal") });
+
+            for (const auto& path : paths) {
+                ASSERT_TRUE(cache.contains(zipPath, path));
+            }
+            ASSERT_FALSE(cache.contains(zipPath, Path("does_not_exist.wal")));
+
+            const auto hits = cache.statistics().hits;
+            ASSERT_TRUE(fs.openFile(paths.front()) != nullptr);
+            ASSERT_EQ(hits + 1u, cache.statistics().hits);
+        }
     }
 }
@@ -0,0 +1,100 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include "GTestCompat.h"
+
+#include "InternedString.h"
+
+#include <kdl/parallel.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom {
+    TEST_CASE("InternedStringTest.defaultConstructor", "[InternedStringTest]") {
+        const auto str = InternedString();
+        ASSERT_TRUE(str.empty());
+        ASSERT_EQ(std::string(""), str.str());
+        ASSERT_EQ(0u, str.id());
+        ASSERT_EQ(InternedString(""), str);
+    }
+
+    TEST_CASE("InternedStringTest.emptyStringHasIdZero", "[InternedStringTest]") {
+        // intern another string first, this is the first access to the table when this test is run on its own
+        const auto str = InternedString("interned_string_test_first");
+        const auto empty = InternedString(std::string(""));
+
+        ASSERT_NE(0u, str.id());
+        ASSERT_EQ(0u, empty.id());
+        ASSERT_EQ(InternedString(), empty);
+    }
+
+    TEST_CASE("InternedStringTest.intern", "[InternedStringTest]") {
+        const auto a = InternedString("interned_string_test_a");
+        const auto b = InternedString(std::string("interned_string_test_b"));
+
+        ASSERT_EQ(std::string("interned_string_test_a"), a.str());
+        ASSERT_EQ(a, InternedString(std::string_view("interned_string_test_a")));
+        ASSERT_EQ(a.id(), InternedString("interned_string_test_a").id());
+        ASSERT_EQ(&a.str(), &InternedString("interned_string_test_a").str());
+
+        ASSERT_NE(a, b);
+        ASSERT_NE(a.id(), b.id());
+        ASSERT_TRUE(a < b);
+        ASSERT_FALSE(b < a);
+        ASSERT_FALSE(a < a);
+
+        ASSERT_TRUE(a.id() < InternedString::count());
+        ASSERT_TRUE(b.id() < InternedString::count());
+
+        std::stringstream str;
+        str << a;
+        ASSERT_EQ(std::string("interned_string_test_a"), str.str());
+    }
+
+    TEST_CASE("InternedStringTest.toLower", "[InternedStringTest]") {
+        const auto mixed = InternedString("Interned_String_Test_Mixed");
+        const auto lower = InternedString("interned_string_test_mixed");
+
+        ASSERT_NE(mixed, lower);
+        ASSERT_EQ(lower, mixed.toLower());
+        ASSERT_EQ(lower, lower.toLower());
+        ASSERT_EQ(lower, InternedString("INTERNED_STRING_TEST_MIXED").toLower());
+    }
+
+    TEST_CASE("InternedStringTest.internConcurrently", "[InternedStringTest]") {
+        const auto count = size_t(1000);
+        auto strings = std::vector<std::string>();
+        for (size_t i = 0; i < count; ++i) {
+            strings.push_back("interned_string_test_concurrent_" + std::to_string(i % 100));
+        }
+
+        const auto interned = kdl::vec_parallel_transform(strings, [](const std::string& str) {
+            return InternedString(str);
+        });
+
+        for (size_t i = 0; i < count; ++i) {
+            ASSERT_EQ(strings[i], interned[i].str());
+            ASSERT_EQ(interned[i % 100], interned[i]);
+        }
+    }
+}
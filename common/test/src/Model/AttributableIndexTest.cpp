@@ -69,6 +69,36 @@ namespace TrenchBroom {
             delete entity2;
         }
 
+        TEST_CASE("EntityAttributeIndexTest.addAttributableNodes", "[EntityAttributeIndexTest]") {
+            AttributableNodeIndex index;
+
+            EntityNode* entity1 = new EntityNode();
+            entity1->addOrUpdateAttribute("test", "somevalue");
+            entity1->addOrUpdateAttribute("target1", "sometarget");
+
+            EntityNode* entity2 = new EntityNode();
+            entity2->addOrUpdateAttribute("test", "somevalue");
+            entity2->addOrUpdateAttribute("target2", "sometarget");
+            entity2->addOrUpdateAttribute("other", "someothervalue");
+
+            index.addAttributableNodes({ entity1, entity2 });
+
+            ASSERT_TRUE(findExactExact(index, "test", "notfound").empty());
+            ASSERT_COLLECTIONS_EQUIVALENT(std::vector<AttributableNode*>({ entity1, entity2 }), findExactExact(index, "test", "somevalue"));
+            ASSERT_EQ(std::vector<AttributableNode*>({ entity2 }), findExactExact(index, "other", "someothervalue"));
+            ASSERT_COLLECTIONS_EQUIVALENT(std::vector<AttributableNode*>({ entity1, entity2 }), findNumberedExact(index, "target", "sometarget"));
+
+            index.removeAttributableNode(entity1);
+            ASSERT_EQ(std::vector<AttributableNode*>({ entity2 }), findExactExact(index, "test", "somevalue"));
+
+            index.clear();
+            ASSERT_TRUE(findExactExact(index, "test", "somevalue").empty());
+            ASSERT_TRUE(index.allNames().empty());
+
+            delete entity1;
+            delete entity2;
+        }
+
         TEST_CASE("EntityAttributeIndexTest.removeAttributableNode", "[EntityAttributeIndexTest]") {
             AttributableNodeIndex index;
 
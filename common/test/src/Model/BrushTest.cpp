@@ -482,6 +482,19 @@ namespace TrenchBroom {
             EXPECT_COLLECTIONS_EQUIVALENT(expandedBBox.vertices(), brush1.vertexPositions());
         }
 
+        TEST_CASE("BrushTest.memorySizeCountsSharedGeometryOnce", "[BrushTest]") {
+            const vm::bbox3 worldBounds(8192.0);
+            WorldNode world(MapFormat::Standard);
+            const BrushBuilder builder(&world, worldBounds);
+
+            const Brush brush = builder.createCube(64.0, "texture").value();
+            const auto ownedSize = brush.memorySize();
+
+            const Brush copy = brush;
+            CHECK(brush.memorySize() < ownedSize);
+            CHECK(copy.memorySize() == brush.memorySize());
+        }
+
         TEST_CASE("BrushTest.contract", "[BrushTest]") {
             const vm::bbox3 worldBounds(8192.0);
             WorldNode world(MapFormat::Standard);
@@ -21,6 +21,11 @@
 
 #include "GTestCompat.h"
 
+#include "Color.h"
+#include "Assets/EntityDefinition.h"
+#include "Assets/ModelDefinition.h"
+#include "IO/ELParser.h"
+#include "IO/Path.h"
 #include "Model/BrushError.h"
 #include "Model/EntityNode.h"
 #include "Model/EntityRotationPolicy.h"
@@ -36,6 +41,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace TrenchBroom {
     namespace Model {
@@ -190,5 +196,31 @@ namespace TrenchBroom {
             EXPECT_DOUBLE_EQ(45.0, yawPitchRoll.y());
             EXPECT_DOUBLE_EQ(180.0, yawPitchRoll.x());
         }
+
+        TEST_CASE_METHOD(EntityNodeTest, "EntityTest.modelSpecificationUpdatesWithReferencedAttributes") {
+            const auto modelDefinition = Assets::ModelDefinition(IO::ELParser::parseStrict("{ 'path': model, 'skin': skin }"));
+            ASSERT_EQ(std::vector<std::string>({ "model", "skin" }), modelDefinition.variableNames());
+
+            auto definition = Assets::PointEntityDefinition("some_name", Color(), vm::bbox3(16.0), "", {}, modelDefinition);
+            m_entity->addOrUpdateAttribute("model", "progs/armor.mdl");
+            m_entity->setDefinition(&definition);
+
+            ASSERT_EQ(Assets::ModelSpecification(IO::Path("progs/armor.mdl"), 0, 0), m_entity->modelSpecification());
+
+            m_entity->addOrUpdateAttribute("unrelated", "value");
+            ASSERT_EQ(Assets::ModelSpecification(IO::Path("progs/armor.mdl"), 0, 0), m_entity->modelSpecification());
+
+            m_entity->addOrUpdateAttribute("skin", "2");
+            ASSERT_EQ(Assets::ModelSpecification(IO::Path("progs/armor.mdl"), 2, 0), m_entity->modelSpecification());
+
+            m_entity->addOrUpdateAttribute("model", "progs/player.mdl");
+            ASSERT_EQ(Assets::ModelSpecification(IO::Path("progs/player.mdl"), 2, 0), m_entity->modelSpecification());
+
+            m_entity->removeAttribute("skin");
+            ASSERT_EQ(Assets::ModelSpecification(IO::Path("progs/player.mdl"), 0, 0), m_entity->modelSpecification());
+
+            m_entity->setDefinition(nullptr);
+            ASSERT_EQ(Assets::ModelSpecification(), m_entity->modelSpecification());
+        }
     }
 }
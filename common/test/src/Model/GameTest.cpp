@@ -119,6 +119,8 @@ namespace TrenchBroom {
 
             auto textureManager = Assets::TextureManager(0, 0, logger);
             game.loadTextureCollections(worldspawn, IO::Path(), textureManager, logger);
+            textureManager.waitForPendingLoads();
+            textureManager.commitLoadedCollections();
 
             ASSERT_EQ(2u, textureManager.collections().size());
 
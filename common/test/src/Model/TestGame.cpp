@@ -21,6 +21,7 @@
 
 #include "Assets/EntityDefinitionFileSpec.h"
 #include "Assets/EntityModel.h"
+#include "Assets/TextureManager.h"
 #include "IO/BrushFaceReader.h"
 #include "IO/DiskFileSystem.h"
 #include "IO/DiskIO.h"
@@ -104,6 +105,17 @@ namespace TrenchBroom {
             writer.writeMap();
         }
 
+        std::string TestGame::doWriteMapToString(WorldNode& world) const {
+            const auto mapFormatName = formatName(world.format());
+
+            std::string result;
+            IO::writeGameComment(result, gameName(), mapFormatName);
+
+            IO::NodeWriter writer(world, result);
+            writer.writeMap();
+            return result;
+        }
+
         void TestGame::doExportMap(WorldNode& /* world */, const Model::ExportFormat /* format */, const IO::Path& /* path */) const {}
 
         std::vector<Node*> TestGame::doParseNodes(const std::string& str, WorldNode& world, const vm::bbox3& worldBounds, Logger& /* logger */) const {
@@ -148,8 +160,11 @@ namespace TrenchBroom {
                     IO::Path(),
                     {});
 
-            IO::TextureLoader textureLoader(fileSystem, fileSearchPaths, textureConfig, logger);
-            textureLoader.loadTextures(paths, textureManager);
+            // the file system doesn't outlive this function, so wait for the collections to be decoded
+            auto textureLoader = std::make_unique<IO::TextureLoader>(fileSystem, fileSearchPaths, textureConfig, logger);
+            textureManager.setTextureCollections(paths, std::move(textureLoader));
+            textureManager.waitForPendingLoads();
+            textureManager.commitLoadedCollections();
         }
 
         bool TestGame::doIsTextureCollection(const IO::Path& /* path */) const {
@@ -22,8 +22,11 @@
 #include "GTestCompat.h"
 
 #include "Renderer/Camera.h"
+#include "Renderer/OrthographicCamera.h"
 #include "Renderer/PerspectiveCamera.h"
 
+#include <vecmath/bbox.h>
+
 namespace TrenchBroom {
     namespace Renderer {
         TEST_CASE("CameraTest.testInvalidUp", "[CameraTest]") {
@@ -67,5 +70,35 @@ namespace TrenchBroom {
             ASSERT_FALSE(vm::is_nan(c.right()));
             ASSERT_FALSE(vm::is_nan(c.up()));
         }
+
+        TEST_CASE("CameraTest.perspectiveIntersectsFrustum", "[CameraTest]") {
+            const auto viewport = Camera::Viewport(0, 0, 800, 600);
+            const PerspectiveCamera c(90.0f, 1.0f, 8000.0f, viewport, vm::vec3f::zero(), vm::vec3f::pos_x(), vm::vec3f::pos_z());
+
+            CHECK(c.intersectsFrustum(vm::bbox3f(vm::vec3f(100, -10, -10), vm::vec3f(120, 10, 10))));
+            CHECK(c.intersectsFrustum(vm::bbox3f(vm::vec3f(-10, -10, -10), vm::vec3f(10, 10, 10))));
+
+            // behind the camera
+            CHECK_FALSE(c.intersectsFrustum(vm::bbox3f(vm::vec3f(-120, -10, -10), vm::vec3f(-100, 10, 10))));
+            // to the left, right, above and below
+            CHECK_FALSE(c.intersectsFrustum(vm::bbox3f(vm::vec3f(100, 1000, -10), vm::vec3f(120, 1020, 10))));
+            CHECK_FALSE(c.intersectsFrustum(vm::bbox3f(vm::vec3f(100, -1020, -10), vm::vec3f(120, -1000, 10))));
+            CHECK_FALSE(c.intersectsFrustum(vm::bbox3f(vm::vec3f(100, -10, 1000), vm::vec3f(120, 10, 1020))));
+            CHECK_FALSE(c.intersectsFrustum(vm::bbox3f(vm::vec3f(100, -10, -1020), vm::vec3f(120, 10, -1000))));
+
+            // partially inside
+            CHECK(c.intersectsFrustum(vm::bbox3f(vm::vec3f(100, -10, -10), vm::vec3f(120, 1000, 10))));
+        }
+
+        TEST_CASE("CameraTest.orthographicIntersectsFrustum", "[CameraTest]") {
+            const auto viewport = Camera::Viewport(0, 0, 800, 600);
+            const OrthographicCamera c(1.0f, 8000.0f, viewport, vm::vec3f(0, 0, 1000), vm::vec3f::neg_z(), vm::vec3f::pos_y());
+
+            CHECK(c.intersectsFrustum(vm::bbox3f(vm::vec3f(-10, -10, -10), vm::vec3f(10, 10, 10))));
+            CHECK(c.intersectsFrustum(vm::bbox3f(vm::vec3f(390, 290, -10), vm::vec3f(410, 310, 10))));
+
+            CHECK_FALSE(c.intersectsFrustum(vm::bbox3f(vm::vec3f(410, -10, -10), vm::vec3f(420, 10, 10))));
+            CHECK_FALSE(c.intersectsFrustum(vm::bbox3f(vm::vec3f(-10, -320, -10), vm::vec3f(10, -310, 10))));
+        }
     }
 }
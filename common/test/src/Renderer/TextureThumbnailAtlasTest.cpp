@@ -0,0 +1,56 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include "GTestCompat.h"
+
+#include "Renderer/TextureThumbnailAtlas.h"
+
+#include <vecmath/vec.h>
+#include <vecmath/vec_io.h>
+
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        TEST_CASE("TextureThumbnailAtlasTest.thumbnailSize", "[TextureThumbnailAtlasTest]") {
+            ASSERT_EQ(vm::vec2s(64, 32), thumbnailSize(64, 32, 128));
+            ASSERT_EQ(vm::vec2s(128, 128), thumbnailSize(128, 128, 128));
+            ASSERT_EQ(vm::vec2s(128, 64), thumbnailSize(256, 128, 128));
+            ASSERT_EQ(vm::vec2s(32, 128), thumbnailSize(64, 256, 128));
+            ASSERT_EQ(vm::vec2s(1, 128), thumbnailSize(2, 1024, 128));
+        }
+
+        TEST_CASE("TextureThumbnailAtlasTest.downscaleRGBAImage", "[TextureThumbnailAtlasTest]") {
+            // 4x2 image, every 2x2 block has a uniform average
+            const std::vector<unsigned char> source{
+                 0,  0,  0, 255,    20, 40, 60, 255,    100, 100, 100, 0,    100, 100, 100, 0,
+                20, 40, 60, 255,     0,  0,  0, 255,    100, 100, 100, 0,    100, 100, 100, 0,
+            };
+
+            const std::vector<unsigned char> expected{
+                10, 20, 30, 255,    100, 100, 100, 0,
+            };
+
+            ASSERT_EQ(expected, downscaleRGBAImage(source, 4, 2, 2, 1));
+            ASSERT_EQ(source, downscaleRGBAImage(source, 4, 2, 4, 2));
+        }
+    }
+}
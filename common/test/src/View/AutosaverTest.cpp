@@ -61,6 +61,7 @@ namespace TrenchBroom {
             document->addNode(createBrushNode("some_texture"), document->currentLayer());
 
             autosaver.triggerAutosave(logger);
+            autosaver.finishAutosave();
 
             ASSERT_FALSE(env.fileExists(IO::Path("autosave/test.1.map")));
             ASSERT_FALSE(env.directoryExists(IO::Path("autosave")));
@@ -77,6 +78,7 @@ namespace TrenchBroom {
 
             Autosaver autosaver(document, 0s);
             autosaver.triggerAutosave(logger);
+            autosaver.finishAutosave();
 
             ASSERT_FALSE(env.fileExists(IO::Path("autosave/test.1.map")));
             ASSERT_FALSE(env.directoryExists(IO::Path("autosave")));
@@ -101,6 +103,7 @@ namespace TrenchBroom {
             std::this_thread::sleep_for(100ms);
 
             autosaver.triggerAutosave(logger);
+            autosaver.finishAutosave();
 
             ASSERT_TRUE(env.fileExists(IO::Path("autosave/test.1.map")));
             ASSERT_TRUE(env.directoryExists(IO::Path("autosave")));
@@ -125,6 +128,7 @@ namespace TrenchBroom {
             std::this_thread::sleep_for(100ms);
 
             autosaver.triggerAutosave(logger);
+            autosaver.finishAutosave();
 
             ASSERT_TRUE(env.fileExists(IO::Path("autosave/test.1.map")));
             ASSERT_TRUE(env.directoryExists(IO::Path("autosave")));
@@ -134,12 +138,14 @@ namespace TrenchBroom {
             std::this_thread::sleep_for(100ms);
 
             autosaver.triggerAutosave(logger);
+            autosaver.finishAutosave();
             ASSERT_FALSE(env.fileExists(IO::Path("autosave/test.2.map")));
 
             // modify the map
             document->addNode(createBrushNode("some_texture"), document->currentLayer());
 
             autosaver.triggerAutosave(logger);
+            autosaver.finishAutosave();
             ASSERT_TRUE(env.fileExists(IO::Path("autosave/test.2.map")));
         }
 
@@ -165,8 +171,37 @@ namespace TrenchBroom {
             document->addNode(createBrushNode("some_texture"), document->currentLayer());
 
             autosaver.triggerAutosave(logger);
+            autosaver.finishAutosave();
 
             ASSERT_TRUE(env.fileExists(IO::Path("autosave/test.2.map")));
         }
+
+        TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverIgnoresChangesDuringSave") {
+            using namespace std::literals::chrono_literals;
+
+            IO::TestEnvironment env("autosaver_test");
+            NullLogger logger;
+
+            document->saveDocumentAs(env.dir() + IO::Path("test.map"));
+            assert(env.fileExists(IO::Path("test.map")));
+
+            Autosaver autosaver(document, 0s);
+
+            // modify the map
+            document->addNode(createBrushNode("some_texture"), document->currentLayer());
+
+            autosaver.triggerAutosave(logger);
+
+            // modify the map while the backup is being written
+            document->addNode(createBrushNode("some_other_texture"), document->currentLayer());
+
+            autosaver.finishAutosave();
+
+            ASSERT_TRUE(env.fileExists(IO::Path("autosave/test.1.map")));
+
+            const auto content = env.loadFile(IO::Path("autosave/test.1.map"));
+            ASSERT_NE(std::string::npos, content.find("some_texture"));
+            ASSERT_EQ(std::string::npos, content.find("some_other_texture"));
+        }
     }
 }
@@ -25,6 +25,7 @@
 #include "View/UndoableCommand.h"
 #include "View/CommandProcessor.h"
 
+#include <kdl/string_utils.h>
 #include <kdl/vector_utils.h>
 
 #include <chrono>
@@ -109,6 +110,8 @@ namespace TrenchBroom {
         class TestCommand : public UndoableCommand {
         private:
             bool m_isRepeatDelimiter;
+            size_t m_memorySize;
+            size_t m_compressedMemorySize;
 
             mutable std::vector<TestCommandCall> m_expectedCalls;
         public:
@@ -120,7 +123,9 @@ namespace TrenchBroom {
 
             explicit TestCommand(const std::string& name, const bool isRepeatDelimiter) :
             UndoableCommand(Type, name),
-            m_isRepeatDelimiter(isRepeatDelimiter) {}
+            m_isRepeatDelimiter(isRepeatDelimiter),
+            m_memorySize(0u),
+            m_compressedMemorySize(0u) {}
 
             ~TestCommand() {
                 ASSERT_TRUE(m_expectedCalls.empty());
@@ -171,6 +176,14 @@ namespace TrenchBroom {
                 return expectedCall.returnCanCollate;
             }
 
+            size_t doGetMemorySize() const override {
+                return m_memorySize;
+            }
+
+            void doCompressSnapshots() override {
+                m_memorySize = m_compressedMemorySize;
+            }
+
         public:
             /**
              * Sets an expectation that doPerformDo() should be called.
@@ -215,6 +228,20 @@ namespace TrenchBroom {
                 }
             }
 
+            /**
+             * Sets the memory size that doGetMemorySize() should report.
+             */
+            void setMemorySize(const size_t memorySize) {
+                m_memorySize = memorySize;
+            }
+
+            /**
+             * Sets the memory size that doGetMemorySize() should report once doCompressSnapshots() was called.
+             */
+            void setCompressedMemorySize(const size_t compressedMemorySize) {
+                m_compressedMemorySize = compressedMemorySize;
+            }
+
             deleteCopyAndMove(TestCommand)
         };
 
@@ -833,5 +860,88 @@ namespace TrenchBroom {
             ASSERT_EQ(commandName1, commandProcessor.undoCommandName());
             ASSERT_EQ(commandName2, commandProcessor.redoCommandName());
         }
+
+        TEST_CASE("CommandProcessorTest.undoMemoryBudget", "[CommandProcessorTest]") {
+            /*
+             * Execute three commands that exceed the undo memory budget, so that the oldest one is discarded. Then,
+             * shrink the budget below the size of a single command, which must keep the most recent command.
+             */
+
+            CommandProcessor commandProcessor(nullptr);
+            commandProcessor.setUndoMemoryBudget(250u);
+
+            const auto commandName1 = "test command 1";
+            auto command1 = TestCommand::create(commandName1, false);
+            command1->setMemorySize(100u);
+
+            const auto commandName2 = "test command 2";
+            auto command2 = TestCommand::create(commandName2, false);
+            command2->setMemorySize(100u);
+
+            const auto commandName3 = "test command 3";
+            auto command3 = TestCommand::create(commandName3, false);
+            command3->setMemorySize(100u);
+
+            command1->expectDo(true);
+            command1->expectCollate(command2.get(), false);
+            command2->expectDo(true);
+            command2->expectCollate(command3.get(), false);
+            command3->expectDo(true);
+            command3->expectUndo(true);
+
+            commandProcessor.executeAndStore(std::move(command1));
+            commandProcessor.executeAndStore(std::move(command2));
+            ASSERT_EQ(200u, commandProcessor.undoMemoryUsage());
+
+            commandProcessor.executeAndStore(std::move(command3));
+            ASSERT_EQ(200u, commandProcessor.undoMemoryUsage());
+            ASSERT_EQ(commandName3, commandProcessor.undoCommandName());
+
+            commandProcessor.setUndoMemoryBudget(50u);
+            ASSERT_EQ(100u, commandProcessor.undoMemoryUsage());
+            ASSERT_TRUE(commandProcessor.canUndo());
+            ASSERT_TRUE(commandProcessor.canRepeat());
+
+            // the undone command is now counted on the redo stack
+            ASSERT_TRUE(commandProcessor.undo()->success());
+            ASSERT_EQ(100u, commandProcessor.undoMemoryUsage());
+            ASSERT_FALSE(commandProcessor.canUndo());
+            ASSERT_TRUE(commandProcessor.canRedo());
+        }
+
+        TEST_CASE("CommandProcessorTest.compressOlderCommands", "[CommandProcessorTest]") {
+            /*
+             * Execute ten commands. Only the commands that fall behind the eight most recent ones are compressed, and
+             * their memory size is measured again. The undo memory budget is unlimited by default.
+             */
+
+            CommandProcessor commandProcessor(nullptr);
+            ASSERT_EQ(0u, commandProcessor.undoMemoryBudget());
+
+            std::vector<std::unique_ptr<TestCommand>> commands;
+            for (size_t i = 0u; i < 10u; ++i) {
+                auto& command = commands.emplace_back(TestCommand::create(kdl::str_to_string("test command ", i), false));
+                command->setMemorySize(100u);
+                command->setCompressedMemorySize(10u);
+            }
+
+            for (size_t i = 0u; i < commands.size(); ++i) {
+                commands[i]->expectDo(true);
+                if (i + 1u < commands.size()) {
+                    commands[i]->expectCollate(commands[i + 1u].get(), false);
+                }
+            }
+
+            for (size_t i = 0u; i < 8u; ++i) {
+                commandProcessor.executeAndStore(std::move(commands[i]));
+            }
+            ASSERT_EQ(800u, commandProcessor.undoMemoryUsage());
+
+            commandProcessor.executeAndStore(std::move(commands[8]));
+            ASSERT_EQ(810u, commandProcessor.undoMemoryUsage());
+
+            commandProcessor.executeAndStore(std::move(commands[9]));
+            ASSERT_EQ(820u, commandProcessor.undoMemoryUsage());
+        }
     }
 }
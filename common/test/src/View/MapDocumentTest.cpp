@@ -27,6 +27,7 @@
 #include "Model/BrushFaceHandle.h"
 #include "Model/BrushNode.h"
 #include "Model/CollectMatchingIssuesVisitor.h"
+#include "Model/CollectNodesVisitor.h"
 #include "Model/EmptyAttributeNameIssueGenerator.h"
 #include "Model/EmptyAttributeValueIssueGenerator.h"
 #include "Model/EntityNode.h"
@@ -1117,6 +1118,56 @@ namespace TrenchBroom {
             kdl::vec_clear_and_delete(issueGenerators);
         }
 
+        TEST_CASE_METHOD(MapDocumentTest, "IssueGenerator.validateIssues") {
+            std::vector<Model::EntityNode*> entities;
+            for (size_t i = 0u; i < 100u; ++i) {
+                Model::EntityNode* entity = document->createPointEntity(m_pointEntityDef, vm::vec3::zero());
+                entity->addOrUpdateAttribute("", "");
+                entities.push_back(entity);
+            }
+
+            auto issueGenerators = std::vector<Model::IssueGenerator*>{
+                new Model::EmptyAttributeNameIssueGenerator(),
+                new Model::EmptyAttributeValueIssueGenerator()
+            };
+
+            Model::CollectNodesVisitor collectNodes;
+            document->world()->acceptAndRecurse(collectNodes);
+            const std::vector<Model::Node*>& nodes = collectNodes.nodes();
+
+            Model::Node::validateIssues(nodes, issueGenerators);
+
+            size_t lastSeqId = 0u;
+            for (size_t i = 0u; i < entities.size(); ++i) {
+                Model::EntityNode* entity = entities[i];
+                CHECK(entity->issuesValid());
+
+                const std::vector<Model::Issue*>& issues = entity->issues(issueGenerators);
+                REQUIRE(2u == issues.size());
+
+                // the issues are ordered by generator, and their sequence ids follow the order of the nodes
+                CHECK(issues[0]->type() == issueGenerators[0]->type());
+                CHECK(issues[1]->type() == issueGenerators[1]->type());
+                if (i > 0u) {
+                    CHECK(issues[0]->seqId() > lastSeqId);
+                }
+                CHECK(issues[1]->seqId() > issues[0]->seqId());
+                lastSeqId = issues[1]->seqId();
+            }
+
+            // validating again doesn't regenerate valid issues
+            const std::vector<Model::Issue*> oldIssues = entities.front()->issues(issueGenerators);
+            entities.back()->addOrUpdateAttribute("", "x");
+            CHECK(!entities.back()->issuesValid());
+
+            Model::Node::validateIssues(nodes, issueGenerators);
+            CHECK(entities.front()->issues(issueGenerators) == oldIssues);
+            CHECK(entities.back()->issuesValid());
+            CHECK(1u == entities.back()->issues(issueGenerators).size());
+
+            kdl::vec_clear_and_delete(issueGenerators);
+        }
+
         TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.defaultLayerSortIndexImmutable", "[LayerTest]") {
             Model::LayerNode* defaultLayer = document->world()->defaultLayer();
 
@@ -1454,5 +1505,31 @@ namespace TrenchBroom {
             document->redoCommand();
             CHECK(document->currentLayer() == layer2);
         }
+
+        TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.moveVerticesOfManyBrushes") {
+            // enough brushes to move their vertices in parallel
+            std::vector<Model::BrushNode*> brushNodes;
+            for (size_t i = 0; i < 32u; ++i) {
+                auto* brushNode = createBrushNode();
+                document->addNode(brushNode, document->parentForNodes());
+                brushNodes.push_back(brushNode);
+            }
+            document->select(kdl::vec_element_cast<Model::Node*>(brushNodes));
+
+            const auto verticesToMove = std::map<vm::vec3, std::vector<Model::BrushNode*>>{ { vm::vec3::fill(16.0), brushNodes } };
+            const auto result = document->moveVertices(verticesToMove, vm::vec3::fill(1.0));
+            REQUIRE(result.success);
+            REQUIRE(result.hasRemainingVertices);
+
+            for (const auto* brushNode : brushNodes) {
+                CHECK(brushNode->brush().hasVertex(vm::vec3::fill(17.0)));
+                CHECK_FALSE(brushNode->brush().hasVertex(vm::vec3::fill(16.0)));
+            }
+
+            document->undoCommand();
+            for (const auto* brushNode : brushNodes) {
+                CHECK(brushNode->brush().hasVertex(vm::vec3::fill(16.0)));
+            }
+        }
     }
 }
@@ -24,17 +24,20 @@
 #include "Assets/Texture.h"
 #include "Assets/TextureCollection.h"
 #include "Assets/TextureManager.h"
+#include "Model/Brush.h"
 #include "Model/BrushNode.h"
 #include "Model/BrushFace.h"
 #include "Model/ChangeBrushFaceAttributesRequest.h"
 #include "Model/EntityNode.h"
 #include "Model/GroupNode.h"
 #include "Model/LayerNode.h"
+#include "Model/Snapshot.h"
 #include "Model/WorldNode.h"
 #include "View/MapDocumentTest.h"
 #include "View/MapDocument.h"
 
 #include <cassert>
+#include <vector>
 
 namespace TrenchBroom {
     namespace View {
@@ -86,6 +89,52 @@ namespace TrenchBroom {
             }
         }
 
+        TEST_CASE_METHOD(SnapshotTest, "SnapshotTest.restoreSharedGeometry", "[SnapshotTest]") {
+            Model::BrushNode* brushNode = createBrushNode();
+            document->addNode(brushNode, document->parentForNodes());
+            document->select(brushNode);
+
+            const auto originalBounds = brushNode->bounds();
+            const auto* originalGeometry = brushNode->brush().face(0).geometry();
+
+            document->translateObjects(vm::vec3(1, 1, 1));
+            CHECK(brushNode->bounds() == vm::bbox3(originalBounds.min + vm::vec3(1, 1, 1), originalBounds.max + vm::vec3(1, 1, 1)));
+            CHECK(brushNode->brush().face(0).geometry() != originalGeometry);
+
+            // the snapshot shares the original geometry, so restoring it does not rebuild it
+            document->undoCommand();
+            CHECK(brushNode->bounds() == originalBounds);
+            CHECK(brushNode->brush().face(0).geometry() == originalGeometry);
+        }
+
+        TEST_CASE_METHOD(SnapshotTest, "SnapshotTest.restoreCompressedSnapshot", "[SnapshotTest]") {
+            Model::BrushNode* brushNode = createBrushNode();
+            document->addNode(brushNode, document->parentForNodes());
+
+            auto* entity = new Model::EntityNode();
+            entity->addOrUpdateAttribute(Model::AttributeNames::Classname, "test");
+            entity->addOrUpdateAttribute("message", "some message");
+            document->addNode(entity, document->parentForNodes());
+
+            const auto originalBrush = brushNode->brush();
+
+            const auto nodes = std::vector<Model::Node*>{ brushNode, entity };
+            Model::Snapshot snapshot(std::begin(nodes), std::end(nodes));
+            snapshot.compress();
+
+            document->select(brushNode);
+            document->translateObjects(vm::vec3(1, 1, 1));
+            document->deselectAll();
+            entity->addOrUpdateAttribute("message", "another message");
+
+            // the brush is rebuilt from the compressed faces, which must not lose any precision
+            REQUIRE(snapshot.restoreNodes(document->worldBounds()).is_success());
+            CHECK(brushNode->brush().faces() == originalBrush.faces());
+            CHECK(brushNode->bounds() == originalBrush.bounds());
+            CHECK(entity->attribute("classname") == std::string("test"));
+            CHECK(entity->attribute("message") == std::string("some message"));
+        }
+
         TEST_CASE_METHOD(SnapshotTest, "SnapshotTest.undoRotation", "[SnapshotTest]") {
             auto* entity = new Model::EntityNode();
             entity->addOrUpdateAttribute(Model::AttributeNames::Classname, "test");
@@ -579,6 +579,43 @@ namespace TrenchBroom {
             }
         }
 
+        TEST_CASE_METHOD(TagManagementTest, "TagManagementTest.tagUpdateBrushFaceTagsAfterChangingTexture") {
+            auto* brushNode = createBrushNode("some_texture");
+            document->addNode(brushNode, document->parentForNodes());
+
+            const auto& textureTag = document->smartTag("texture");
+            const auto& texturePatternTag = document->smartTag("texturePattern");
+            const auto& surfaceParmTag = document->smartTag("surfaceparm_multi");
+
+            for (const auto& face : brushNode->brush().faces()) {
+                CHECK(face.hasTag(textureTag));
+                CHECK(!face.hasTag(texturePatternTag));
+                CHECK(face.hasTag(surfaceParmTag));
+            }
+
+            Model::ChangeBrushFaceAttributesRequest request;
+            request.setTextureName("yet_another_texture");
+
+            document->select(brushNode);
+            document->setFaceAttributes(request);
+            document->deselectAll();
+
+            // the texture based tags are now taken from the match results cached for the new texture
+            for (const auto& face : brushNode->brush().faces()) {
+                CHECK(!face.hasTag(textureTag));
+                CHECK(face.hasTag(texturePatternTag));
+                CHECK(!face.hasTag(surfaceParmTag));
+            }
+
+            document->undoCommand();
+
+            for (const auto& face : brushNode->brush().faces()) {
+                CHECK(face.hasTag(textureTag));
+                CHECK(!face.hasTag(texturePatternTag));
+                CHECK(face.hasTag(surfaceParmTag));
+            }
+        }
+
         TEST_CASE_METHOD(TagManagementTest, "TagManagementTest.tagUpdateBrushFaceTags") {
             auto* brushNode = createBrushNode("asdf");
             document->addNode(brushNode, document->parentForNodes());
@@ -0,0 +1,143 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include "GTestCompat.h"
+
+#include "MapDocumentTest.h"
+
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushNode.h"
+#include "Model/Game.h"
+#include "Model/Hit.h"
+#include "Model/PickResult.h"
+#include "Model/WorldNode.h"
+#include "Renderer/PerspectiveCamera.h"
+#include "View/VertexHandleManager.h"
+
+#include <kdl/vector_utils.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/ray.h>
+#include <vecmath/segment.h>
+#include <vecmath/vec.h>
+
+#include <vector>
+
+namespace TrenchBroom {
+    namespace View {
+        class VertexHandleManagerTest : public MapDocumentTest {
+        protected:
+            Model::BrushNode* createCuboidNode(const vm::bbox3& bounds) {
+                Model::BrushBuilder builder(document->world(), document->worldBounds(), document->game()->defaultFaceAttribs());
+                return document->world()->createBrush(builder.createCuboid(bounds, "texture").value());
+            }
+        };
+
+        static std::vector<vm::vec3> pickVertexHandles(const VertexHandleManager& manager, const Renderer::Camera& camera, const vm::vec3& target, const Model::EditorContext& editorContext) {
+            const auto pickRay = vm::ray3(vm::vec3(camera.position()), vm::normalize(target - vm::vec3(camera.position())));
+
+            auto pickResult = Model::PickResult::byDistance(editorContext);
+            manager.pick(pickRay, camera, pickResult);
+
+            std::vector<vm::vec3> result;
+            for (const auto& hit : pickResult.all()) {
+                result.push_back(hit.target<vm::vec3>());
+            }
+            return result;
+        }
+
+        TEST_CASE_METHOD(VertexHandleManagerTest, "VertexHandleManagerTest.findIncidentBrushes") {
+            auto* brush1 = createCuboidNode(vm::bbox3(vm::vec3(-16, -16, -16), vm::vec3(16, 16, 16)));
+            auto* brush2 = createCuboidNode(vm::bbox3(vm::vec3( 16, -16, -16), vm::vec3(48, 16, 16)));
+            const auto brushes = std::vector<Model::BrushNode*>{ brush1, brush2 };
+
+            VertexHandleManager manager;
+            manager.addHandles(std::begin(brushes), std::end(brushes));
+            CHECK(manager.totalHandleCount() == 12u);
+
+            CHECK_THAT(manager.findIncidentBrushes(vm::vec3(16, 16, 16), std::begin(brushes), std::end(brushes)), Catch::UnorderedEquals(brushes));
+            CHECK_THAT(manager.findIncidentBrushes(vm::vec3(-16, 16, 16), std::begin(brushes), std::end(brushes)), Catch::Equals(std::vector<Model::BrushNode*>{ brush1 }));
+            CHECK_THAT(manager.findIncidentBrushes(vm::vec3(48, 16, 16), std::begin(brushes), std::end(brushes)), Catch::Equals(std::vector<Model::BrushNode*>{ brush2 }));
+            CHECK(manager.findIncidentBrushes(vm::vec3(0, 0, 0), std::begin(brushes), std::end(brushes)).empty());
+
+            const auto handles = std::vector<vm::vec3>{ vm::vec3(-16, 16, 16), vm::vec3(48, 16, 16) };
+            CHECK_THAT(manager.findIncidentBrushes(std::begin(handles), std::end(handles), std::begin(brushes), std::end(brushes)), Catch::UnorderedEquals(brushes));
+
+            manager.removeHandles(brush2);
+            CHECK(manager.totalHandleCount() == 8u);
+            CHECK_THAT(manager.findIncidentBrushes(vm::vec3(16, 16, 16), std::begin(brushes), std::end(brushes)), Catch::Equals(std::vector<Model::BrushNode*>{ brush1 }));
+
+            delete brush1;
+            delete brush2;
+        }
+
+        TEST_CASE_METHOD(VertexHandleManagerTest, "VertexHandleManagerTest.pickAfterUpdates") {
+            auto* brush1 = createCuboidNode(vm::bbox3(vm::vec3(-16, -16, -16), vm::vec3(16, 16, 16)));
+            auto* brush2 = createCuboidNode(vm::bbox3(vm::vec3( 16, -16, -16), vm::vec3(48, 16, 16)));
+
+            const Renderer::Camera::Viewport viewport(0, 0, 1920, 1080);
+            Renderer::PerspectiveCamera camera(90.0f, 1.0f, 8000.0f, viewport, vm::vec3f(0.0f, -160.0f, 0.0f), vm::vec3f::pos_y(), vm::vec3f::pos_z());
+
+            VertexHandleManager manager;
+            manager.addHandles(brush1);
+
+            CHECK_THAT(pickVertexHandles(manager, camera, vm::vec3(-16, -16, 16), document->editorContext()), Catch::Contains(std::vector<vm::vec3>{ vm::vec3(-16, -16, 16) }));
+            CHECK(pickVertexHandles(manager, camera, vm::vec3(48, -16, 16), document->editorContext()).empty());
+
+            // the handles are indexed by now, so these must be added to and removed from the index
+            manager.addHandles(brush2);
+            CHECK_THAT(pickVertexHandles(manager, camera, vm::vec3(48, -16, 16), document->editorContext()), Catch::Contains(std::vector<vm::vec3>{ vm::vec3(48, -16, 16) }));
+
+            manager.select(vm::vec3(48, -16, 16.0000001));
+            CHECK(manager.selected(vm::vec3(48, -16, 16)));
+
+            manager.removeHandles(brush2);
+            CHECK(manager.selectedHandleCount() == 0u);
+            CHECK(pickVertexHandles(manager, camera, vm::vec3(48, -16, 16), document->editorContext()).empty());
+            CHECK_THAT(pickVertexHandles(manager, camera, vm::vec3(16, -16, 16), document->editorContext()), Catch::Contains(std::vector<vm::vec3>{ vm::vec3(16, -16, 16) }));
+
+            delete brush1;
+            delete brush2;
+        }
+
+        TEST_CASE_METHOD(VertexHandleManagerTest, "VertexHandleManagerTest.pickEdgeCenterHandles") {
+            auto* brush = createCuboidNode(vm::bbox3(vm::vec3(-16, -16, -16), vm::vec3(16, 16, 16)));
+
+            const Renderer::Camera::Viewport viewport(0, 0, 1920, 1080);
+            Renderer::PerspectiveCamera camera(90.0f, 1.0f, 8000.0f, viewport, vm::vec3f(0.0f, -160.0f, 0.0f), vm::vec3f::pos_y(), vm::vec3f::pos_z());
+
+            EdgeHandleManager manager;
+            manager.addHandles(brush);
+
+            const auto center = vm::vec3(0, -16, 16);
+            const auto pickRay = vm::ray3(vm::vec3(camera.position()), vm::normalize(center - vm::vec3(camera.position())));
+            auto pickResult = Model::PickResult::byDistance(document->editorContext());
+            manager.pickCenterHandle(pickRay, camera, pickResult);
+
+            ASSERT_EQ(1u, pickResult.size());
+            const auto edge = pickResult.all().front().target<vm::segment3>();
+            CHECK(edge.center() == center);
+
+            delete brush;
+        }
+    }
+}
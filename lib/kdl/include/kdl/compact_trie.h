@@ -505,6 +505,71 @@ namespace kdl {
                 }
             }
 
+            /**
+             * Adds the values of the node in this node's subtree whose key is equal to the given key to the given
+             * output iterator. Unlike `find_matches`, this does not require any auxiliary state and therefore does not
+             * allocate any memory.
+             *
+             * @tparam O the type of the given output iterator
+             * @param key the key to find, relative to this node
+             * @param out the output iterator to which the values of the matched node are added
+             */
+            template <typename O>
+            void find_exact(std::string_view key, O out) const {
+                const node* n = this;
+                while (true) {
+                    const std::size_t mismatch = kdl::cs::str_mismatch(key, n->m_key);
+                    if (mismatch < n->m_key.length()) {
+                        // the key diverges from or ends within this node's key
+                        return;
+                    }
+
+                    key = key.substr(mismatch);
+                    if (key.empty()) {
+                        n->get_values(out);
+                        return;
+                    }
+
+                    const auto it = n->m_children.find(key);
+                    if (it == std::end(n->m_children)) {
+                        return;
+                    }
+                    n = &*it;
+                }
+            }
+
+            /**
+             * Adds the values of every node in this node's subtree whose key has the given prefix to the given output
+             * iterator. Like `find_exact`, this does not allocate any memory.
+             *
+             * @tparam O the type of the given output iterator
+             * @param prefix the prefix to find, relative to this node
+             * @param out the output iterator to which the values of the matched nodes are added
+             */
+            template <typename O>
+            void find_prefix(std::string_view prefix, O out) const {
+                const node* n = this;
+                while (true) {
+                    const std::size_t mismatch = kdl::cs::str_mismatch(prefix, n->m_key);
+                    if (mismatch == prefix.length()) {
+                        // the prefix is consumed, so every key in this subtree matches
+                        n->get_values_and_recurse(out);
+                        return;
+                    }
+
+                    if (mismatch < n->m_key.length()) {
+                        return;
+                    }
+
+                    prefix = prefix.substr(mismatch);
+                    const auto it = n->m_children.find(prefix);
+                    if (it == std::end(n->m_children)) {
+                        return;
+                    }
+                    n = &*it;
+                }
+            }
+
             /**
              * Adds the keys of all nodes in this subtree to the given output iterator.
              *
@@ -695,6 +760,32 @@ namespace kdl {
             m_root.find_matches(pattern, { 0u }, nullptr, match_state, out);
         }
 
+        /**
+         * Finds all values whose keys are equal to the given key and adds them to the given output iterator. This is
+         * equivalent to calling `find_matches` with a pattern that contains no wildcards, but it is cheaper.
+         *
+         * @tparam O the type of the output iterator
+         * @param key the key to find
+         * @param out the output iterator
+         */
+        template <typename O>
+        void find_exact(const std::string_view key, O out) const {
+            m_root.find_exact(key, out);
+        }
+
+        /**
+         * Finds all values whose keys start with the given prefix and adds them to the given output iterator. This is
+         * equivalent to calling `find_matches` with the given prefix followed by a '*' wildcard, but it is cheaper.
+         *
+         * @tparam O the type of the output iterator
+         * @param prefix the prefix to find
+         * @param out the output iterator
+         */
+        template <typename O>
+        void find_prefix(const std::string_view prefix, O out) const {
+            m_root.find_prefix(prefix, out);
+        }
+
         /**
          * Adds the keys of all nodes in this trie to the give output iterator.
          *
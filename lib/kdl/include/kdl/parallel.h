@@ -0,0 +1,123 @@
+/*
+ Copyright 2010-2019 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef KDL_PARALLEL_H
+#define KDL_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <future>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace kdl {
+    /**
+     * Returns the number of worker threads to use for parallel algorithms by default. This is the number of
+     * hardware threads, or 1 if that number cannot be determined.
+     */
+    inline std::size_t parallel_thread_count() {
+        return std::max(static_cast<std::size_t>(std::thread::hardware_concurrency()), std::size_t(1));
+    }
+
+    /**
+     * Calls the given lambda once for every index in [0, count). The calls are distributed over at most
+     * `num_threads` threads, including the calling thread, and the indices are handed out dynamically so that
+     * uneven workloads are balanced across the threads.
+     *
+     * The order in which the indices are processed is unspecified, so the given lambda must be safe to call
+     * concurrently for different indices. This function returns once every call has returned.
+     *
+     * If a call throws an exception, the thread that made the call stops processing indices, and once all threads
+     * have stopped, one of the thrown exceptions is rethrown on the calling thread. Other indices may not be
+     * processed in that case.
+     *
+     * @tparam L the type of the lambda, must be of type `void(std::size_t)`
+     * @param count the number of indices
+     * @param lambda the lambda to call
+     * @param num_threads the maximum number of threads to use
+     */
+    template <typename L>
+    void parallel_for(const std::size_t count, L&& lambda, const std::size_t num_threads = parallel_thread_count()) {
+        const auto thread_count = std::min(std::max(num_threads, std::size_t(1)), count);
+        if (thread_count <= 1u) {
+            for (std::size_t i = 0u; i < count; ++i) {
+                lambda(i);
+            }
+            return;
+        }
+
+        std::atomic<std::size_t> next_index(0u);
+        const auto worker = [&]() {
+            for (auto i = next_index++; i < count; i = next_index++) {
+                lambda(i);
+            }
+        };
+
+        std::vector<std::future<void>> futures;
+        futures.reserve(thread_count - 1u);
+        for (std::size_t i = 0u; i < thread_count - 1u; ++i) {
+            futures.push_back(std::async(std::launch::async, worker));
+        }
+
+        worker();
+
+        for (auto& future : futures) {
+            future.get();
+        }
+    }
+
+    /**
+     * Applies the given lambda to each element of the given vector in parallel and returns a vector containing
+     * the results, in the order in which their original elements appeared in v.
+     *
+     * The elements are passed to the given lambda as rvalue references, and the lambda must be safe to call
+     * concurrently for different elements. See parallel_for for details.
+     *
+     * @tparam T the type of the vector elements
+     * @tparam A the vector's allocator type
+     * @tparam L the type of the lambda to apply
+     * @param v the vector
+     * @param transform the lambda to apply, must be of type `auto(T&&)`
+     * @param num_threads the maximum number of threads to use
+     * @return a vector containing the transformed values
+     */
+    template<typename T, typename A, typename L,
+        typename std::enable_if_t<
+            std::is_invocable_v<L, T&&>
+        >* = nullptr>
+    auto vec_parallel_transform(std::vector<T, A> v, L&& transform, const std::size_t num_threads = parallel_thread_count()) {
+        using ResultType = decltype(transform(std::declval<T&&>()));
+
+        // the result type need not be default constructible, so we collect the results in optionals first
+        std::vector<std::optional<ResultType>> results(v.size());
+        parallel_for(v.size(), [&](const std::size_t i) {
+            results[i] = transform(std::move(v[i]));
+        }, num_threads);
+
+        std::vector<ResultType> result;
+        result.reserve(results.size());
+        for (auto& x : results) {
+            result.push_back(std::move(*x));
+        }
+
+        return result;
+    }
+}
+
+#endif //KDL_PARALLEL_H
@@ -23,6 +23,9 @@
 #include <algorithm> // for std::search
 #include <iterator>
 #include <cassert>
+#include <cerrno>
+#include <cstdlib>
+#include <limits>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -256,6 +259,64 @@ namespace kdl {
         }
     }
 
+    namespace detail {
+        inline bool is_space(const char c) {
+            return c == ' ' || (c >= '\t' && c <= '\r');
+        }
+
+        inline bool is_digit(const char c) {
+            return c >= '0' && c <= '9';
+        }
+    }
+
+    /**
+     * Interprets the given character range as a signed long integer and returns it. If the given range cannot be
+     * parsed, returns an empty optional.
+     *
+     * Behaves like the overload taking a string, but does not allocate any memory.
+     *
+     * @param begin the beginning of the range
+     * @param end the end of the range
+     * @return the signed long integer value or an empty optional if the given range cannot be interpreted as a signed
+     * long integer
+     */
+    inline std::optional<long> str_to_long(const char* begin, const char* end) {
+        auto* cur = begin;
+        while (cur != end && detail::is_space(*cur)) {
+            ++cur;
+        }
+
+        const auto negative = cur != end && *cur == '-';
+        if (cur != end && (*cur == '-' || *cur == '+')) {
+            ++cur;
+        }
+
+        if (cur == end || !detail::is_digit(*cur)) {
+            return std::nullopt;
+        }
+
+        const auto max = static_cast<unsigned long>(std::numeric_limits<long>::max());
+        const auto limit = negative ? max + 1ul : max;
+
+        auto value = 0ul;
+        while (cur != end && detail::is_digit(*cur)) {
+            const auto digit = static_cast<unsigned long>(*cur - '0');
+            if (value > (limit - digit) / 10ul) {
+                return std::nullopt;
+            }
+            value = value * 10ul + digit;
+            ++cur;
+        }
+
+        if (!negative) {
+            return static_cast<long>(value);
+        } else if (value == 0ul) {
+            return 0l;
+        } else {
+            return -static_cast<long>(value - 1ul) - 1l;
+        }
+    }
+
     /**
      * Interprets the given string as a signed long long integer and returns it. If the given string cannot be parsed,
      * returns an empty optional.
@@ -363,6 +424,123 @@ namespace kdl {
         }
     }
 
+    namespace detail {
+        /**
+         * Parses decimal numbers whose value can be computed exactly with a single floating point multiplication or
+         * division, which yields the same, correctly rounded result as strtod. This applies if the decimal mantissa
+         * fits into the 53 bits of a double's mantissa and the decimal exponent is at most 22 in magnitude, which is
+         * the case for almost all numbers in map files.
+         *
+         * Returns an empty optional if the given range is not such a number.
+         */
+        inline std::optional<double> str_to_double_exact(const char* begin, const char* end) {
+            static constexpr double powers_of_ten[] = {
+                1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+            };
+            constexpr auto max_exponent = 22;
+            constexpr auto max_mantissa = 1ull << 53;
+
+            auto* cur = begin;
+            const auto negative = cur != end && *cur == '-';
+            if (cur != end && (*cur == '-' || *cur == '+')) {
+                ++cur;
+            }
+
+            auto mantissa = 0ull;
+            auto exponent = 0;
+            auto has_digits = false;
+
+            for (; cur != end && is_digit(*cur); ++cur) {
+                mantissa = mantissa * 10ull + static_cast<unsigned long long>(*cur - '0');
+                if (mantissa > max_mantissa) {
+                    return std::nullopt;
+                }
+                has_digits = true;
+            }
+
+            if (cur != end && *cur == '.') {
+                for (++cur; cur != end && is_digit(*cur); ++cur) {
+                    mantissa = mantissa * 10ull + static_cast<unsigned long long>(*cur - '0');
+                    if (mantissa > max_mantissa) {
+                        return std::nullopt;
+                    }
+                    --exponent;
+                    has_digits = true;
+                }
+            }
+
+            if (!has_digits) {
+                return std::nullopt;
+            }
+
+            if (cur != end && (*cur == 'e' || *cur == 'E')) {
+                ++cur;
+                const auto negative_exponent = cur != end && *cur == '-';
+                if (cur != end && (*cur == '-' || *cur == '+')) {
+                    ++cur;
+                }
+                if (cur == end || !is_digit(*cur)) {
+                    return std::nullopt;
+                }
+
+                auto explicit_exponent = 0;
+                for (; cur != end && is_digit(*cur); ++cur) {
+                    explicit_exponent = explicit_exponent * 10 + (*cur - '0');
+                    if (explicit_exponent > 2 * max_exponent) {
+                        return std::nullopt;
+                    }
+                }
+                exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+            }
+
+            if (cur != end || exponent < -max_exponent || exponent > max_exponent) {
+                return std::nullopt;
+            }
+
+            const auto value = exponent < 0
+                ? static_cast<double>(mantissa) / powers_of_ten[-exponent]
+                : static_cast<double>(mantissa) * powers_of_ten[exponent];
+            return negative ? -value : value;
+        }
+    }
+
+    /**
+     * Interprets the given character range as a 64 bit floating point value and returns it. If the given range cannot
+     * be parsed, returns an empty optional.
+     *
+     * Behaves like the overload taking a string, but does not allocate any memory unless the range is very long.
+     * Simple decimal numbers are parsed directly, all others are passed to strtod.
+     *
+     * @param begin the beginning of the range
+     * @param end the end of the range
+     * @return the 64 bit floating point value or an empty optional if the given range cannot be interpreted as a 64
+     * bit floating point value
+     */
+    inline std::optional<double> str_to_double(const char* begin, const char* end) {
+        if (const auto result = detail::str_to_double_exact(begin, end)) {
+            return result;
+        }
+
+        constexpr auto buffer_size = std::size_t(64);
+        const auto length = static_cast<std::size_t>(end - begin);
+        if (length >= buffer_size) {
+            return str_to_double(std::string(begin, end));
+        }
+
+        char buffer[buffer_size];
+        std::copy(begin, end, buffer);
+        buffer[length] = '\0';
+
+        char* parse_end = nullptr;
+        errno = 0;
+        const auto value = std::strtod(buffer, &parse_end);
+        if (parse_end == buffer || errno == ERANGE) {
+            return std::nullopt;
+        }
+        return value;
+    }
+
     /**
      * Interprets the given string as a long double value value and returns it. If the given string cannot be parsed,
      * returns an empty optional.
@@ -182,6 +182,60 @@ namespace kdl {
         ASSERT_MATCHES(std::vector<std::string>({}), index, "k%*")
     }
 
+    TEST_CASE("compact_trie_test.find_exact", "[compact_trie_test]") {
+        test_index index;
+        index.insert("key", "value");
+        index.insert("key2", "value");
+        index.insert("key22", "value2");
+        index.insert("k1", "value3");
+        index.insert("k*", "value5");
+
+        const auto find_exact = [&](const std::string& key) {
+            std::vector<std::string> result;
+            index.find_exact(key, std::back_inserter(result));
+            vec_sort(result);
+            return result;
+        };
+
+        ASSERT_EQ(std::vector<std::string>({}), find_exact("whoops"));
+        ASSERT_EQ(std::vector<std::string>({}), find_exact("key222"));
+        ASSERT_EQ(std::vector<std::string>({}), find_exact("ke"));
+        ASSERT_EQ(std::vector<std::string>({}), find_exact("k"));
+        ASSERT_EQ(std::vector<std::string>({}), find_exact(""));
+        ASSERT_EQ(std::vector<std::string>({ "value" }), find_exact("key"));
+        ASSERT_EQ(std::vector<std::string>({ "value2" }), find_exact("key22"));
+        ASSERT_EQ(std::vector<std::string>({ "value3" }), find_exact("k1"));
+
+        // wildcards are not interpreted
+        ASSERT_EQ(std::vector<std::string>({ "value5" }), find_exact("k*"));
+
+        index.insert("key", "value4");
+        ASSERT_EQ(std::vector<std::string>({ "value", "value4" }), find_exact("key"));
+    }
+
+    TEST_CASE("compact_trie_test.find_prefix", "[compact_trie_test]") {
+        test_index index;
+        index.insert("key", "value");
+        index.insert("key2", "value");
+        index.insert("key22", "value2");
+        index.insert("k1", "value3");
+        index.insert("test", "value4");
+
+        const auto find_prefix = [&](const std::string& prefix) {
+            std::vector<std::string> result;
+            index.find_prefix(prefix, std::back_inserter(result));
+            vec_sort(result);
+            return result;
+        };
+
+        ASSERT_EQ(std::vector<std::string>({}), find_prefix("whoops"));
+        ASSERT_EQ(std::vector<std::string>({}), find_prefix("key222"));
+        ASSERT_EQ(std::vector<std::string>({ "value2" }), find_prefix("key22"));
+        ASSERT_EQ(std::vector<std::string>({ "value", "value", "value2" }), find_prefix("ke"));
+        ASSERT_EQ(std::vector<std::string>({ "value", "value", "value2", "value3" }), find_prefix("k"));
+        ASSERT_EQ(std::vector<std::string>({ "value", "value", "value2", "value3", "value4" }), find_prefix(""));
+    }
+
     TEST_CASE("compact_trie_test.get_keys", "[compact_trie_test]") {
         test_index index;
         index.insert("key", "value");
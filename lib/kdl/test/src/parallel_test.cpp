@@ -0,0 +1,83 @@
+/*
+ Copyright 2010-2019 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <catch2/catch.hpp>
+
+#include "GTestCompat.h"
+
+#include "kdl/parallel.h"
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace kdl {
+    TEST_CASE("parallel_test.parallel_for", "[parallel_test]") {
+        for (const std::size_t count : { 0u, 1u, 2u, 100u, 10000u }) {
+            for (const std::size_t num_threads : { 1u, 2u, 8u }) {
+                auto visited = std::vector<std::atomic<int>>(count);
+                parallel_for(count, [&](const std::size_t i) {
+                    visited[i]++;
+                }, num_threads);
+
+                for (const auto& v : visited) {
+                    ASSERT_EQ(1, v.load());
+                }
+            }
+        }
+    }
+
+    TEST_CASE("parallel_test.parallel_for_rethrows", "[parallel_test]") {
+        auto calls = std::atomic<std::size_t>(0u);
+        ASSERT_THROW(parallel_for(100u, [&](const std::size_t i) {
+            ++calls;
+            if (i == 50u) {
+                throw std::runtime_error("error");
+            }
+        }, 4u), std::runtime_error);
+        ASSERT_EQ(100u, calls.load());
+    }
+
+    TEST_CASE("parallel_test.vec_parallel_transform", "[parallel_test]") {
+        ASSERT_EQ(std::vector<int>({}), vec_parallel_transform(std::vector<int>({}), [](int&& x) { return x * 2; }));
+
+        auto input = std::vector<int>();
+        auto expected = std::vector<int>();
+        for (int i = 0; i < 1000; ++i) {
+            input.push_back(i);
+            expected.push_back(i * 2);
+        }
+        ASSERT_EQ(expected, vec_parallel_transform(input, [](int&& x) { return x * 2; }));
+    }
+
+    TEST_CASE("parallel_test.vec_parallel_transform_move_only", "[parallel_test]") {
+        auto input = std::vector<std::unique_ptr<int>>();
+        for (int i = 0; i < 100; ++i) {
+            input.push_back(std::make_unique<int>(i));
+        }
+
+        const auto result = vec_parallel_transform(std::move(input), [](std::unique_ptr<int>&& x) {
+            return std::make_unique<int>(*x + 1);
+        });
+
+        ASSERT_EQ(100u, result.size());
+        for (std::size_t i = 0u; i < result.size(); ++i) {
+            ASSERT_EQ(static_cast<int>(i) + 1, *result[i]);
+        }
+    }
+}
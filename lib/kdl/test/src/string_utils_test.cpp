@@ -21,8 +21,13 @@
 
 #include <kdl/string_utils.h>
 
+#include <cmath>
+#include <cstdlib>
+#include <limits>
 #include <optional>
 #include <ostream>
+#include <string>
+#include <vector>
 
 
 namespace kdl {
@@ -107,6 +112,31 @@ namespace kdl {
         ASSERT_EQ(std::nullopt, str_to_long(""));
     }
 
+    static std::optional<long> str_to_long_range(const std::string& str) {
+        return str_to_long(str.data(), str.data() + str.size());
+    }
+
+    TEST_CASE("string_format_test.str_to_long_range", "[string_format_test]") {
+        ASSERT_EQ(std::optional<long>{0l}, str_to_long_range("0"));
+        ASSERT_EQ(std::optional<long>{0l}, str_to_long_range("-0"));
+        ASSERT_EQ(std::optional<long>{1l}, str_to_long_range("+1"));
+        ASSERT_EQ(std::optional<long>{123231l}, str_to_long_range("123231"));
+        ASSERT_EQ(std::optional<long>{-123231l}, str_to_long_range("-123231"));
+        ASSERT_EQ(std::optional<long>{123231l}, str_to_long_range("123231b"));
+        ASSERT_EQ(std::optional<long>{123231l}, str_to_long_range("   123231   "));
+        ASSERT_EQ(std::optional<long>{std::numeric_limits<long>::max()}, str_to_long_range(std::to_string(std::numeric_limits<long>::max())));
+        ASSERT_EQ(std::optional<long>{std::numeric_limits<long>::min()}, str_to_long_range(std::to_string(std::numeric_limits<long>::min())));
+        ASSERT_EQ(std::nullopt, str_to_long_range(std::to_string(std::numeric_limits<long>::max()) + "0"));
+        ASSERT_EQ(std::nullopt, str_to_long_range("a123231"));
+        ASSERT_EQ(std::nullopt, str_to_long_range("-"));
+        ASSERT_EQ(std::nullopt, str_to_long_range(" "));
+        ASSERT_EQ(std::nullopt, str_to_long_range(""));
+
+        // the range is not null terminated
+        const auto str = std::string("12345");
+        ASSERT_EQ(std::optional<long>{123l}, str_to_long(str.data(), str.data() + 3));
+    }
+
     TEST_CASE("string_format_test.str_to_long_long", "[string_format_test]") {
         ASSERT_EQ(std::optional<long long>{0ll}, str_to_long_long("0"));
         ASSERT_EQ(std::optional<long long>{1ll}, str_to_long_long("1"));
@@ -177,6 +207,52 @@ namespace kdl {
         ASSERT_EQ(std::nullopt, str_to_double(""));
     }
 
+    static std::optional<double> str_to_double_range(const std::string& str) {
+        return str_to_double(str.data(), str.data() + str.size());
+    }
+
+    TEST_CASE("string_format_test.str_to_double_range", "[string_format_test]") {
+        ASSERT_EQ(std::optional<double>{0.0}, str_to_double_range("0"));
+        ASSERT_EQ(std::optional<double>{1.0}, str_to_double_range("1.0"));
+        ASSERT_EQ(std::optional<double>{1.0}, str_to_double_range("1."));
+        ASSERT_EQ(std::optional<double>{0.5}, str_to_double_range(".5"));
+        ASSERT_EQ(std::optional<double>{-64.0}, str_to_double_range("-64"));
+        ASSERT_EQ(std::optional<double>{1.0}, str_to_double_range("1e"));
+        ASSERT_EQ(std::optional<double>{1.0}, str_to_double_range("1.0abc"));
+        ASSERT_EQ(std::optional<double>{1.5}, str_to_double_range("  1.5"));
+        ASSERT_EQ(std::nullopt, str_to_double_range("a123231.0"));
+        ASSERT_EQ(std::nullopt, str_to_double_range("."));
+        ASSERT_EQ(std::nullopt, str_to_double_range("-"));
+        ASSERT_EQ(std::nullopt, str_to_double_range("1e999"));
+        ASSERT_EQ(std::nullopt, str_to_double_range(" "));
+        ASSERT_EQ(std::nullopt, str_to_double_range(""));
+
+        // the range is not null terminated
+        const auto str = std::string("12345");
+        ASSERT_EQ(std::optional<double>{123.0}, str_to_double(str.data(), str.data() + 3));
+
+        // the results must be identical to those of strtod
+        const auto values = std::vector<std::string>{
+            "-0", "0.1", "0.2", "0.3", "-0.70710678118654757", "0.707107", "1234.5678", "3.14159265358979",
+            "1e22", "1e23", "-1.5e-7", "2.5E+10", "9007199254740993", "9007199254740992", "123456789012345678901234567890",
+            "0.000000000000000000000000001", "1.7976931348623157e308", "4.9406564584124654e-324", "0x1p4", "inf", "nan"
+        };
+        for (const auto& value : values) {
+            const auto expected = std::strtod(value.c_str(), nullptr);
+            const auto actual = str_to_double_range(value);
+            if (std::isnan(expected)) {
+                ASSERT_TRUE(actual.has_value());
+                ASSERT_TRUE(std::isnan(*actual));
+            } else if (actual.has_value()) {
+                ASSERT_EQ(expected, *actual);
+                ASSERT_EQ(std::signbit(expected), std::signbit(*actual));
+            } else {
+                // out of range
+                ASSERT_EQ(std::nullopt, str_to_double(value));
+            }
+        }
+    }
+
     TEST_CASE("string_format_test.str_to_long_double", "[string_format_test]") {
         ASSERT_EQ(std::optional<long double>{0.0L}, str_to_long_double("0"));
         ASSERT_EQ(std::optional<long double>{1.0L}, str_to_long_double("1.0"));